@@ -7,6 +7,7 @@
 
 #include "Dictation/Experience/DictationExperience.h"
 #include "CoreMinimal.h"
+#include "Wit/Utilities/WitExperienceRegistry.h"
 
 /**
  * Sets default values for this actor's properties
@@ -28,9 +29,29 @@ void ADictationExperience::BeginPlay()
 		DictationService->SetEvents(DictationEvents);
 	}
 	
+	if (UWitExperienceRegistry* Registry = GetWorld()->GetSubsystem<UWitExperienceRegistry>())
+	{
+		Registry->RegisterExperience(this);
+	}
+
 	Super::BeginPlay();
 }
 
+/**
+ * Called when play ends. Unregisters from the experience registry
+ *
+ * @param EndPlayReason [in] why play ended
+ */
+void ADictationExperience::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWitExperienceRegistry* Registry = GetWorld()->GetSubsystem<UWitExperienceRegistry>())
+	{
+		Registry->UnregisterExperience(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 /**
  * Starts receiving dictation from the microphone and begins streaming it to for interpretation
  *
@@ -7,8 +7,10 @@
 
 #include "TTS/Cache/Memory/TtsMemoryCache.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Wit/Utilities/WitHelperUtilities.h"
 #include "Wit/Utilities/WitLog.h"
 #include "Sound/SoundWave.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 /**
  * Default constructor
@@ -29,25 +31,39 @@ UTtsMemoryCache::UTtsMemoryCache()
  */
 bool UTtsMemoryCache::AddClip(const FString& ClipId, USoundWave* SoundWave, const FTtsConfiguration& ClipSettings)
 {
-	int32 Index;
+	TRACE_CPUPROFILER_EVENT_SCOPE(UTtsMemoryCache::AddClip);
 
-	const bool bIsKnownClip = ClipIds.Find(ClipId, Index);
+	const FTtsClipKey ClipKey = GetClipKey(ClipId);
+	const int32* ExistingIndex = ClipIndices.Find(ClipKey);
+
+	const bool bIsKnownClip = ExistingIndex != nullptr;
 	if (bIsKnownClip)
 	{
-		RemoveClipAt(Index);
+		RemoveClipAt(*ExistingIndex);
 	}
 
 	UE_LOG(LogWit, Verbose, TEXT("UTTSMemoryCache::AddClip: adding clip with text (%s) and id (%s)"), *ClipSettings.Text, *ClipId);
-	
-	ClipIds.Emplace(ClipId);	
+
+	const int32 Index = ClipIds.Emplace(ClipId);
 	Clips.Emplace(SoundWave);
 	ClipSettingsArray.Emplace(ClipSettings);
-	
+	ClipKeys.Emplace(ClipKey);
+	ClipLinks.Emplace();
+
+	const int64 ClipSizeInBytes = GetClipSizeInBytes(SoundWave);
+
+	ClipSizesInBytes.Emplace(ClipSizeInBytes);
+	UsedCacheSizeInBytes += ClipSizeInBytes;
+
+	ClipIndices.Add(ClipKey, Index);
+	LinkClipAsNewest(Index);
+
 	while (IsFull())
 	{
-		UE_LOG(LogWit, Verbose, TEXT("UTTSMemoryCache::AddClip: cache is full - removing oldest clip"));
+		UE_LOG(LogWit, Verbose, TEXT("UTTSMemoryCache::AddClip: cache is full - removing least recently used clip"));
 		
-		RemoveClipAt(0);
+		RemoveClipAt(OldestClipIndex);
+		++Statistics.NumEvictions;
 	}
 
 	if (!bIsKnownClip)
@@ -67,9 +83,9 @@ bool UTtsMemoryCache::AddClip(const FString& ClipId, USoundWave* SoundWave, cons
  */	
 bool UTtsMemoryCache::RemoveClip(const FString& ClipId)
 {
-	int32 Index;
+	const int32 Index = FindClipIndex(ClipId);
 	
-	const bool bIsKnownClip = ClipIds.Find(ClipId, Index);
+	const bool bIsKnownClip = Index != INDEX_NONE;
 	if (!bIsKnownClip)
 	{
 		return false;	
@@ -93,6 +109,15 @@ void UTtsMemoryCache::RemoveAllClips()
 	ClipIds.Empty();
 	Clips.Empty();
 	ClipSettingsArray.Empty();
+	ClipKeys.Empty();
+	ClipIndices.Empty();
+	ClipLinks.Empty();
+	ClipSizesInBytes.Empty();
+
+	UsedCacheSizeInBytes = 0;
+
+	OldestClipIndex = INDEX_NONE;
+	NewestClipIndex = INDEX_NONE;
 }
 
 /**
@@ -106,7 +131,7 @@ int32 UTtsMemoryCache::GetUsedCacheClipCapacity() const
 }
 
 /**
- * Get a clip given its id
+ * Get a clip given its id. A successful lookup marks the clip as the most recently used
  *
  * @param ClipId [in] the clip id
  *
@@ -114,42 +139,201 @@ int32 UTtsMemoryCache::GetUsedCacheClipCapacity() const
  */	
 USoundWave* UTtsMemoryCache::GetClip(const FString& ClipId) const
 {
-	int32 Index;
+	TRACE_CPUPROFILER_EVENT_SCOPE(UTtsMemoryCache::GetClip);
 
 	UE_LOG(LogWit, Verbose, TEXT("UTTSMemoryCache::GetClip: requesting clip with id (%s)"), *ClipId);
 	
-	const bool bIsClipAdded = ClipIds.Find(ClipId, Index);
+	const int32 Index = FindClipIndex(ClipId);
+
+	const bool bIsClipAdded = Index != INDEX_NONE;
 	if (!bIsClipAdded)
 	{
 		UE_LOG(LogWit, Verbose, TEXT("UTTSMemoryCache::GetClip: clip does not exist in cache"));
+		++Statistics.NumMisses;
 		return nullptr;
 	}
 
+	++Statistics.NumHits;
+
+	TouchClip(Index);
+
 	return Clips[Index];
 }
 
+/**
+ * Is a clip in the cache? Unlike GetClip this does not count towards the hit and miss statistics or mark the clip as recently used
+ *
+ * @param ClipId [in] the clip id
+ *
+ * @return true if the clip is in the cache
+ */
+bool UTtsMemoryCache::ContainsClip(const FString& ClipId) const
+{
+	return FindClipIndex(ClipId) != INDEX_NONE;
+}
+
 /**
  * Get all the currently cached clips
  * 
- * @return all the clip sound waves
+ * @return all the clip sound waves ordered from least to most recently used
  */
 TArray<USoundWave*> UTtsMemoryCache::GetClips() const
 {
-	return Clips;
+	TArray<USoundWave*> OrderedClips;
+	OrderedClips.Reserve(Clips.Num());
+
+	for (int32 Index = OldestClipIndex; Index != INDEX_NONE; Index = ClipLinks[Index].Next)
+	{
+		OrderedClips.Add(Clips[Index]);
+	}
+
+	return OrderedClips;
 }
 
 /**
- * Removes a clip a the given array index
+ * Removes a clip a the given array index. The last clip is moved into the freed slot so the arrays stay packed without shifting
  */
 void UTtsMemoryCache::RemoveClipAt(const int32 Index)
 {
 	UE_LOG(LogWit, Verbose, TEXT("UTTSMemoryCache::RemoveClipAt: removing clip at index (%d) with text (%s) and id (%s)"), Index, *ClipSettingsArray[Index].Text, *ClipIds[Index]);
 
 	OnClipRemoved.Broadcast(*ClipIds[Index]);
-	
-	ClipIds.RemoveAt(Index);
-	Clips.RemoveAt(Index);
-	ClipSettingsArray.RemoveAt(Index);
+
+	UnlinkClip(Index);
+	ClipIndices.Remove(ClipKeys[Index]);
+
+	UsedCacheSizeInBytes -= ClipSizesInBytes[Index];
+
+	const int32 LastIndex = Clips.Num() - 1;
+
+	if (Index != LastIndex)
+	{
+		const FTtsMemoryCacheLink& MovedLink = ClipLinks[LastIndex];
+
+		if (MovedLink.Previous != INDEX_NONE)
+		{
+			ClipLinks[MovedLink.Previous].Next = Index;
+		}
+		else
+		{
+			OldestClipIndex = Index;
+		}
+
+		if (MovedLink.Next != INDEX_NONE)
+		{
+			ClipLinks[MovedLink.Next].Previous = Index;
+		}
+		else
+		{
+			NewestClipIndex = Index;
+		}
+
+		ClipIndices.FindChecked(ClipKeys[LastIndex]) = Index;
+	}
+
+	ClipIds.RemoveAtSwap(Index);
+	Clips.RemoveAtSwap(Index);
+	ClipSettingsArray.RemoveAtSwap(Index);
+	ClipKeys.RemoveAtSwap(Index);
+	ClipLinks.RemoveAtSwap(Index);
+	ClipSizesInBytes.RemoveAtSwap(Index);
+}
+
+/**
+ * Get the compact key used to index a clip. This is a 128 bit hash of the id so the index does not need to store or compare strings
+ *
+ * @param ClipId [in] the clip id
+ *
+ * @return the clip key
+ */
+FTtsClipKey UTtsMemoryCache::GetClipKey(const FString& ClipId)
+{
+	return FWitHelperUtilities::GetClipIdKey(ClipId);
+}
+
+/**
+ * Find the array index of a clip
+ *
+ * @param ClipId [in] the clip id
+ *
+ * @return the index of the clip or INDEX_NONE if the clip is not cached
+ */
+int32 UTtsMemoryCache::FindClipIndex(const FString& ClipId) const
+{
+	const int32* Index = ClipIndices.Find(GetClipKey(ClipId));
+
+	return Index != nullptr ? *Index : INDEX_NONE;
+}
+
+/**
+ * Add a clip to the most recently used end of the recency list
+ *
+ * @param Index [in] the index of the clip
+ */
+void UTtsMemoryCache::LinkClipAsNewest(const int32 Index) const
+{
+	FTtsMemoryCacheLink& Link = ClipLinks[Index];
+
+	Link.Previous = NewestClipIndex;
+	Link.Next = INDEX_NONE;
+
+	if (NewestClipIndex != INDEX_NONE)
+	{
+		ClipLinks[NewestClipIndex].Next = Index;
+	}
+	else
+	{
+		OldestClipIndex = Index;
+	}
+
+	NewestClipIndex = Index;
+}
+
+/**
+ * Remove a clip from the recency list
+ *
+ * @param Index [in] the index of the clip
+ */
+void UTtsMemoryCache::UnlinkClip(const int32 Index) const
+{
+	FTtsMemoryCacheLink& Link = ClipLinks[Index];
+
+	if (Link.Previous != INDEX_NONE)
+	{
+		ClipLinks[Link.Previous].Next = Link.Next;
+	}
+	else
+	{
+		OldestClipIndex = Link.Next;
+	}
+
+	if (Link.Next != INDEX_NONE)
+	{
+		ClipLinks[Link.Next].Previous = Link.Previous;
+	}
+	else
+	{
+		NewestClipIndex = Link.Previous;
+	}
+
+	Link.Previous = INDEX_NONE;
+	Link.Next = INDEX_NONE;
+}
+
+/**
+ * Mark a clip as the most recently used
+ *
+ * @param Index [in] the index of the clip
+ */
+void UTtsMemoryCache::TouchClip(const int32 Index) const
+{
+	if (Index == NewestClipIndex)
+	{
+		return;
+	}
+
+	UnlinkClip(Index);
+	LinkClipAsNewest(Index);
 }
 
 /**
@@ -171,7 +355,7 @@ bool UTtsMemoryCache::IsFull() const
 		return true;
 	}
 
-	const bool bIsOverMemoryCapacity = bIsMemoryCapacityEnabled && GetUsedCacheSizeInKilobytes() > MemoryCapacityInKilobytes;
+	const bool bIsOverMemoryCapacity = bIsMemoryCapacityEnabled && UsedCacheSizeInBytes > static_cast<int64>(MemoryCapacityInKilobytes) * 1024;
 	if (bIsOverMemoryCapacity)
 	{
 		return true;
@@ -181,29 +365,55 @@ bool UTtsMemoryCache::IsFull() const
 }
 
 /**
- * Gets the amount of memory currently being used by the cache
+ * Gets the amount of memory currently being used by the cache. Rounded up to the nearest kilobyte
  */
 int32 UTtsMemoryCache::GetUsedCacheSizeInKilobytes() const
 {
-	int32 TotalSizeInBytes = 0;
-	
-	for (auto& Clip : Clips)
-	{
-#if UE_VERSION_OLDER_THAN(5,0,0)
-        TotalSizeInBytes += Clip->ResourceSize;
-#else
-		TotalSizeInBytes += Clip->GetResourceSize();		
-#endif
-	}
+	return static_cast<int32>(FMath::DivideAndRoundUp<int64>(UsedCacheSizeInBytes, 1024));
+}
 
-	int32 TotalSizeInKilobytes = TotalSizeInBytes / 1024;
-	const int32 RemainingBytes = TotalSizeInBytes % 1024;
-	
-	const bool bShouldRoundUp = RemainingBytes != 0;
-	if (bShouldRoundUp)
+/**
+ * Gets the exact amount of memory in bytes currently being used by the cache. This is a running total kept up to date as clips
+ * are added and removed
+ */
+int64 UTtsMemoryCache::GetUsedCacheSizeInBytes() const
+{
+	return UsedCacheSizeInBytes;
+}
+
+/**
+ * Gets the hit, miss and eviction counts of the cache
+ */
+FTtsMemoryCacheStatistics UTtsMemoryCache::GetStatistics() const
+{
+	return Statistics;
+}
+
+/**
+ * Resets the hit, miss and eviction counts of the cache
+ */
+void UTtsMemoryCache::ResetStatistics()
+{
+	Statistics = FTtsMemoryCacheStatistics();
+}
+
+/**
+ * Gets the memory used by a single clip
+ *
+ * @param SoundWave [in] the clip sound wave
+ *
+ * @return the size of the clip in bytes
+ */
+int64 UTtsMemoryCache::GetClipSizeInBytes(USoundWave* SoundWave)
+{
+	if (SoundWave == nullptr)
 	{
-		++TotalSizeInKilobytes;
+		return 0;
 	}
 
-	return TotalSizeInKilobytes;
+#if UE_VERSION_OLDER_THAN(5,0,0)
+	return SoundWave->ResourceSize;
+#else
+	return SoundWave->GetResourceSize();
+#endif
 }
@@ -7,11 +7,16 @@
 
 #include "TTS/Cache/Storage/TtsStorageCache.h"
 #include "TTS/Cache/Storage/Asset/TtsStorageCacheAsset.h"
+#include "TTS/Cache/Storage/TtsStorageCacheManifest.h"
+#include "TTS/Cache/Storage/TtsStorageCachePack.h"
+#include "TTS/Cache/Storage/TtsStorageCacheWorker.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Wit/Utilities/WitHelperUtilities.h"
 #include "Wit/Utilities/WitLog.h"
+#include "Misc/Crc.h"
 #include "Misc/Paths.h"
+#include "Serialization/BufferArchive.h"
 
 /**
  * Default constructor
@@ -19,6 +24,35 @@
 UTtsStorageCache::UTtsStorageCache()
 {
 	PrimaryComponentTick.bCanEverTick = false;
+
+	Worker = MakeShared<FTtsStorageCacheWorker, ESPMode::ThreadSafe>();
+}
+
+/**
+ * Called when the component is started. Loading the manifests on the background worker also evicts anything over budget
+ */
+void UTtsStorageCache::BeginPlay()
+{
+	Super::BeginPlay();
+
+	QueueManifestUpdate(ETtsStorageCacheLocation::Persistent, [](FTtsStorageCacheManifest&) {});
+	QueueManifestUpdate(ETtsStorageCacheLocation::Temporary, [](FTtsStorageCacheManifest&) {});
+}
+
+/**
+ * Called when the component is stopped. Saves any outstanding changes to the cache manifests
+ */
+void UTtsStorageCache::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const TPair<FString, TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe>>& Manifest : Manifests)
+	{
+		Worker->QueueTask([Manifest = Manifest.Value]()
+		{
+			Manifest->Flush();
+		});
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -30,6 +64,31 @@ UTtsStorageCache::UTtsStorageCache()
  * @return false if the path does not exist or cannot be created
  */
 bool UTtsStorageCache::GetCachePath(const ETtsStorageCacheLocation CacheLocation, FString& CachePath) const
+{
+	if (!GetCacheDirectory(CacheLocation, CachePath))
+	{
+		return false;
+	}
+
+	// The worker remembers which directories exist so we only touch the file system the first time
+
+	if (!Worker->EnsureDirectory(FPaths::GetPath(CachePath)))
+	{
+		return false;
+	}
+	
+	return true;
+}
+
+/**
+ * Get the path of the cache directory without touching the file system
+ *
+ * @param CacheLocation [in] the cache location where the clip will be 
+ * @param CachePath [out] the full path to the cache directory including a trailing slash
+ *
+ * @return false if the cache location is disabled
+ */
+bool UTtsStorageCache::GetCacheDirectory(const ETtsStorageCacheLocation CacheLocation, FString& CachePath) const
 {
 	const ETtsStorageCacheLocation FinalCacheLocation = GetFinalCacheLocation(CacheLocation);
 	
@@ -51,21 +110,6 @@ bool UTtsStorageCache::GetCachePath(const ETtsStorageCacheLocation CacheLocation
 	
 	CachePath.Append(CacheDirectory);
 
-	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
-
-	if (!FileManager.DirectoryExists(*CachePath))
-	{
-		UE_LOG(LogWit, Verbose, TEXT("UTTSStorageCache::GetCachePath: Cache directy does not exist so creating"));
-		
-		const bool bDidCreateDirectory = FileManager.CreateDirectoryTree(*CachePath);
-		if (!bDidCreateDirectory)
-		{
-			UE_LOG(LogWit, Verbose, TEXT("UTTSStorageCache::GetCachePath: Failed to create cache directory (%s)"), *CachePath);
-			
-			return false;
-		}
-	}
-
 	if (!CachePath.EndsWith("/"))
 	{
 		CachePath.Append("/");
@@ -120,9 +164,31 @@ bool UTtsStorageCache::AddClip(const FString& ClipId, const TArray<uint8>& ClipD
 #endif
 	}
 
-	CacheFilePath.Append(ClipId);
-	
-	return FWitHelperUtilities::SaveClipToBinaryFile(CacheFilePath, ClipData);
+	bool bDidAddSuccessfully;
+
+	const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> Pack = GetPack(ClipSettings.StorageCacheLocation);
+	if (Pack.IsValid())
+	{
+		bDidAddSuccessfully = Pack->AddClip(FTtsStorageCachePack::GetClipHash(ClipId), GetSettingsHash(ClipSettings), ClipData);
+
+		QueueCompactionIfNeeded(Pack);
+	}
+	else
+	{
+		CacheFilePath.Append(ClipId);
+
+		bDidAddSuccessfully = FWitHelperUtilities::SaveClipToBinaryFile(CacheFilePath, ClipData);
+	}
+
+	if (bDidAddSuccessfully)
+	{
+		QueueManifestUpdate(ClipSettings.StorageCacheLocation, [ClipId, SizeInBytes = ClipData.Num()](FTtsStorageCacheManifest& Manifest)
+		{
+			Manifest.AddClip(ClipId, SizeInBytes);
+		});
+	}
+
+	return bDidAddSuccessfully;
 }
 
 /**
@@ -154,10 +220,165 @@ bool UTtsStorageCache::RequestClip(const FString& ClipId, const ETtsStorageCache
 	}
 	
 	CacheFilePath.Append(ClipId);
-		
-	return FWitHelperUtilities::LoadClipFromBinaryFile(CacheFilePath, ClipData);
+
+	// A clip that is still waiting to be written by the worker is not on disk yet
+
+	if (Worker->FindPendingWrite(CacheFilePath, ClipData))
+	{
+		return true;
+	}
+
+	bool bIsClipCached;
+
+	const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> Pack = GetPack(CacheLocation);
+	if (Pack.IsValid())
+	{
+		bIsClipCached = Pack->RequestClip(FTtsStorageCachePack::GetClipHash(ClipId), ClipData);
+	}
+	else
+	{
+		bIsClipCached = FWitHelperUtilities::LoadClipFromBinaryFile(CacheFilePath, ClipData);
+	}
+
+	QueueManifestUpdate(CacheLocation, [ClipId, bIsClipCached, SizeInBytes = ClipData.Num()](FTtsStorageCacheManifest& Manifest)
+	{
+		Manifest.AccessClip(ClipId, bIsClipCached, SizeInBytes);
+	});
+
+	return bIsClipCached;
 };
 
+/**
+ * Add a clip to the cache without blocking the calling thread. Binary clips are written by the background worker while assets in the
+ * content folder are saved immediately since that can only be done on the game thread
+ *
+ * @param ClipId [in] the clip id
+ * @param ClipData [in] the binary data that represents the clip
+ * @param ClipSettings [in] the settings that were originally used to create the clip
+ * @param OnComplete [in] called on the game thread once the clip has been written
+ */
+void UTtsStorageCache::AddClipAsync(const FString& ClipId, const TArray<uint8>& ClipData, const FTtsConfiguration& ClipSettings, const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete)
+{
+	FString CacheFilePath;
+
+	const bool bShouldCache = GetCacheDirectory(ClipSettings.StorageCacheLocation, CacheFilePath);
+	if (!bShouldCache)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("UTTSStorageCache::AddClipAsync: caching is disabled"));
+		OnComplete.ExecuteIfBound(false);
+		return;
+	}
+
+	const bool bShouldSaveAsAsset = GetFinalCacheLocation(ClipSettings.StorageCacheLocation) == ETtsStorageCacheLocation::Content;
+	if (bShouldSaveAsAsset)
+	{
+		OnComplete.ExecuteIfBound(AddClip(ClipId, ClipData, ClipSettings));
+		return;
+	}
+
+	CacheFilePath.Append(ClipId);
+
+	UE_LOG(LogWit, Verbose, TEXT("UTTSStorageCache::AddClipAsync: queueing clip (%s) with path (%s) and data size (%d)"), *ClipId, *CacheFilePath, ClipData.Num());
+
+	// Pack writes are still coalesced by the path the clip would have had as an individual file
+
+	const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> Pack = GetPack(ClipSettings.StorageCacheLocation);
+	if (Pack.IsValid())
+	{
+		Worker->QueueWrite(CacheFilePath, ClipData, [Pack, ClipHash = FTtsStorageCachePack::GetClipHash(ClipId), SettingsHash = GetSettingsHash(ClipSettings)](const TArray<uint8>& Data)
+		{
+			const bool bDidAddSuccessfully = Pack->AddClip(ClipHash, SettingsHash, Data);
+
+			if (Pack->ShouldCompact())
+			{
+				Pack->Compact();
+			}
+
+			return bDidAddSuccessfully;
+		}, OnComplete);
+	}
+	else
+	{
+		Worker->QueueWrite(CacheFilePath, ClipData, OnComplete);
+	}
+
+	// This runs after the write so eviction always sees the clip on disk
+
+	QueueManifestUpdate(ClipSettings.StorageCacheLocation, [ClipId, SizeInBytes = ClipData.Num()](FTtsStorageCacheManifest& Manifest)
+	{
+		Manifest.AddClip(ClipId, SizeInBytes);
+	});
+}
+
+/**
+ * Request a clip from the cache without blocking the calling thread. Binary clips are read by the background worker while assets in
+ * the content folder are loaded immediately since that can only be done on the game thread
+ *
+ * @param ClipId [in] the clip id
+ * @param CacheLocation [in] the cache location where the clip will be
+ * @param OnComplete [in] called on the game thread with the clip data once the request is complete
+ */
+void UTtsStorageCache::RequestClipAsync(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete) const
+{
+	FString CacheFilePath;
+
+	const bool bShouldCache = GetCacheDirectory(CacheLocation, CacheFilePath);
+	if (!bShouldCache)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("UTTSStorageCache::RequestClipAsync: caching is disabled"));
+		OnComplete.ExecuteIfBound(false, TArray<uint8>());
+		return;
+	}
+
+	const bool bShouldLoadFromAsset = GetFinalCacheLocation(CacheLocation) == ETtsStorageCacheLocation::Content;
+	if (bShouldLoadFromAsset)
+	{
+		TArray<uint8> ClipData;
+		const bool bIsSuccessful = FWitHelperUtilities::LoadClipFromAssetFile(CacheDirectory, ClipId, ClipData);
+		OnComplete.ExecuteIfBound(bIsSuccessful, ClipData);
+		return;
+	}
+
+	CacheFilePath.Append(ClipId);
+
+	UE_LOG(LogWit, Verbose, TEXT("UTTSStorageCache::RequestClipAsync: requesting clip (%s) with path (%s)"), *ClipId, *CacheFilePath);
+
+	TUniqueFunction<bool(TArray<uint8>&)> ReadFunction;
+
+	const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> Pack = GetPack(CacheLocation);
+	if (Pack.IsValid())
+	{
+		ReadFunction = [Pack, ClipHash = FTtsStorageCachePack::GetClipHash(ClipId)](TArray<uint8>& ClipData)
+		{
+			return Pack->RequestClip(ClipHash, ClipData);
+		};
+	}
+	else
+	{
+		ReadFunction = [CacheFilePath](TArray<uint8>& ClipData)
+		{
+			return FWitHelperUtilities::LoadClipFromBinaryFile(CacheFilePath, ClipData);
+		};
+	}
+
+	// The manifest is only used on the worker so we can record the access as part of the read. Without a budget there is nothing to track
+
+	const TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe> Manifest = IsCapacityEnabled() ? GetManifest(CacheLocation) : nullptr;
+
+	Worker->QueueRead([ReadFunction = MoveTemp(ReadFunction), Manifest, ClipId](TArray<uint8>& ClipData)
+	{
+		const bool bIsClipCached = ReadFunction(ClipData);
+
+		if (Manifest.IsValid())
+		{
+			Manifest->AccessClip(ClipId, bIsClipCached, ClipData.Num());
+			Manifest->SaveIfChanged();
+		}
+
+		return bIsClipCached;
+	}, OnComplete);
+}
+
 /*
  * Get the final location to cache a clip taking into account overrides
  */
@@ -171,6 +392,166 @@ ETtsStorageCacheLocation UTtsStorageCache::GetFinalCacheLocation(const ETtsStora
 	return CacheLocation;
 }
 
+/*
+ * Get the pack to use for a cache location or null if the location stores clips as individual files. Packs are created the first time
+ * they are needed and shared with the background worker
+ */
+TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> UTtsStorageCache::GetPack(const ETtsStorageCacheLocation CacheLocation) const
+{
+	const ETtsStorageCacheLocation FinalCacheLocation = GetFinalCacheLocation(CacheLocation);
+
+	const bool bShouldUsePack = (FinalCacheLocation == ETtsStorageCacheLocation::Persistent && PersistentCacheFormat == ETtsStorageCacheFormat::Pack) ||
+		(FinalCacheLocation == ETtsStorageCacheLocation::Temporary && TemporaryCacheFormat == ETtsStorageCacheFormat::Pack);
+
+	FString CachePath;
+
+	if (!bShouldUsePack || !GetCacheDirectory(CacheLocation, CachePath))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe>& Pack = Packs.FindOrAdd(CachePath);
+
+	if (!Pack.IsValid())
+	{
+		Pack = MakeShared<FTtsStorageCachePack, ESPMode::ThreadSafe>(CachePath);
+	}
+
+	return Pack;
+}
+
+/*
+ * Is either capacity limit in use? The manifests are only kept when there is a budget to enforce so projects without limits never
+ * scan the cache directories or save manifests
+ */
+bool UTtsStorageCache::IsCapacityEnabled() const
+{
+	return bIsClipCapacityEnabled || bIsStorageCapacityEnabled;
+}
+
+/*
+ * Get the manifest that tracks the clips in a cache location or null if the location is not tracked. Clips in the content folder are
+ * packaged with the app so they are never tracked or evicted
+ */
+TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe> UTtsStorageCache::GetManifest(const ETtsStorageCacheLocation CacheLocation) const
+{
+	FString CachePath;
+
+	const bool bIsTracked = GetFinalCacheLocation(CacheLocation) != ETtsStorageCacheLocation::Content && GetCacheDirectory(CacheLocation, CachePath);
+	if (!bIsTracked)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe>& Manifest = Manifests.FindOrAdd(CachePath);
+
+	if (!Manifest.IsValid())
+	{
+		FTtsStorageCacheManifest::FScanFunction ScanFunction;
+
+		const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> Pack = GetPack(CacheLocation);
+		if (Pack.IsValid())
+		{
+			ScanFunction = [Pack](TMap<FString, int64>& ClipSizes)
+			{
+				Pack->GetClipSizes(ClipSizes);
+			};
+		}
+
+		Manifest = MakeShared<FTtsStorageCacheManifest, ESPMode::ThreadSafe>(CachePath, MoveTemp(ScanFunction));
+	}
+
+	return Manifest;
+}
+
+/*
+ * Queue an update of a cache location's manifest on the background worker followed by any eviction needed to stay within budget. The
+ * budget is captured now so the worker never touches this object
+ */
+void UTtsStorageCache::QueueManifestUpdate(const ETtsStorageCacheLocation CacheLocation, TUniqueFunction<void(FTtsStorageCacheManifest&)>&& Update) const
+{
+	if (!IsCapacityEnabled())
+	{
+		return;
+	}
+
+	const TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe> Manifest = GetManifest(CacheLocation);
+
+	if (!Manifest.IsValid())
+	{
+		return;
+	}
+
+	FString CachePath;
+	GetCacheDirectory(CacheLocation, CachePath);
+
+	const int64 MaximumSizeInBytes = bIsStorageCapacityEnabled ? static_cast<int64>(StorageCapacityInMegabytes) * 1024 * 1024 : MAX_int64;
+	const int32 MaximumNumClips = bIsClipCapacityEnabled ? ClipCapacity : MAX_int32;
+
+	Worker->QueueTask([Manifest, Pack = GetPack(CacheLocation), CachePath, MaximumSizeInBytes, MaximumNumClips, Update = MoveTemp(Update)]()
+	{
+		Update(*Manifest);
+
+		const TArray<FString> EvictedClipIds = Manifest->EvictClips(MaximumSizeInBytes, MaximumNumClips);
+
+		IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+		for (const FString& ClipId : EvictedClipIds)
+		{
+			if (Pack.IsValid())
+			{
+				Pack->RemoveClip(FTtsStorageCachePack::GetClipHash(ClipId));
+			}
+			else
+			{
+				FileManager.DeleteFile(*(CachePath + ClipId));
+			}
+		}
+
+		if (Pack.IsValid() && Pack->ShouldCompact())
+		{
+			Pack->Compact();
+		}
+
+		Manifest->SaveIfChanged();
+	});
+}
+
+/*
+ * Queue compaction of a pack on the background worker if enough of it is unused
+ */
+void UTtsStorageCache::QueueCompactionIfNeeded(const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe>& Pack) const
+{
+	if (!Pack->ShouldCompact())
+	{
+		return;
+	}
+
+	Worker->QueueTask([Pack]()
+	{
+		if (Pack->ShouldCompact())
+		{
+			Pack->Compact();
+		}
+	});
+}
+
+/*
+ * Get the hash of the settings used to create a clip ignoring the text and storage location
+ */
+uint32 UTtsStorageCache::GetSettingsHash(const FTtsConfiguration& ClipSettings)
+{
+	FBufferArchive Buffer;
+
+	FTtsConfiguration HashSettings(ClipSettings);
+	HashSettings.Text.Empty();
+	HashSettings.StorageCacheLocation = ETtsStorageCacheLocation::Default;
+
+	FTtsConfiguration::StaticStruct()->SerializeBin(Buffer, &HashSettings);
+
+	return FCrc::MemCrc32(Buffer.GetData(), Buffer.Num());
+}
+
 /**
  * Remove a clip from the cache
  *
@@ -199,6 +580,23 @@ bool UTtsStorageCache::RemoveClip(const FString& ClipId, const ETtsStorageCacheL
 	
 	CacheFilePath.Append(ClipId);
 
+	Worker->CancelPendingWrites(CacheFilePath);
+
+	QueueManifestUpdate(CacheLocation, [ClipId](FTtsStorageCacheManifest& Manifest)
+	{
+		Manifest.RemoveClip(ClipId);
+	});
+
+	const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> Pack = GetPack(CacheLocation);
+	if (Pack.IsValid())
+	{
+		const bool bDidRemoveSuccessfully = Pack->RemoveClip(FTtsStorageCachePack::GetClipHash(ClipId));
+
+		QueueCompactionIfNeeded(Pack);
+
+		return bDidRemoveSuccessfully;
+	}
+
 	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
 				
 	if (!FileManager.FileExists(*CacheFilePath))
@@ -242,6 +640,26 @@ void UTtsStorageCache::RemoveAllClips(const ETtsStorageCacheLocation CacheLocati
 		return;
 	}
 	
+	Worker->CancelPendingWrites(CacheFilePath);
+	Worker->ForgetDirectory(FPaths::GetPath(CacheFilePath));
+
+	// The pack must let go of its files before the directory can be deleted
+
+	const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe>* Pack = Packs.Find(CacheFilePath);
+	if (Pack != nullptr)
+	{
+		(*Pack)->RemoveAllClips();
+	}
+
+	const TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe>* Manifest = Manifests.Find(CacheFilePath);
+	if (Manifest != nullptr)
+	{
+		Worker->QueueTask([Manifest = *Manifest]()
+		{
+			Manifest->RemoveAllClips();
+		});
+	}
+
 	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
 				
 	if (!FileManager.DirectoryExists(*CacheFilePath))
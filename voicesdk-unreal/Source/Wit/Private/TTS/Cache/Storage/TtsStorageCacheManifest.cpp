@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "TTS/Cache/Storage/TtsStorageCacheManifest.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * Constructor
+ *
+ * @param InDirectory [in] the cache directory
+ * @param InScanFunction [in] lists the clips in the cache. If not set every file without an extension in the directory is a clip
+ */
+FTtsStorageCacheManifest::FTtsStorageCacheManifest(const FString& InDirectory, FScanFunction&& InScanFunction)
+	: Directory(InDirectory)
+	, ScanFunction(MoveTemp(InScanFunction))
+{
+}
+
+/**
+ * Record that a clip has been added to the cache
+ *
+ * @param ClipId [in] the clip id
+ * @param SizeInBytes [in] the size of the clip
+ */
+void FTtsStorageCacheManifest::AddClip(const FString& ClipId, const int64 SizeInBytes)
+{
+	LoadIfNeeded();
+
+	FEntry& Entry = Entries.FindOrAdd(ClipId);
+
+	UsedSizeInBytes += SizeInBytes - Entry.SizeInBytes;
+
+	Entry.SizeInBytes = SizeInBytes;
+	Entry.LastAccessTime = FDateTime::UtcNow().GetTicks();
+
+	bHasClipsChanged = true;
+}
+
+/**
+ * Record that a clip was requested from the cache. A clip we did not know about is added and a clip we thought we had but was not
+ * found is removed so the manifest corrects itself over time
+ *
+ * @param ClipId [in] the clip id
+ * @param bWasFound [in] was the clip in the cache?
+ * @param SizeInBytes [in] the size of the clip if it was found
+ */
+void FTtsStorageCacheManifest::AccessClip(const FString& ClipId, const bool bWasFound, const int64 SizeInBytes)
+{
+	LoadIfNeeded();
+
+	FEntry* Entry = Entries.Find(ClipId);
+
+	if (!bWasFound)
+	{
+		if (Entry != nullptr)
+		{
+			RemoveClip(ClipId);
+		}
+
+		return;
+	}
+
+	if (Entry == nullptr)
+	{
+		AddClip(ClipId, SizeInBytes);
+		return;
+	}
+
+	Entry->LastAccessTime = FDateTime::UtcNow().GetTicks();
+
+	bHasAccessTimesChanged = true;
+}
+
+/**
+ * Record that a clip has been removed from the cache
+ *
+ * @param ClipId [in] the clip id
+ */
+void FTtsStorageCacheManifest::RemoveClip(const FString& ClipId)
+{
+	LoadIfNeeded();
+
+	FEntry Entry;
+
+	if (Entries.RemoveAndCopyValue(ClipId, Entry))
+	{
+		UsedSizeInBytes -= Entry.SizeInBytes;
+		bHasClipsChanged = true;
+	}
+}
+
+/**
+ * Forget every clip and delete the manifest file
+ */
+void FTtsStorageCacheManifest::RemoveAllClips()
+{
+	Entries.Empty();
+	UsedSizeInBytes = 0;
+
+	bIsLoaded = true;
+	bHasClipsChanged = false;
+	bHasAccessTimesChanged = false;
+
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*GetManifestPath());
+}
+
+/**
+ * Remove the least recently used clips from the manifest until it is within budget
+ *
+ * @param MaximumSizeInBytes [in] the maximum total size of the clips
+ * @param MaximumNumClips [in] the maximum number of clips
+ *
+ * @return the ids of the clips that should be deleted from the cache
+ */
+TArray<FString> FTtsStorageCacheManifest::EvictClips(const int64 MaximumSizeInBytes, const int32 MaximumNumClips)
+{
+	LoadIfNeeded();
+
+	TArray<FString> EvictedClipIds;
+
+	const bool bIsWithinBudget = UsedSizeInBytes <= MaximumSizeInBytes && Entries.Num() <= MaximumNumClips;
+	if (bIsWithinBudget)
+	{
+		return EvictedClipIds;
+	}
+
+	TArray<TPair<int64, FString>> ClipsByAccessTime;
+	ClipsByAccessTime.Reserve(Entries.Num());
+
+	for (const TPair<FString, FEntry>& Entry : Entries)
+	{
+		ClipsByAccessTime.Emplace(Entry.Value.LastAccessTime, Entry.Key);
+	}
+
+	ClipsByAccessTime.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (const TPair<int64, FString>& Clip : ClipsByAccessTime)
+	{
+		if (UsedSizeInBytes <= MaximumSizeInBytes && Entries.Num() <= MaximumNumClips)
+		{
+			break;
+		}
+
+		RemoveClip(Clip.Value);
+		EvictedClipIds.Add(Clip.Value);
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheManifest::EvictClips: evicted (%d) clips leaving (%d) clips using (%lld) bytes"), EvictedClipIds.Num(),
+		Entries.Num(), UsedSizeInBytes);
+
+	return EvictedClipIds;
+}
+
+/**
+ * Save the manifest if it has changed since it was last saved. Changes to access times alone are throttled since every request
+ * changes them
+ */
+void FTtsStorageCacheManifest::SaveIfChanged()
+{
+	const bool bShouldSaveAccessTimes = bHasAccessTimesChanged && FPlatformTime::Seconds() - LastSaveTime >= MinimumSecondsBetweenAccessSaves;
+
+	if (bHasClipsChanged || bShouldSaveAccessTimes)
+	{
+		Save();
+	}
+}
+
+/**
+ * Save the manifest if anything has changed since it was last saved ignoring the throttling of access time changes
+ */
+void FTtsStorageCacheManifest::Flush()
+{
+	if (bHasClipsChanged || bHasAccessTimesChanged)
+	{
+		Save();
+	}
+}
+
+/**
+ * Load the manifest if it has not been loaded yet. If there is no manifest or it cannot be read we rebuild it from the contents of
+ * the cache
+ */
+void FTtsStorageCacheManifest::LoadIfNeeded()
+{
+	if (bIsLoaded)
+	{
+		return;
+	}
+
+	bIsLoaded = true;
+
+	if (!Load())
+	{
+		Rebuild();
+	}
+}
+
+/**
+ * Load the manifest from disk
+ *
+ * @return true if the manifest was loaded
+ */
+bool FTtsStorageCacheManifest::Load()
+{
+	Entries.Empty();
+	UsedSizeInBytes = 0;
+
+	TArray<uint8> ManifestData;
+
+	if (!FFileHelper::LoadFileToArray(ManifestData, *GetManifestPath(), FILEREAD_Silent))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheManifest::Load: manifest does not exist (%s)"), *GetManifestPath());
+		return false;
+	}
+
+	FMemoryReader Reader(ManifestData);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumEntries = 0;
+
+	Reader << Magic << Version << NumEntries;
+
+	const bool bIsValidHeader = !Reader.IsError() && Magic == ManifestMagic && Version == ManifestVersion && NumEntries >= 0;
+	if (!bIsValidHeader)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCacheManifest::Load: manifest is not valid (%s)"), *GetManifestPath());
+		return false;
+	}
+
+	Entries.Reserve(NumEntries);
+
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries && !Reader.IsError(); ++EntryIndex)
+	{
+		FString ClipId;
+		FEntry Entry;
+
+		Reader << ClipId << Entry.SizeInBytes << Entry.LastAccessTime;
+
+		UsedSizeInBytes += Entry.SizeInBytes;
+		Entries.Add(MoveTemp(ClipId), Entry);
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCacheManifest::Load: manifest is truncated (%s)"), *GetManifestPath());
+
+		Entries.Empty();
+		UsedSizeInBytes = 0;
+
+		return false;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheManifest::Load: loaded manifest with (%d) clips using (%lld) bytes"), Entries.Num(), UsedSizeInBytes);
+
+	return true;
+}
+
+/**
+ * Rebuild the manifest from the contents of the cache. This is the only time we need to scan the cache
+ */
+void FTtsStorageCacheManifest::Rebuild()
+{
+	Entries.Empty();
+	UsedSizeInBytes = 0;
+
+	TMap<FString, int64> ClipSizes;
+
+	if (ScanFunction)
+	{
+		ScanFunction(ClipSizes);
+	}
+	else
+	{
+		IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+		FileManager.IterateDirectoryStat(*Directory, [&ClipSizes](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			const FString ClipId = FPaths::GetCleanFilename(FilenameOrDirectory);
+
+			if (!StatData.bIsDirectory && !ClipId.Contains(TEXT(".")))
+			{
+				ClipSizes.Add(ClipId, StatData.FileSize);
+			}
+
+			return true;
+		});
+	}
+
+	// We have no idea when existing clips were last used so they all count as older than anything used from now on
+
+	for (const TPair<FString, int64>& Clip : ClipSizes)
+	{
+		Entries.Add(Clip.Key, FEntry{Clip.Value, 0});
+		UsedSizeInBytes += Clip.Value;
+	}
+
+	bHasClipsChanged = Entries.Num() > 0;
+
+	UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheManifest::Rebuild: rebuilt manifest with (%d) clips using (%lld) bytes"), Entries.Num(), UsedSizeInBytes);
+}
+
+/**
+ * Save the manifest to disk
+ */
+void FTtsStorageCacheManifest::Save()
+{
+	TArray<uint8> ManifestData;
+
+	FMemoryWriter Writer(ManifestData);
+
+	uint32 Magic = ManifestMagic;
+	uint32 Version = ManifestVersion;
+	int32 NumEntries = Entries.Num();
+
+	Writer << Magic << Version << NumEntries;
+
+	for (TPair<FString, FEntry>& Entry : Entries)
+	{
+		Writer << Entry.Key << Entry.Value.SizeInBytes << Entry.Value.LastAccessTime;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(ManifestData, *GetManifestPath()))
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCacheManifest::Save: failed to write manifest (%s)"), *GetManifestPath());
+		return;
+	}
+
+	bHasClipsChanged = false;
+	bHasAccessTimesChanged = false;
+
+	LastSaveTime = FPlatformTime::Seconds();
+}
+
+/**
+ * Get the full path of the manifest file
+ *
+ * @return the path
+ */
+FString FTtsStorageCacheManifest::GetManifestPath() const
+{
+	return Directory / TEXT("Clips.manifest");
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Tracks the size and last access time of every clip in a cache directory so the cache can be kept within a budget by evicting the
+ * least recently used clips. The manifest is persisted alongside the clips so it only needs to be rebuilt from the directory contents
+ * when it is missing. It is not thread safe and must only be used from the storage cache worker
+ */
+class FTtsStorageCacheManifest final
+{
+public:
+
+	/** Fills in the id and size of every clip in the cache. Used to rebuild a missing manifest */
+	using FScanFunction = TFunction<void(TMap<FString, int64>&)>;
+
+	/**
+	 * Constructor
+	 *
+	 * @param InDirectory [in] the cache directory
+	 * @param InScanFunction [in] lists the clips in the cache. If not set every file without an extension in the directory is a clip
+	 */
+	FTtsStorageCacheManifest(const FString& InDirectory, FScanFunction&& InScanFunction);
+
+	/**
+	 * Record that a clip has been added to the cache
+	 *
+	 * @param ClipId [in] the clip id
+	 * @param SizeInBytes [in] the size of the clip
+	 */
+	void AddClip(const FString& ClipId, const int64 SizeInBytes);
+
+	/**
+	 * Record that a clip was requested from the cache
+	 *
+	 * @param ClipId [in] the clip id
+	 * @param bWasFound [in] was the clip in the cache?
+	 * @param SizeInBytes [in] the size of the clip if it was found
+	 */
+	void AccessClip(const FString& ClipId, const bool bWasFound, const int64 SizeInBytes);
+
+	/**
+	 * Record that a clip has been removed from the cache
+	 *
+	 * @param ClipId [in] the clip id
+	 */
+	void RemoveClip(const FString& ClipId);
+
+	/**
+	 * Forget every clip and delete the manifest file
+	 */
+	void RemoveAllClips();
+
+	/**
+	 * Remove the least recently used clips from the manifest until it is within budget
+	 *
+	 * @param MaximumSizeInBytes [in] the maximum total size of the clips
+	 * @param MaximumNumClips [in] the maximum number of clips
+	 *
+	 * @return the ids of the clips that should be deleted from the cache
+	 */
+	TArray<FString> EvictClips(const int64 MaximumSizeInBytes, const int32 MaximumNumClips);
+
+	/**
+	 * Save the manifest if it has changed since it was last saved
+	 */
+	void SaveIfChanged();
+
+	/**
+	 * Save the manifest if anything has changed since it was last saved ignoring the throttling of access time changes
+	 */
+	void Flush();
+
+private:
+
+	/** A single clip in the manifest */
+	struct FEntry
+	{
+		/** The size of the clip in bytes */
+		int64 SizeInBytes{0};
+
+		/** The last time the clip was added or requested in UTC ticks */
+		int64 LastAccessTime{0};
+	};
+
+	/** Identifies a manifest file */
+	static constexpr uint32 ManifestMagic{0x4D535457};
+
+	/** The current version of the manifest file format */
+	static constexpr uint32 ManifestVersion{1};
+
+	/** Changes that are only to access times are saved at most this often */
+	static constexpr double MinimumSecondsBetweenAccessSaves{60.0};
+
+	/** Load the manifest if it has not been loaded yet, rebuilding it if necessary */
+	void LoadIfNeeded();
+
+	/** Load the manifest from disk */
+	bool Load();
+
+	/** Rebuild the manifest from the contents of the cache */
+	void Rebuild();
+
+	/** Save the manifest to disk */
+	void Save();
+
+	/** Get the full path of the manifest file */
+	FString GetManifestPath() const;
+
+	/** The cache directory */
+	FString Directory{};
+
+	/** Lists the clips in the cache */
+	FScanFunction ScanFunction{};
+
+	/** Has the manifest been loaded? */
+	bool bIsLoaded{false};
+
+	/** Have clips been added or removed since the manifest was last saved? */
+	bool bHasClipsChanged{false};
+
+	/** Have access times changed since the manifest was last saved? */
+	bool bHasAccessTimesChanged{false};
+
+	/** The time the manifest was last saved */
+	double LastSaveTime{0.0};
+
+	/** The clips in the cache keyed by clip id */
+	TMap<FString, FEntry> Entries{};
+
+	/** The total size of the clips in the cache */
+	int64 UsedSizeInBytes{0};
+};
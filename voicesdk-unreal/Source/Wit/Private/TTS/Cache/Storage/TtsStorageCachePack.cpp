@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "TTS/Cache/Storage/TtsStorageCachePack.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * Constructor
+ *
+ * @param InDirectory [in] the directory to store the pack and index files in
+ */
+FTtsStorageCachePack::FTtsStorageCachePack(const FString& InDirectory)
+	: Directory(InDirectory)
+{
+}
+
+/**
+ * Destructor
+ */
+FTtsStorageCachePack::~FTtsStorageCachePack()
+{
+	UnmapPack();
+}
+
+/**
+ * Add a clip to the pack. The clip data is appended to the pack file before the index is saved so the index never refers to data
+ * that is not on disk
+ *
+ * @param ClipHash [in] the hash of the clip id
+ * @param SettingsHash [in] the hash of the settings used to create the clip
+ * @param ClipData [in] the binary data that represents the clip
+ *
+ * @return true if the clip was added
+ */
+bool FTtsStorageCachePack::AddClip(const FSHAHash& ClipHash, const uint32 SettingsHash, const TArray<uint8>& ClipData)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OpenIfNeeded();
+
+	const int32 Position = FindEntryPosition(ClipHash);
+	const bool bIsExistingEntry = Entries.IsValidIndex(Position) && Entries[Position].ClipHash == ClipHash;
+
+	if (bIsExistingEntry && Entries[Position].SettingsHash == SettingsHash && Entries[Position].Length == ClipData.Num())
+	{
+		UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::AddClip: clip already exists so no need to add to pack"));
+		return true;
+	}
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!FileManager.DirectoryExists(*Directory) && !FileManager.CreateDirectoryTree(*Directory))
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::AddClip: failed to create pack directory (%s)"), *Directory);
+		return false;
+	}
+
+	// Some platforms do not allow writing to a file while it is mapped so we release the mapping and map it again on the next read
+
+	UnmapPack();
+
+	const TUniquePtr<IFileHandle> FileHandle(FileManager.OpenWrite(*GetPackPath(), true));
+
+	if (FileHandle == nullptr)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::AddClip: failed to open pack file for writing (%s)"), *GetPackPath());
+		return false;
+	}
+
+	// Anything past the size recorded in the index was left behind by an append that never made it into the index
+
+	const int64 Offset = FileHandle->Size();
+
+	UnusedSizeInBytes += FMath::Max<int64>(Offset - PackSizeInBytes, 0);
+
+	const bool bDidWriteSuccessfully = FileHandle->Write(ClipData.GetData(), ClipData.Num()) && FileHandle->Flush();
+	if (!bDidWriteSuccessfully)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::AddClip: failed to write clip to pack file (%s)"), *GetPackPath());
+		return false;
+	}
+
+	PackSizeInBytes = Offset + ClipData.Num();
+
+	if (bIsExistingEntry)
+	{
+		UnusedSizeInBytes += Entries[Position].Length;
+	}
+	else
+	{
+		Entries.Insert(FEntry(), Position);
+	}
+
+	FEntry& Entry = Entries[Position];
+
+	Entry.ClipHash = ClipHash;
+	Entry.Offset = Offset;
+	Entry.Length = ClipData.Num();
+	Entry.SettingsHash = SettingsHash;
+
+	UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::AddClip: added clip at offset (%lld) with size (%d)"), Offset, ClipData.Num());
+
+	return SaveIndex();
+}
+
+/**
+ * Request a clip from the pack
+ *
+ * @param ClipHash [in] the hash of the clip id
+ * @param ClipData [out] the binary data that represents the clip
+ *
+ * @return true if the clip is in the pack
+ */
+bool FTtsStorageCachePack::RequestClip(const FSHAHash& ClipHash, TArray<uint8>& ClipData)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OpenIfNeeded();
+
+	const int32 EntryIndex = FindEntryIndex(ClipHash);
+
+	if (EntryIndex == INDEX_NONE)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::RequestClip: clip does not exist in pack"));
+		return false;
+	}
+
+	return ReadEntry(Entries[EntryIndex], ClipData);
+}
+
+/**
+ * Remove a clip from the pack. The space it used is not reclaimed until the pack is compacted
+ *
+ * @param ClipHash [in] the hash of the clip id
+ *
+ * @return true if the clip was removed
+ */
+bool FTtsStorageCachePack::RemoveClip(const FSHAHash& ClipHash)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OpenIfNeeded();
+
+	const int32 EntryIndex = FindEntryIndex(ClipHash);
+
+	if (EntryIndex == INDEX_NONE)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::RemoveClip: clip does not exist in pack"));
+		return false;
+	}
+
+	UnusedSizeInBytes += Entries[EntryIndex].Length;
+
+	Entries.RemoveAt(EntryIndex);
+
+	return SaveIndex();
+}
+
+/**
+ * Remove all clips and delete the pack and index files
+ */
+void FTtsStorageCachePack::RemoveAllClips()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Reset();
+
+	// The directory may be deleted after this so we must check it again next time
+
+	bIsOpen = false;
+}
+
+/**
+ * Get the size of every clip in the pack. The string form of a clip hash converts back to the same hash in GetClipHash
+ *
+ * @param ClipSizes [out] the size in bytes of each clip keyed by the string form of its hash
+ */
+void FTtsStorageCachePack::GetClipSizes(TMap<FString, int64>& ClipSizes)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OpenIfNeeded();
+
+	ClipSizes.Reserve(ClipSizes.Num() + Entries.Num());
+
+	for (const FEntry& Entry : Entries)
+	{
+		ClipSizes.Add(Entry.ClipHash.ToString(), Entry.Length);
+	}
+}
+
+/**
+ * Is enough of the pack file unused that it is worth compacting?
+ *
+ * @return true if the pack should be compacted
+ */
+bool FTtsStorageCachePack::ShouldCompact() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	return UnusedSizeInBytes >= MinimumCompactionSizeInBytes && UnusedSizeInBytes * 2 >= PackSizeInBytes;
+}
+
+/**
+ * Rewrite the pack file so that it only contains the clips that are still in the index. The new pack is written to a temporary file
+ * and only replaces the existing one once it is complete. This holds the lock throughout so it should only be called from a
+ * background thread
+ */
+void FTtsStorageCachePack::Compact()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OpenIfNeeded();
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	const FString PackPath = GetPackPath();
+	const FString CompactedPackPath = PackPath + TEXT(".tmp");
+
+	TArray<int64> CompactedOffsets;
+	CompactedOffsets.Reserve(Entries.Num());
+
+	int64 CompactedSizeInBytes = 0;
+
+	{
+		const TUniquePtr<IFileHandle> FileHandle(FileManager.OpenWrite(*CompactedPackPath));
+
+		if (FileHandle == nullptr)
+		{
+			UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::Compact: failed to open compacted pack file for writing (%s)"), *CompactedPackPath);
+			return;
+		}
+
+		TArray<uint8> ClipData;
+
+		for (const FEntry& Entry : Entries)
+		{
+			const bool bDidCopySuccessfully = ReadEntry(Entry, ClipData) && FileHandle->Write(ClipData.GetData(), ClipData.Num());
+			if (!bDidCopySuccessfully)
+			{
+				UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::Compact: failed to copy clip to compacted pack file"));
+
+				FileManager.DeleteFile(*CompactedPackPath);
+				return;
+			}
+
+			CompactedOffsets.Add(CompactedSizeInBytes);
+			CompactedSizeInBytes += Entry.Length;
+		}
+
+		FileHandle->Flush();
+	}
+
+	UnmapPack();
+
+	FileManager.DeleteFile(*PackPath);
+
+	if (!FileManager.MoveFile(*PackPath, *CompactedPackPath))
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::Compact: failed to replace pack file (%s)"), *PackPath);
+
+		Reset();
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::Compact: compacted pack from (%lld) to (%lld) bytes"), PackSizeInBytes, CompactedSizeInBytes);
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		Entries[EntryIndex].Offset = CompactedOffsets[EntryIndex];
+	}
+
+	PackSizeInBytes = CompactedSizeInBytes;
+	UnusedSizeInBytes = 0;
+
+	SaveIndex();
+}
+
+/**
+ * Get the hash used to index a clip id. Clip ids are normally the hex string of a SHA1 hash already so we convert those straight
+ * back rather than hash them again
+ *
+ * @param ClipId [in] the clip id
+ *
+ * @return the hash of the clip id
+ */
+FSHAHash FTtsStorageCachePack::GetClipHash(const FString& ClipId)
+{
+	FSHAHash ClipHash;
+
+	const bool bIsHashString = ClipId.Len() == sizeof(ClipHash.Hash) * 2;
+	if (bIsHashString)
+	{
+		ClipHash.FromString(ClipId);
+	}
+	else
+	{
+		FSHA1::HashBuffer(*ClipId, ClipId.Len() * sizeof(TCHAR), ClipHash.Hash);
+	}
+
+	return ClipHash;
+}
+
+/**
+ * Load the index if it has not been loaded yet. An index that cannot be loaded is discarded along with the pack file
+ */
+void FTtsStorageCachePack::OpenIfNeeded()
+{
+	if (bIsOpen)
+	{
+		return;
+	}
+
+	bIsOpen = true;
+
+	if (!LoadIndex())
+	{
+		Reset();
+	}
+}
+
+/**
+ * Load the index from disk and check that it is consistent with the pack file
+ *
+ * @return true if the index was loaded or does not exist yet
+ */
+bool FTtsStorageCachePack::LoadIndex()
+{
+	Entries.Empty();
+	PackSizeInBytes = 0;
+	UnusedSizeInBytes = 0;
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	const FString IndexPath = GetIndexPath();
+
+	if (!FileManager.FileExists(*IndexPath))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::LoadIndex: index does not exist so starting an empty pack"));
+		return !FileManager.FileExists(*GetPackPath());
+	}
+
+	TArray<uint8> IndexData;
+
+	if (!FFileHelper::LoadFileToArray(IndexData, *IndexPath))
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::LoadIndex: failed to read index file (%s)"), *IndexPath);
+		return false;
+	}
+
+	FMemoryReader Reader(IndexData);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumEntries = 0;
+
+	Reader << Magic << Version << PackSizeInBytes << UnusedSizeInBytes << NumEntries;
+
+	const bool bIsValidHeader = !Reader.IsError() && Magic == IndexMagic && Version == IndexVersion && NumEntries >= 0;
+	if (!bIsValidHeader)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::LoadIndex: index file is not valid (%s)"), *IndexPath);
+		return false;
+	}
+
+	// The pack file can be larger than the index says if an append was interrupted but never smaller
+
+	const int64 ActualPackSizeInBytes = FMath::Max<int64>(FileManager.FileSize(*GetPackPath()), 0);
+
+	if (ActualPackSizeInBytes < PackSizeInBytes)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::LoadIndex: pack file is smaller than the index expects (%s)"), *GetPackPath());
+		return false;
+	}
+
+	Entries.SetNum(NumEntries);
+
+	for (FEntry& Entry : Entries)
+	{
+		Reader.Serialize(Entry.ClipHash.Hash, sizeof(Entry.ClipHash.Hash));
+		Reader << Entry.Offset << Entry.Length << Entry.SettingsHash;
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::LoadIndex: index file is truncated (%s)"), *IndexPath);
+		return false;
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+
+		const bool bIsInPack = Entry.Offset >= 0 && Entry.Length >= 0 && Entry.Offset + Entry.Length <= PackSizeInBytes;
+		const bool bIsSorted = EntryIndex == 0 || FMemory::Memcmp(Entries[EntryIndex - 1].ClipHash.Hash, Entry.ClipHash.Hash, sizeof(Entry.ClipHash.Hash)) < 0;
+
+		if (!bIsInPack || !bIsSorted)
+		{
+			UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::LoadIndex: index file is corrupt (%s)"), *IndexPath);
+			return false;
+		}
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCachePack::LoadIndex: loaded index with (%d) clips and pack size (%lld)"), Entries.Num(), PackSizeInBytes);
+
+	return true;
+}
+
+/**
+ * Save the index to disk
+ *
+ * @return true if the index was saved
+ */
+bool FTtsStorageCachePack::SaveIndex() const
+{
+	TArray<uint8> IndexData;
+	IndexData.Reserve(32 + Entries.Num() * sizeof(FEntry));
+
+	FMemoryWriter Writer(IndexData);
+
+	uint32 Magic = IndexMagic;
+	uint32 Version = IndexVersion;
+	int64 PackSize = PackSizeInBytes;
+	int64 UnusedSize = UnusedSizeInBytes;
+	int32 NumEntries = Entries.Num();
+
+	Writer << Magic << Version << PackSize << UnusedSize << NumEntries;
+
+	for (const FEntry& Entry : Entries)
+	{
+		FEntry EntryToWrite(Entry);
+
+		Writer.Serialize(EntryToWrite.ClipHash.Hash, sizeof(EntryToWrite.ClipHash.Hash));
+		Writer << EntryToWrite.Offset << EntryToWrite.Length << EntryToWrite.SettingsHash;
+	}
+
+	const bool bDidSaveSuccessfully = FFileHelper::SaveArrayToFile(IndexData, *GetIndexPath());
+	if (!bDidSaveSuccessfully)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::SaveIndex: failed to write index file (%s)"), *GetIndexPath());
+	}
+
+	return bDidSaveSuccessfully;
+}
+
+/**
+ * Discard the index and delete the pack and index files
+ */
+void FTtsStorageCachePack::Reset()
+{
+	UnmapPack();
+
+	Entries.Empty();
+	PackSizeInBytes = 0;
+	UnusedSizeInBytes = 0;
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	FileManager.DeleteFile(*GetIndexPath());
+	FileManager.DeleteFile(*GetPackPath());
+}
+
+/**
+ * Find the position a clip is at, or should be inserted at, in the sorted index
+ *
+ * @param ClipHash [in] the hash of the clip id
+ *
+ * @return the position of the first entry not less than the clip hash
+ */
+int32 FTtsStorageCachePack::FindEntryPosition(const FSHAHash& ClipHash) const
+{
+	int32 Low = 0;
+	int32 High = Entries.Num();
+
+	while (Low < High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+
+		if (FMemory::Memcmp(Entries[Middle].ClipHash.Hash, ClipHash.Hash, sizeof(ClipHash.Hash)) < 0)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	return Low;
+}
+
+/**
+ * Find the index entry for a clip
+ *
+ * @param ClipHash [in] the hash of the clip id
+ *
+ * @return the index of the entry or INDEX_NONE if the clip is not in the pack
+ */
+int32 FTtsStorageCachePack::FindEntryIndex(const FSHAHash& ClipHash) const
+{
+	const int32 Position = FindEntryPosition(ClipHash);
+
+	if (!Entries.IsValidIndex(Position) || !(Entries[Position].ClipHash == ClipHash))
+	{
+		return INDEX_NONE;
+	}
+
+	return Position;
+}
+
+/**
+ * Map the pack file into memory if it is not already mapped at its current size
+ *
+ * @return true if the pack file is mapped
+ */
+bool FTtsStorageCachePack::MapPack()
+{
+	if (MappedPackRegion.IsValid() && MappedPackRegion->GetMappedSize() >= PackSizeInBytes)
+	{
+		return true;
+	}
+
+	UnmapPack();
+
+	if (PackSizeInBytes == 0)
+	{
+		return false;
+	}
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+	MappedPackHandle.Reset(FileManager.OpenMapped(*GetPackPath()));
+#else
+	FOpenMappedResult OpenResult = FileManager.OpenMappedEx(*GetPackPath());
+
+	if (OpenResult.HasValue())
+	{
+		MappedPackHandle = OpenResult.StealValue();
+	}
+#endif
+
+	if (!MappedPackHandle.IsValid())
+	{
+		return false;
+	}
+
+	MappedPackRegion.Reset(MappedPackHandle->MapRegion(0, PackSizeInBytes));
+
+	if (!MappedPackRegion.IsValid())
+	{
+		MappedPackHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Release any memory mapping of the pack file. The region must be released before the handle
+ */
+void FTtsStorageCachePack::UnmapPack()
+{
+	MappedPackRegion.Reset();
+	MappedPackHandle.Reset();
+}
+
+/**
+ * Read a clip from the pack file. This copies straight out of the memory mapping when there is one and otherwise falls back to
+ * reading from a file handle
+ *
+ * @param Entry [in] the index entry of the clip
+ * @param ClipData [out] the binary data that represents the clip
+ *
+ * @return true if the clip was read
+ */
+bool FTtsStorageCachePack::ReadEntry(const FEntry& Entry, TArray<uint8>& ClipData)
+{
+	ClipData.SetNumUninitialized(Entry.Length);
+
+	if (MapPack())
+	{
+		FMemory::Memcpy(ClipData.GetData(), MappedPackRegion->GetMappedPtr() + Entry.Offset, Entry.Length);
+		return true;
+	}
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	const TUniquePtr<IFileHandle> FileHandle(FileManager.OpenRead(*GetPackPath()));
+
+	const bool bDidReadSuccessfully = FileHandle != nullptr && FileHandle->Seek(Entry.Offset) && FileHandle->Read(ClipData.GetData(), Entry.Length);
+	if (!bDidReadSuccessfully)
+	{
+		UE_LOG(LogWit, Warning, TEXT("FTtsStorageCachePack::ReadEntry: failed to read clip from pack file (%s)"), *GetPackPath());
+
+		ClipData.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Get the full path of the pack file
+ *
+ * @return the path
+ */
+FString FTtsStorageCachePack::GetPackPath() const
+{
+	return Directory / TEXT("Clips.pack");
+}
+
+/**
+ * Get the full path of the index file
+ *
+ * @return the path
+ */
+FString FTtsStorageCachePack::GetIndexPath() const
+{
+	return Directory / TEXT("Clips.index");
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/SecureHash.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Stores every clip in a cache directory in a single append-only pack file alongside a compact index sorted by clip hash. The index is
+ * loaded once when the pack is first used and lookups are a binary search. Reads copy straight out of a memory mapping of the pack file
+ * where the platform supports it. Space left behind by removed or replaced clips is reclaimed by compaction. All functions are thread safe
+ */
+class FTtsStorageCachePack final
+{
+public:
+
+	/**
+	 * Constructor
+	 *
+	 * @param InDirectory [in] the directory to store the pack and index files in
+	 */
+	explicit FTtsStorageCachePack(const FString& InDirectory);
+
+	/**
+	 * Destructor
+	 */
+	~FTtsStorageCachePack();
+
+	/**
+	 * Add a clip to the pack. If the same clip is already stored with the same settings and size then nothing is written
+	 *
+	 * @param ClipHash [in] the hash of the clip id
+	 * @param SettingsHash [in] the hash of the settings used to create the clip
+	 * @param ClipData [in] the binary data that represents the clip
+	 *
+	 * @return true if the clip was added
+	 */
+	bool AddClip(const FSHAHash& ClipHash, const uint32 SettingsHash, const TArray<uint8>& ClipData);
+
+	/**
+	 * Request a clip from the pack
+	 *
+	 * @param ClipHash [in] the hash of the clip id
+	 * @param ClipData [out] the binary data that represents the clip
+	 *
+	 * @return true if the clip is in the pack
+	 */
+	bool RequestClip(const FSHAHash& ClipHash, TArray<uint8>& ClipData);
+
+	/**
+	 * Remove a clip from the pack. The space it used is not reclaimed until the pack is compacted
+	 *
+	 * @param ClipHash [in] the hash of the clip id
+	 *
+	 * @return true if the clip was removed
+	 */
+	bool RemoveClip(const FSHAHash& ClipHash);
+
+	/**
+	 * Remove all clips and delete the pack and index files
+	 */
+	void RemoveAllClips();
+
+	/**
+	 * Get the size of every clip in the pack
+	 *
+	 * @param ClipSizes [out] the size in bytes of each clip keyed by the string form of its hash
+	 */
+	void GetClipSizes(TMap<FString, int64>& ClipSizes);
+
+	/**
+	 * Is enough of the pack file unused that it is worth compacting?
+	 *
+	 * @return true if the pack should be compacted
+	 */
+	bool ShouldCompact() const;
+
+	/**
+	 * Rewrite the pack file so that it only contains the clips that are still in the index
+	 */
+	void Compact();
+
+	/**
+	 * Get the hash used to index a clip id
+	 *
+	 * @param ClipId [in] the clip id
+	 *
+	 * @return the hash of the clip id
+	 */
+	static FSHAHash GetClipHash(const FString& ClipId);
+
+private:
+
+	/** A single clip in the index */
+	struct FEntry
+	{
+		/** The hash of the clip id. The index is sorted by this */
+		FSHAHash ClipHash{};
+
+		/** The offset of the clip data in the pack file */
+		int64 Offset{0};
+
+		/** The size of the clip data in bytes */
+		int32 Length{0};
+
+		/** The hash of the settings used to create the clip */
+		uint32 SettingsHash{0};
+	};
+
+	/** Identifies an index file */
+	static constexpr uint32 IndexMagic{0x4B505457};
+
+	/** The current version of the index file format */
+	static constexpr uint32 IndexVersion{1};
+
+	/** The number of unused bytes in the pack file before we consider compacting it */
+	static constexpr int64 MinimumCompactionSizeInBytes{1024 * 1024};
+
+	/** Load the index if it has not been loaded yet */
+	void OpenIfNeeded();
+
+	/** Load the index from disk */
+	bool LoadIndex();
+
+	/** Save the index to disk */
+	bool SaveIndex() const;
+
+	/** Discard the index and delete the pack and index files */
+	void Reset();
+
+	/** Find the position a clip is at, or should be inserted at, in the sorted index */
+	int32 FindEntryPosition(const FSHAHash& ClipHash) const;
+
+	/** Find the index entry for a clip */
+	int32 FindEntryIndex(const FSHAHash& ClipHash) const;
+
+	/** Map the pack file into memory if it is not already mapped at its current size */
+	bool MapPack();
+
+	/** Release any memory mapping of the pack file */
+	void UnmapPack();
+
+	/** Read a clip directly from the pack file */
+	bool ReadEntry(const FEntry& Entry, TArray<uint8>& ClipData);
+
+	/** Get the full path of the pack file */
+	FString GetPackPath() const;
+
+	/** Get the full path of the index file */
+	FString GetIndexPath() const;
+
+	/** Guards access to the state below */
+	mutable FCriticalSection Lock;
+
+	/** The directory the pack and index files are stored in */
+	FString Directory{};
+
+	/** Has the index been loaded? */
+	bool bIsOpen{false};
+
+	/** The clips in the pack sorted by clip hash */
+	TArray<FEntry> Entries{};
+
+	/** The size of the pack file in bytes */
+	int64 PackSizeInBytes{0};
+
+	/** The number of bytes in the pack file that are no longer referenced by the index */
+	int64 UnusedSizeInBytes{0};
+
+	/** The memory mapped pack file. Null if the pack is not mapped or the platform does not support it */
+	TUniquePtr<IMappedFileHandle> MappedPackHandle{};
+
+	/** The mapped region of the pack file */
+	TUniquePtr<IMappedFileRegion> MappedPackRegion{};
+};
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "TTS/Cache/Storage/TtsStorageCacheWorker.h"
+#include "Async/Async.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Wit/Utilities/WitHelperUtilities.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * Queue a task to run on the worker thread. If nothing is currently processing the queue a background task is started to do so
+ *
+ * @param Task [in] the task to run
+ */
+void FTtsStorageCacheWorker::QueueTask(TUniqueFunction<void()>&& Task)
+{
+	bool bShouldStartProcessing;
+
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		Tasks.Add(MoveTemp(Task));
+
+		bShouldStartProcessing = !bIsProcessing;
+		bIsProcessing = true;
+	}
+
+	if (bShouldStartProcessing)
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Worker = AsShared()]()
+		{
+			Worker->ProcessTasks();
+		});
+	}
+}
+
+/**
+ * Queue a read of a clip file
+ *
+ * @param FilePath [in] the full path of the clip file
+ * @param OnComplete [in] called on the game thread with the clip data
+ */
+void FTtsStorageCacheWorker::QueueRead(const FString& FilePath, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete)
+{
+	QueueRead([FilePath](TArray<uint8>& ClipData)
+	{
+		return FWitHelperUtilities::LoadClipFromBinaryFile(FilePath, ClipData);
+	}, OnComplete);
+}
+
+/**
+ * Queue a read of a clip using a custom read function
+ *
+ * @param ReadFunction [in] reads the clip data on the worker thread and returns true if successful
+ * @param OnComplete [in] called on the game thread with the clip data
+ */
+void FTtsStorageCacheWorker::QueueRead(TUniqueFunction<bool(TArray<uint8>&)>&& ReadFunction, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete)
+{
+	QueueTask([ReadFunction = MoveTemp(ReadFunction), OnComplete]()
+	{
+		TArray<uint8> ClipData;
+
+		const bool bIsSuccessful = ReadFunction(ClipData);
+
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, bIsSuccessful, ClipData = MoveTemp(ClipData)]()
+		{
+			OnComplete.ExecuteIfBound(bIsSuccessful, ClipData);
+		});
+	});
+}
+
+/**
+ * Queue a write of a clip file. If a write to the same file is still waiting to run then its data is replaced instead and no further
+ * task is queued
+ *
+ * @param FilePath [in] the full path of the clip file
+ * @param ClipData [in] the clip data to write
+ * @param OnComplete [in] called on the game thread once the write has finished
+ */
+void FTtsStorageCacheWorker::QueueWrite(const FString& FilePath, const TArray<uint8>& ClipData, const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete)
+{
+	QueueWrite(FilePath, ClipData, TFunction<bool(const TArray<uint8>&)>(), OnComplete);
+}
+
+/**
+ * Queue a write of a clip using a custom write function. Writes are coalesced by file path in the same way as a normal write
+ *
+ * @param FilePath [in] the path that identifies the clip
+ * @param ClipData [in] the clip data to write
+ * @param WriteFunction [in] writes the clip data on the worker thread and returns true if successful
+ * @param OnComplete [in] called on the game thread once the write has finished
+ */
+void FTtsStorageCacheWorker::QueueWrite(const FString& FilePath, const TArray<uint8>& ClipData, TFunction<bool(const TArray<uint8>&)>&& WriteFunction,
+	const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		FPendingWrite* ExistingWrite = PendingWrites.Find(FilePath);
+
+		if (ExistingWrite != nullptr)
+		{
+			UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheWorker::QueueWrite: coalescing write to (%s)"), *FilePath);
+
+			ExistingWrite->ClipData = ClipData;
+			ExistingWrite->WriteFunction = MoveTemp(WriteFunction);
+			ExistingWrite->OnComplete.Add(OnComplete);
+
+			return;
+		}
+
+		FPendingWrite& NewWrite = PendingWrites.Add(FilePath);
+
+		NewWrite.ClipData = ClipData;
+		NewWrite.WriteFunction = MoveTemp(WriteFunction);
+		NewWrite.OnComplete.Add(OnComplete);
+	}
+
+	QueueTask([this, FilePath]()
+	{
+		FPendingWrite Write;
+
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			if (!PendingWrites.RemoveAndCopyValue(FilePath, Write))
+			{
+				return;
+			}
+		}
+
+		bool bIsSuccessful;
+
+		if (Write.WriteFunction)
+		{
+			bIsSuccessful = Write.WriteFunction(Write.ClipData);
+		}
+		else
+		{
+			bIsSuccessful = EnsureDirectory(FPaths::GetPath(FilePath)) && FWitHelperUtilities::SaveClipToBinaryFile(FilePath, Write.ClipData);
+		}
+
+		CompleteWrite(MoveTemp(Write.OnComplete), bIsSuccessful);
+	});
+}
+
+/**
+ * Get the data of a write that has not run yet
+ *
+ * @param FilePath [in] the full path of the clip file
+ * @param ClipData [out] the clip data waiting to be written
+ *
+ * @return true if there is a write waiting for the file
+ */
+bool FTtsStorageCacheWorker::FindPendingWrite(const FString& FilePath, TArray<uint8>& ClipData) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FPendingWrite* Write = PendingWrites.Find(FilePath);
+
+	if (Write == nullptr)
+	{
+		return false;
+	}
+
+	ClipData = Write->ClipData;
+
+	return true;
+}
+
+/**
+ * Cancel any writes that have not run yet to files under the given path. Anyone waiting on a cancelled write is told it failed
+ *
+ * @param PathPrefix [in] the file or directory path to cancel writes for
+ */
+void FTtsStorageCacheWorker::CancelPendingWrites(const FString& PathPrefix)
+{
+	TArray<FOnTtsStorageCacheAddClipCompleteDelegate> CancelledOnComplete;
+
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		for (auto It = PendingWrites.CreateIterator(); It; ++It)
+		{
+			if (It.Key().StartsWith(PathPrefix))
+			{
+				CancelledOnComplete.Append(MoveTemp(It.Value().OnComplete));
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	if (CancelledOnComplete.Num() > 0)
+	{
+		CompleteWrite(MoveTemp(CancelledOnComplete), false);
+	}
+}
+
+/**
+ * Make sure a directory exists creating it if necessary
+ *
+ * @param Directory [in] the directory
+ *
+ * @return true if the directory exists
+ */
+bool FTtsStorageCacheWorker::EnsureDirectory(const FString& Directory)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		if (KnownDirectories.Contains(Directory))
+		{
+			return true;
+		}
+	}
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!FileManager.DirectoryExists(*Directory))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheWorker::EnsureDirectory: Cache directy does not exist so creating"));
+
+		const bool bDidCreateDirectory = FileManager.CreateDirectoryTree(*Directory);
+		if (!bDidCreateDirectory)
+		{
+			UE_LOG(LogWit, Verbose, TEXT("FTtsStorageCacheWorker::EnsureDirectory: Failed to create cache directory (%s)"), *Directory);
+
+			return false;
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	KnownDirectories.Add(Directory);
+
+	return true;
+}
+
+/**
+ * Forget that a directory, and any directory below it, exists
+ *
+ * @param Directory [in] the directory
+ */
+void FTtsStorageCacheWorker::ForgetDirectory(const FString& Directory)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (auto It = KnownDirectories.CreateIterator(); It; ++It)
+	{
+		if (It->StartsWith(Directory))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+/**
+ * Run queued tasks until the queue is empty. Called on a background thread
+ */
+void FTtsStorageCacheWorker::ProcessTasks()
+{
+	while (true)
+	{
+		TUniqueFunction<void()> Task;
+
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			if (Tasks.Num() == 0)
+			{
+				bIsProcessing = false;
+				return;
+			}
+
+			Task = MoveTemp(Tasks[0]);
+			Tasks.RemoveAt(0);
+		}
+
+		Task();
+	}
+}
+
+/**
+ * Call write completion delegates on the game thread
+ *
+ * @param OnComplete [in] the delegates to call
+ * @param bIsSuccessful [in] did the write succeed?
+ */
+void FTtsStorageCacheWorker::CompleteWrite(TArray<FOnTtsStorageCacheAddClipCompleteDelegate>&& OnComplete, const bool bIsSuccessful)
+{
+	AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete), bIsSuccessful]()
+	{
+		for (const FOnTtsStorageCacheAddClipCompleteDelegate& Delegate : OnComplete)
+		{
+			Delegate.ExecuteIfBound(bIsSuccessful);
+		}
+	});
+}
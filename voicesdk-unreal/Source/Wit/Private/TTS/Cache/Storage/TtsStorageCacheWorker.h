@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "TTS/Cache/Storage/Interface/ITtsStorageCacheHandlerBase.h"
+
+/**
+ * Performs storage cache file I/O on a background thread. Tasks are run one at a time in the order they are queued so a read always
+ * sees the result of any earlier write. Completion delegates are called back on the game thread. Writes to a file that are still
+ * waiting to run are coalesced so only the most recent data is written
+ */
+class FTtsStorageCacheWorker final : public TSharedFromThis<FTtsStorageCacheWorker, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Queue a task to run on the worker thread
+	 *
+	 * @param Task [in] the task to run
+	 */
+	void QueueTask(TUniqueFunction<void()>&& Task);
+
+	/**
+	 * Queue a read of a clip file
+	 *
+	 * @param FilePath [in] the full path of the clip file
+	 * @param OnComplete [in] called on the game thread with the clip data
+	 */
+	void QueueRead(const FString& FilePath, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete);
+
+	/**
+	 * Queue a read of a clip using a custom read function
+	 *
+	 * @param ReadFunction [in] reads the clip data on the worker thread and returns true if successful
+	 * @param OnComplete [in] called on the game thread with the clip data
+	 */
+	void QueueRead(TUniqueFunction<bool(TArray<uint8>&)>&& ReadFunction, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete);
+
+	/**
+	 * Queue a write of a clip file. If a write to the same file is still waiting to run then its data is replaced instead
+	 *
+	 * @param FilePath [in] the full path of the clip file
+	 * @param ClipData [in] the clip data to write
+	 * @param OnComplete [in] called on the game thread once the write has finished
+	 */
+	void QueueWrite(const FString& FilePath, const TArray<uint8>& ClipData, const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete);
+
+	/**
+	 * Queue a write of a clip using a custom write function. Writes are coalesced by file path in the same way as a normal write so the
+	 * path only needs to uniquely identify the clip
+	 *
+	 * @param FilePath [in] the path that identifies the clip
+	 * @param ClipData [in] the clip data to write
+	 * @param WriteFunction [in] writes the clip data on the worker thread and returns true if successful
+	 * @param OnComplete [in] called on the game thread once the write has finished
+	 */
+	void QueueWrite(const FString& FilePath, const TArray<uint8>& ClipData, TFunction<bool(const TArray<uint8>&)>&& WriteFunction,
+		const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete);
+
+	/**
+	 * Get the data of a write that has not run yet
+	 *
+	 * @param FilePath [in] the full path of the clip file
+	 * @param ClipData [out] the clip data waiting to be written
+	 *
+	 * @return true if there is a write waiting for the file
+	 */
+	bool FindPendingWrite(const FString& FilePath, TArray<uint8>& ClipData) const;
+
+	/**
+	 * Cancel any writes that have not run yet to files under the given path
+	 *
+	 * @param PathPrefix [in] the file or directory path to cancel writes for
+	 */
+	void CancelPendingWrites(const FString& PathPrefix);
+
+	/**
+	 * Make sure a directory exists creating it if necessary. Directories that are known to exist are remembered so the file system
+	 * is only queried once per directory. Can be called from any thread
+	 *
+	 * @param Directory [in] the directory
+	 *
+	 * @return true if the directory exists
+	 */
+	bool EnsureDirectory(const FString& Directory);
+
+	/**
+	 * Forget that a directory exists. Call this after deleting a directory
+	 *
+	 * @param Directory [in] the directory
+	 */
+	void ForgetDirectory(const FString& Directory);
+
+private:
+
+	/** A write that is waiting to run */
+	struct FPendingWrite
+	{
+		/** The most recent data to write */
+		TArray<uint8> ClipData{};
+
+		/** Writes the data. If not set the data is written to a file at the pending write's path */
+		TFunction<bool(const TArray<uint8>&)> WriteFunction{};
+
+		/** Everyone waiting for the write to finish */
+		TArray<FOnTtsStorageCacheAddClipCompleteDelegate> OnComplete{};
+	};
+
+	/** Run queued tasks until the queue is empty */
+	void ProcessTasks();
+
+	/** Call write completion delegates on the game thread */
+	static void CompleteWrite(TArray<FOnTtsStorageCacheAddClipCompleteDelegate>&& OnComplete, const bool bIsSuccessful);
+
+	/** Guards access to the state below */
+	mutable FCriticalSection Lock;
+
+	/** Tasks waiting to run */
+	TArray<TUniqueFunction<void()>> Tasks{};
+
+	/** Is a background task currently processing the queue? */
+	bool bIsProcessing{false};
+
+	/** Writes that are waiting to run, keyed by file path */
+	TMap<FString, FPendingWrite> PendingWrites{};
+
+	/** Directories that are known to exist */
+	TSet<FString> KnownDirectories{};
+};
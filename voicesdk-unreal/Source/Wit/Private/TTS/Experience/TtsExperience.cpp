@@ -10,6 +10,7 @@
 #include "TTS/Cache/Memory/TtsMemoryCache.h"
 #include "TTS/Cache/Storage/TtsStorageCache.h"
 #include "Wit/Utilities/WitLog.h"
+#include "Wit/Utilities/WitExperienceRegistry.h"
 
 /**
  * Sets default values for this actor's properties
@@ -31,9 +32,29 @@ void ATtsExperience::BeginPlay()
 {
 	InitializeService();
 	
+	if (UWitExperienceRegistry* Registry = GetWorld()->GetSubsystem<UWitExperienceRegistry>())
+	{
+		Registry->RegisterExperience(this);
+	}
+
 	Super::BeginPlay();
 }
 
+/**
+ * Called when play ends. Unregisters from the experience registry
+ *
+ * @param EndPlayReason [in] why play ended
+ */
+void ATtsExperience::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWitExperienceRegistry* Registry = GetWorld()->GetSubsystem<UWitExperienceRegistry>())
+	{
+		Registry->UnregisterExperience(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 /**
  * Initialize the service
  */
@@ -43,6 +64,7 @@ void ATtsExperience::InitializeService()
 	{
 		TtsService->SetHandlers(EventHandler, MemoryCacheHandler, StorageCacheHandler);
 		TtsService->SetConfiguration(Configuration, VoicePreset, AudioType, bUseStreaming, InitialStreamBufferSize, bUseWebSocket);
+		TtsService->SetMaxPipelinedRequests(MaxPipelinedRequests);
 	}
 }
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Voice/Capture/VoiceActivityDetector.h"
+
+/**
+ * Configure the detector. This resets any detection state
+ *
+ * @param InSampleRate [in] the sample rate of the audio that will be processed
+ * @param InSettings [in] the settings to use
+ */
+void FVoiceActivityDetector::Configure(const int32 InSampleRate, const FVoiceActivityDetectorSettings& InSettings)
+{
+	Settings = InSettings;
+
+	FrameSize = FMath::Max(FMath::RoundToInt(InSampleRate * FrameTime), 1);
+	NumOnsetFrames = FMath::Max(FMath::CeilToInt(Settings.OnsetTime / FrameTime), 1);
+	NumHangoverFrames = FMath::Max(FMath::CeilToInt(Settings.HangoverTime / FrameTime), 0);
+	NumWarmUpFrames = FMath::CeilToInt(WarmUpTime / FrameTime);
+
+	Reset();
+}
+
+/**
+ * Reset the detection state ready for a new capture
+ */
+void FVoiceActivityDetector::Reset()
+{
+	FrameSumOfSquares = 0.0;
+	FrameNumZeroCrossings = 0;
+	FrameNumSamples = 0;
+	bWasLastSampleNegative = false;
+	NumFramesProcessed = 0;
+	NumSpeechFrames = 0;
+	NumHangoverFramesRemaining = 0;
+	Energy = 0.0f;
+	NoiseFloor = 0.0f;
+	bIsVoiceActive = false;
+}
+
+/**
+ * Analyse a block of audio. Blocks can be any size, frames are carried over between calls
+ *
+ * @param Samples [in] the 16-bit little endian mono samples
+ * @param NumSamples [in] the number of samples
+ */
+void FVoiceActivityDetector::Process(const uint8* Samples, const int32 NumSamples)
+{
+	constexpr float ScaleFactor = 1.0f / 32768.0f;
+
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		const int16 SampleValue = Samples[i * 2] | (Samples[i * 2 + 1] << 8);
+		const float Sample = SampleValue * ScaleFactor;
+
+		const bool bIsSampleNegative = SampleValue < 0;
+
+		if (FrameNumSamples > 0 && bIsSampleNegative != bWasLastSampleNegative)
+		{
+			++FrameNumZeroCrossings;
+		}
+
+		bWasLastSampleNegative = bIsSampleNegative;
+		FrameSumOfSquares += Sample * Sample;
+
+		if (++FrameNumSamples == FrameSize)
+		{
+			ProcessFrame();
+		}
+	}
+}
+
+/**
+ * Classify the completed frame and update the voice state
+ */
+void FVoiceActivityDetector::ProcessFrame()
+{
+	Energy = FMath::Sqrt(static_cast<float>(FrameSumOfSquares / FrameNumSamples));
+
+	const float ZeroCrossingRate = static_cast<float>(FrameNumZeroCrossings) / FrameNumSamples;
+
+	FrameSumOfSquares = 0.0;
+	FrameNumZeroCrossings = 0;
+	FrameNumSamples = 0;
+
+	++NumFramesProcessed;
+
+	// The first frames only teach us what the background sounds like. The floor follows the average energy so a single loud frame
+	// does not dominate
+
+	if (NumFramesProcessed <= NumWarmUpFrames)
+	{
+		NoiseFloor += (Energy - NoiseFloor) / NumFramesProcessed;
+		return;
+	}
+
+	const float SpeechThreshold = FMath::Max(Settings.MinimumEnergy, NoiseFloor * Settings.SpeechToNoiseRatio);
+	const bool bIsSpeechFrame = Energy > SpeechThreshold && ZeroCrossingRate <= Settings.MaximumZeroCrossingRate;
+
+	// The floor drops quickly so a burst of noise at the start does not mask speech, and rises slowly so speech does not raise it
+
+	if (bIsSpeechFrame)
+	{
+		NoiseFloor += (Energy - NoiseFloor) * NoiseFloorSpeechRiseRate;
+	}
+	else
+	{
+		NoiseFloor += (Energy - NoiseFloor) * (Energy < NoiseFloor ? NoiseFloorFallRate : NoiseFloorRiseRate);
+	}
+
+	if (bIsSpeechFrame)
+	{
+		NumSpeechFrames = FMath::Min(NumSpeechFrames + 1, NumOnsetFrames);
+
+		if (NumSpeechFrames >= NumOnsetFrames)
+		{
+			bIsVoiceActive = true;
+			NumHangoverFramesRemaining = NumHangoverFrames;
+		}
+
+		return;
+	}
+
+	NumSpeechFrames = 0;
+
+	if (NumHangoverFramesRemaining > 0)
+	{
+		--NumHangoverFramesRemaining;
+		return;
+	}
+
+	bIsVoiceActive = false;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Settings that control how the voice activity detector classifies audio
+ */
+struct FVoiceActivityDetectorSettings
+{
+	/** How many times louder than the noise floor a frame must be to count as speech */
+	float SpeechToNoiseRatio{2.0f};
+
+	/** The minimum RMS energy (0 -> 1) a frame must have to count as speech regardless of the noise floor */
+	float MinimumEnergy{0.005f};
+
+	/** The maximum fraction of samples that may cross zero in a frame for it to count as speech. Broadband noise crosses far more often */
+	float MaximumZeroCrossingRate{0.35f};
+
+	/** How long (in seconds) speech must be detected before voice is considered active */
+	float OnsetTime{0.04f};
+
+	/** How long (in seconds) voice stays active after the last speech frame so short pauses between words do not end it */
+	float HangoverTime{0.3f};
+};
+
+/**
+ * Streaming energy based voice activity detector. Audio is analysed in 20ms frames. A frame counts as speech when its RMS energy is
+ * well above an adaptive estimate of the background noise and its zero crossing rate is not that of broadband noise. Voice becomes
+ * active after a short run of speech frames and stays active for a hangover period after the last one. Processing does not allocate
+ */
+class FVoiceActivityDetector final
+{
+public:
+
+	/**
+	 * Configure the detector. This resets any detection state
+	 *
+	 * @param InSampleRate [in] the sample rate of the audio that will be processed
+	 * @param InSettings [in] the settings to use
+	 */
+	void Configure(const int32 InSampleRate, const FVoiceActivityDetectorSettings& InSettings);
+
+	/**
+	 * Reset the detection state ready for a new capture
+	 */
+	void Reset();
+
+	/**
+	 * Analyse a block of audio. Blocks can be any size, frames are carried over between calls
+	 *
+	 * @param Samples [in] the 16-bit little endian mono samples
+	 * @param NumSamples [in] the number of samples
+	 */
+	void Process(const uint8* Samples, const int32 NumSamples);
+
+	/**
+	 * Is voice currently active?
+	 *
+	 * @return true if voice is active
+	 */
+	bool IsVoiceActive() const
+	{
+		return bIsVoiceActive;
+	}
+
+	/**
+	 * Get the RMS energy (0 -> 1) of the last analysed frame
+	 *
+	 * @return the energy
+	 */
+	float GetEnergy() const
+	{
+		return Energy;
+	}
+
+	/**
+	 * Get the current estimate of the background noise RMS energy (0 -> 1)
+	 *
+	 * @return the noise floor
+	 */
+	float GetNoiseFloor() const
+	{
+		return NoiseFloor;
+	}
+
+private:
+
+	/** The duration (in seconds) of a single analysis frame */
+	static constexpr float FrameTime{0.02f};
+
+	/** The duration (in seconds) at the start of capture used only to learn the noise floor */
+	static constexpr float WarmUpTime{0.2f};
+
+	/** How quickly the noise floor follows quieter non-speech frames */
+	static constexpr float NoiseFloorFallRate{0.5f};
+
+	/** How quickly the noise floor follows louder non-speech frames */
+	static constexpr float NoiseFloorRiseRate{0.05f};
+
+	/** How quickly the noise floor follows speech frames. This lets it recover if a constant loud noise is mistaken for speech */
+	static constexpr float NoiseFloorSpeechRiseRate{0.002f};
+
+	/** Classify the completed frame and update the voice state */
+	void ProcessFrame();
+
+	/** The settings in use */
+	FVoiceActivityDetectorSettings Settings{};
+
+	/** The number of samples in an analysis frame */
+	int32 FrameSize{320};
+
+	/** The number of frames of speech needed before voice is active */
+	int32 NumOnsetFrames{2};
+
+	/** The number of frames voice stays active after the last speech frame */
+	int32 NumHangoverFrames{15};
+
+	/** The number of frames used to learn the noise floor at the start of capture */
+	int32 NumWarmUpFrames{10};
+
+	/** The sum of the squared normalised samples in the current frame */
+	double FrameSumOfSquares{0.0};
+
+	/** The number of zero crossings in the current frame */
+	int32 FrameNumZeroCrossings{0};
+
+	/** The number of samples in the current frame */
+	int32 FrameNumSamples{0};
+
+	/** Was the last sample processed negative? */
+	bool bWasLastSampleNegative{false};
+
+	/** The number of frames analysed since the last reset */
+	int32 NumFramesProcessed{0};
+
+	/** The number of consecutive speech frames */
+	int32 NumSpeechFrames{0};
+
+	/** The number of frames left before voice stops being active */
+	int32 NumHangoverFramesRemaining{0};
+
+	/** The RMS energy of the last analysed frame */
+	float Energy{0.0f};
+
+	/** The estimate of the background noise RMS energy */
+	float NoiseFloor{0.0f};
+
+	/** Is voice currently active? */
+	bool bIsVoiceActive{false};
+};
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Voice/Capture/VoiceCapturePreRollBuffer.h"
+
+/**
+ * Set the capacity of the buffer. This discards any buffered data
+ *
+ * @param InCapacity [in] the capacity in bytes
+ */
+void FVoiceCapturePreRollBuffer::SetCapacity(const int32 InCapacity)
+{
+	const int32 Capacity = FMath::Max(InCapacity, 0);
+
+	if (Capacity != Buffer.Num())
+	{
+		Buffer.Empty(Capacity);
+		Buffer.AddUninitialized(Capacity);
+	}
+
+	Reset();
+}
+
+/**
+ * Discard any buffered data
+ */
+void FVoiceCapturePreRollBuffer::Reset()
+{
+	WritePosition = 0;
+	NumBytes = 0;
+}
+
+/**
+ * Add data to the buffer overwriting the oldest data if there is not enough space. If the data is larger than the buffer only its end
+ * is kept
+ *
+ * @param Data [in] the data to add
+ * @param Size [in] the size of the data in bytes
+ */
+void FVoiceCapturePreRollBuffer::Write(const uint8* Data, const int32 Size)
+{
+	const int32 Capacity = Buffer.Num();
+
+	if (Capacity == 0 || Data == nullptr || Size <= 0)
+	{
+		return;
+	}
+
+	int32 NumBytesToWrite = Size;
+
+	if (NumBytesToWrite > Capacity)
+	{
+		Data += NumBytesToWrite - Capacity;
+		NumBytesToWrite = Capacity;
+	}
+
+	// The write wraps around the end of the storage at most once
+
+	const int32 NumBytesBeforeWrap = FMath::Min(NumBytesToWrite, Capacity - WritePosition);
+
+	FMemory::Memcpy(Buffer.GetData() + WritePosition, Data, NumBytesBeforeWrap);
+
+	if (NumBytesBeforeWrap < NumBytesToWrite)
+	{
+		FMemory::Memcpy(Buffer.GetData(), Data + NumBytesBeforeWrap, NumBytesToWrite - NumBytesBeforeWrap);
+	}
+
+	WritePosition = (WritePosition + NumBytesToWrite) % Capacity;
+	NumBytes = FMath::Min(NumBytes + NumBytesToWrite, Capacity);
+}
+
+/**
+ * Copy the buffered data from oldest to newest
+ *
+ * @param OutData [out] the buffered data
+ */
+void FVoiceCapturePreRollBuffer::CopyTo(TArray<uint8>& OutData) const
+{
+	OutData.Reset();
+
+	if (NumBytes == 0)
+	{
+		return;
+	}
+
+	const int32 Capacity = Buffer.Num();
+	const int32 ReadPosition = (WritePosition - NumBytes + Capacity) % Capacity;
+	const int32 NumBytesBeforeWrap = FMath::Min(NumBytes, Capacity - ReadPosition);
+
+	OutData.AddUninitialized(NumBytes);
+
+	FMemory::Memcpy(OutData.GetData(), Buffer.GetData() + ReadPosition, NumBytesBeforeWrap);
+
+	if (NumBytesBeforeWrap < NumBytes)
+	{
+		FMemory::Memcpy(OutData.GetData() + NumBytesBeforeWrap, Buffer.GetData(), NumBytes - NumBytesBeforeWrap);
+	}
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed size ring buffer holding the most recently captured voice data. Once full, new data overwrites the oldest so it always holds
+ * the last few hundred milliseconds of capture. The storage is allocated once when the capacity is set and writes never allocate or
+ * lock. It is only used from the game thread
+ */
+class FVoiceCapturePreRollBuffer final
+{
+public:
+
+	/**
+	 * Set the capacity of the buffer. This discards any buffered data
+	 *
+	 * @param InCapacity [in] the capacity in bytes
+	 */
+	void SetCapacity(const int32 InCapacity);
+
+	/**
+	 * Get the capacity of the buffer
+	 *
+	 * @return the capacity in bytes
+	 */
+	int32 GetCapacity() const
+	{
+		return Buffer.Num();
+	}
+
+	/**
+	 * Get the amount of data in the buffer
+	 *
+	 * @return the size of the data in bytes
+	 */
+	int32 Num() const
+	{
+		return NumBytes;
+	}
+
+	/**
+	 * Discard any buffered data
+	 */
+	void Reset();
+
+	/**
+	 * Add data to the buffer overwriting the oldest data if there is not enough space
+	 *
+	 * @param Data [in] the data to add
+	 * @param Size [in] the size of the data in bytes
+	 */
+	void Write(const uint8* Data, const int32 Size);
+
+	/**
+	 * Copy the buffered data from oldest to newest
+	 *
+	 * @param OutData [out] the buffered data
+	 */
+	void CopyTo(TArray<uint8>& OutData) const;
+
+private:
+
+	/** The ring storage */
+	TArray<uint8> Buffer{};
+
+	/** The position the next write starts at */
+	int32 WritePosition{0};
+
+	/** The amount of data in the buffer in bytes */
+	int32 NumBytes{0};
+};
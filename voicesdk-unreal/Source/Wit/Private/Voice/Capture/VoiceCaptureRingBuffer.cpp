@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Voice/Capture/VoiceCaptureRingBuffer.h"
+
+/**
+ * Set the capacity of the buffer. This discards any buffered data
+ *
+ * @param InCapacity [in] the capacity in bytes
+ */
+void FVoiceCaptureRingBuffer::SetCapacity(const int32 InCapacity)
+{
+	const int32 Capacity = FMath::Max(InCapacity, 0);
+
+	if (Capacity != Buffer.Num())
+	{
+		Buffer.Empty(Capacity);
+		Buffer.AddUninitialized(Capacity);
+	}
+
+	Reset();
+}
+
+/**
+ * Discard any buffered data
+ */
+void FVoiceCaptureRingBuffer::Reset()
+{
+	NumBytesWritten.store(0);
+	NumBytesRead.store(0);
+}
+
+/**
+ * Add data to the buffer. Called from the producer. If there is not enough free space only the data that fits is added
+ *
+ * @param Data [in] the data to add
+ * @param Size [in] the size of the data in bytes
+ *
+ * @return the number of bytes added
+ */
+int32 FVoiceCaptureRingBuffer::Write(const uint8* Data, const int32 Size)
+{
+	const int32 Capacity = Buffer.Num();
+
+	if (Capacity == 0 || Data == nullptr || Size <= 0)
+	{
+		return 0;
+	}
+
+	// The acquire pairs with the release in Read so the space the consumer has finished with is safe to overwrite
+
+	const uint64 WriteCount = NumBytesWritten.load(std::memory_order_relaxed);
+	const uint64 ReadCount = NumBytesRead.load(std::memory_order_acquire);
+
+	const int32 NumFreeBytes = Capacity - static_cast<int32>(WriteCount - ReadCount);
+	const int32 NumBytesToWrite = FMath::Min(Size, NumFreeBytes);
+
+	if (NumBytesToWrite <= 0)
+	{
+		return 0;
+	}
+
+	const int32 WritePosition = static_cast<int32>(WriteCount % Capacity);
+	const int32 NumBytesBeforeWrap = FMath::Min(NumBytesToWrite, Capacity - WritePosition);
+
+	FMemory::Memcpy(Buffer.GetData() + WritePosition, Data, NumBytesBeforeWrap);
+
+	if (NumBytesBeforeWrap < NumBytesToWrite)
+	{
+		FMemory::Memcpy(Buffer.GetData(), Data + NumBytesBeforeWrap, NumBytesToWrite - NumBytesBeforeWrap);
+	}
+
+	NumBytesWritten.store(WriteCount + NumBytesToWrite, std::memory_order_release);
+
+	return NumBytesToWrite;
+}
+
+/**
+ * Remove all the buffered data. Called from the consumer. If there is no data the output is left untouched
+ *
+ * @param OutData [out] the buffered data from oldest to newest
+ *
+ * @return the number of bytes read
+ */
+int32 FVoiceCaptureRingBuffer::Read(TArray<uint8>& OutData)
+{
+	const int32 Capacity = Buffer.Num();
+
+	if (Capacity == 0)
+	{
+		return 0;
+	}
+
+	// The acquire pairs with the release in Write so the data the producer has written is visible before we copy it
+
+	const uint64 ReadCount = NumBytesRead.load(std::memory_order_relaxed);
+	const uint64 WriteCount = NumBytesWritten.load(std::memory_order_acquire);
+
+	const int32 NumBytesToRead = static_cast<int32>(WriteCount - ReadCount);
+
+	if (NumBytesToRead <= 0)
+	{
+		return 0;
+	}
+
+	const int32 ReadPosition = static_cast<int32>(ReadCount % Capacity);
+	const int32 NumBytesBeforeWrap = FMath::Min(NumBytesToRead, Capacity - ReadPosition);
+
+	OutData.Reset();
+	OutData.AddUninitialized(NumBytesToRead);
+
+	FMemory::Memcpy(OutData.GetData(), Buffer.GetData() + ReadPosition, NumBytesBeforeWrap);
+
+	if (NumBytesBeforeWrap < NumBytesToRead)
+	{
+		FMemory::Memcpy(OutData.GetData() + NumBytesBeforeWrap, Buffer.GetData(), NumBytesToRead - NumBytesBeforeWrap);
+	}
+
+	NumBytesRead.store(ReadCount + NumBytesToRead, std::memory_order_release);
+
+	return NumBytesToRead;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Single producer single consumer ring buffer used to pass captured voice data from the capture thread to the game thread. Write may
+ * only be called from the producer and Read only from the consumer. Neither locks or allocates. SetCapacity and Reset are not thread
+ * safe and must only be called while there is no producer running
+ */
+class FVoiceCaptureRingBuffer final
+{
+public:
+
+	/**
+	 * Set the capacity of the buffer. This discards any buffered data
+	 *
+	 * @param InCapacity [in] the capacity in bytes
+	 */
+	void SetCapacity(const int32 InCapacity);
+
+	/**
+	 * Get the capacity of the buffer
+	 *
+	 * @return the capacity in bytes
+	 */
+	int32 GetCapacity() const
+	{
+		return Buffer.Num();
+	}
+
+	/**
+	 * Discard any buffered data
+	 */
+	void Reset();
+
+	/**
+	 * Add data to the buffer. Called from the producer. If there is not enough free space only the data that fits is added
+	 *
+	 * @param Data [in] the data to add
+	 * @param Size [in] the size of the data in bytes
+	 *
+	 * @return the number of bytes added
+	 */
+	int32 Write(const uint8* Data, const int32 Size);
+
+	/**
+	 * Remove all the buffered data. Called from the consumer. If there is no data the output is left untouched
+	 *
+	 * @param OutData [out] the buffered data from oldest to newest
+	 *
+	 * @return the number of bytes read
+	 */
+	int32 Read(TArray<uint8>& OutData);
+
+private:
+
+	/** The ring storage */
+	TArray<uint8> Buffer{};
+
+	/** The total number of bytes ever written. Only modified by the producer */
+	std::atomic<uint64> NumBytesWritten{0};
+
+	/** The total number of bytes ever read. Only modified by the consumer */
+	std::atomic<uint64> NumBytesRead{0};
+};
@@ -9,6 +9,7 @@
 #include "VoiceModule.h"
 #include "Emulation/VoiceCaptureEmulation.h"
 #include "Emulation/VoiceCaptureEmulationByTTS.h"
+#include "HAL/PlatformProcess.h"
 #include "Wit/Utilities/WitConversionUtilities.h"
 #include "Wit/Utilities/WitLog.h"
 #include "Misc/EngineVersionComparison.h"
@@ -38,6 +39,8 @@ void UVoiceCaptureSubsystem::Deinitialize()
 	FCoreDelegates::ApplicationWillEnterBackgroundDelegate.RemoveAll(this);
 #endif
 	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+
+	StopCaptureThread();
 }
 
 /**
@@ -173,6 +176,7 @@ bool UVoiceCaptureSubsystem::CreateVoiceCapture()
 
 	VoiceCapture->DumpState();
 
+	bIsPlatformCapture = true;
 	MaxBufferSize = VoiceCapture->GetBufferSize();
 	VoiceBuffer.Reserve(MaxBufferSize);
 
@@ -202,6 +206,7 @@ void UVoiceCaptureSubsystem::CreateEmulationVoiceCapture()
 	MaxBufferSize = EmulationVoiceCapture->GetBufferSize();
 	VoiceBuffer.Reserve(MaxBufferSize);
 
+	bIsPlatformCapture = false;
 	VoiceCapture = EmulationVoiceCapture;
 }
 
@@ -216,6 +221,8 @@ void UVoiceCaptureSubsystem::Shutdown()
 		return;
 	}
 
+	StopCaptureThread();
+
 	if (IsCapturing())
 	{
 		VoiceCapture->Stop();
@@ -229,8 +236,10 @@ void UVoiceCaptureSubsystem::Shutdown()
 
 /**
  * Indicates that we want to start receiving data from the voice capture module
+ *
+ * @param VoiceConfiguration [in] the configuration controlling the pre-roll, voice activity and end of utterance detection
  */
-bool UVoiceCaptureSubsystem::Start()
+bool UVoiceCaptureSubsystem::Start(const FVoiceConfiguration& VoiceConfiguration)
 {
 	if (!IsCaptureAvailable())
 	{
@@ -247,12 +256,94 @@ bool UVoiceCaptureSubsystem::Start()
 	UE_LOG(LogWit, Verbose, TEXT("VoiceCapture - Start: starting capture"));
 
 	VoiceBuffer.Reset();
-	return VoiceCapture->Start();
+
+	// The pre-roll holds whole 16 bit samples so overwriting the oldest data never splits a sample
+
+	const int32 NumPreRollSamples = FMath::Max(FMath::FloorToInt(VoiceConfiguration.PreRollTime * SampleRate), 0);
+
+	PreRollBuffer.SetCapacity(NumPreRollSamples * NumChannels * sizeof(int16));
+	bIsPreRollActive = PreRollBuffer.GetCapacity() > 0;
+
+	// The detector analyses mono audio so it is only used when capturing a single channel
+
+	FVoiceActivityDetectorSettings VoiceActivitySettings;
+
+	VoiceActivitySettings.SpeechToNoiseRatio = VoiceConfiguration.VoiceActivitySpeechToNoiseRatio;
+	VoiceActivitySettings.MinimumEnergy = VoiceConfiguration.VoiceActivityMinimumVolume;
+	VoiceActivitySettings.MaximumZeroCrossingRate = VoiceConfiguration.VoiceActivityMaximumZeroCrossingRate;
+	VoiceActivitySettings.HangoverTime = VoiceConfiguration.VoiceActivityHangoverTime;
+
+	VoiceActivityDetector.Configure(SampleRate, VoiceActivitySettings);
+	bIsVoiceActivityDetectionEnabled = VoiceConfiguration.bIsVoiceActivityDetectionEnabled && NumChannels == 1;
+
+	// The endpointer uses the detector's noise floor when it is available so the silence threshold follows the background noise
+
+	FVoiceEndpointerSettings EndpointerSettings;
+
+	EndpointerSettings.SilenceEnergy = VoiceConfiguration.EndOfUtteranceSilenceVolume;
+	EndpointerSettings.SpeechToNoiseRatio = VoiceConfiguration.VoiceActivitySpeechToNoiseRatio;
+	EndpointerSettings.MinimumSpeechTime = VoiceConfiguration.EndOfUtteranceMinimumSpeechTime;
+	EndpointerSettings.SilenceTime = VoiceConfiguration.EndOfUtteranceSilenceTime;
+
+	Endpointer.Configure(SampleRate, EndpointerSettings);
+	bIsEndOfUtteranceDetectionEnabled = VoiceConfiguration.bIsEndOfUtteranceDetectionEnabled && NumChannels == 1;
+
+	if (!VoiceCapture->Start())
+	{
+		return false;
+	}
+
+	StartCaptureThread();
+
+	return true;
+}
+
+/**
+ * Start polling the platform voice capture on its own thread. Emulated capture produces its data from a game thread ticker so it
+ * is still read directly
+ */
+void UVoiceCaptureSubsystem::StartCaptureThread()
+{
+	StopCaptureThread();
+
+	if (!bIsPlatformCapture || !FPlatformProcess::SupportsMultithreading())
+	{
+		return;
+	}
+
+	CaptureRingBuffer.SetCapacity(MaxDuration * SampleRate * NumChannels * sizeof(int16));
+	LastNumDroppedBytes = 0;
+
+	CaptureThread = MakeUnique<FVoiceCaptureThread>(VoiceCapture.ToSharedRef(), CaptureRingBuffer, MaxBufferSize);
 }
 
 /**
- * Reads data from the voice capture module into our internal buffer. The amount of data read by each call to Read
- * is variable and depends on the platform and how often the function is called
+ * Stop and join the capture thread if it is running. Anything the thread captured since the last read is left in the voice buffer
+ */
+void UVoiceCaptureSubsystem::StopCaptureThread()
+{
+	if (!CaptureThread.IsValid())
+	{
+		return;
+	}
+
+	CaptureThread.Reset();
+
+	// The thread has been joined so nothing else writes to the ring buffer. Whatever it holds is the end of the utterance
+
+	VoiceBuffer.Reset();
+
+	const int32 NumBytesRead = CaptureRingBuffer.Read(VoiceBuffer);
+
+	UE_LOG(LogWit, Verbose, TEXT("VoiceCapture - StopCaptureThread: drained (%d) bytes from capture thread"), NumBytesRead);
+
+	CaptureRingBuffer.Reset();
+}
+
+/**
+ * Reads data from the voice capture module into our internal buffer. With platform capture this is everything the capture thread
+ * has produced since the last call. Otherwise the amount of data read is variable and depends on the platform and how often the
+ * function is called
  *
  * @return true if successfully read
  */
@@ -270,6 +361,57 @@ bool UVoiceCaptureSubsystem::Read()
 		return false;
 	}
 
+	const bool bIsDataRead = CaptureThread.IsValid() ? ReadFromCaptureThread() : ReadFromVoiceCapture();
+
+	if (bIsDataRead && bIsPreRollActive)
+	{
+		PreRollBuffer.Write(VoiceBuffer.GetData(), VoiceBuffer.Num());
+	}
+
+	if (bIsDataRead && bIsVoiceActivityDetectionEnabled)
+	{
+		VoiceActivityDetector.Process(VoiceBuffer.GetData(), VoiceBuffer.Num() / sizeof(int16));
+	}
+
+	if (bIsDataRead && bIsEndOfUtteranceDetectionEnabled)
+	{
+		const float NoiseFloor = bIsVoiceActivityDetectionEnabled ? VoiceActivityDetector.GetNoiseFloor() : 0.0f;
+
+		Endpointer.Process(VoiceBuffer.GetData(), VoiceBuffer.Num() / sizeof(int16), NoiseFloor);
+	}
+
+	return bIsDataRead;
+}
+
+/**
+ * Reads the data the capture thread has produced since the last call into our internal buffer
+ *
+ * @return true if any data was read
+ */
+bool UVoiceCaptureSubsystem::ReadFromCaptureThread()
+{
+	const int32 NumBytesRead = CaptureRingBuffer.Read(VoiceBuffer);
+
+	const int64 NumDroppedBytes = CaptureThread->GetNumDroppedBytes();
+	if (NumDroppedBytes != LastNumDroppedBytes)
+	{
+		UE_LOG(LogWit, Warning, TEXT("VoiceCapture - Read: capture buffer was full - dropped (%lld) bytes"), NumDroppedBytes - LastNumDroppedBytes);
+		LastNumDroppedBytes = NumDroppedBytes;
+	}
+
+	UE_LOG(LogWit, VeryVerbose, TEXT("VoiceCapture - Read: read (%d) bytes from capture thread"), NumBytesRead);
+
+	return NumBytesRead > 0;
+}
+
+/**
+ * Reads data from the voice capture module directly into our internal buffer. The amount of data read by each call is variable and
+ * depends on the platform and how often the function is called
+ *
+ * @return true if any data was read
+ */
+bool UVoiceCaptureSubsystem::ReadFromVoiceCapture()
+{
 	// Determine whether and how much new voice data is available to be used
 
 	uint32 NumAvailableBytes = 0;
@@ -337,7 +479,7 @@ bool UVoiceCaptureSubsystem::Read()
 }
 
 /**
- * Stop receiving voice capture data
+ * Stop receiving voice capture data. Afterwards the voice buffer holds only the data captured since the last read, which may be none
  */
 void UVoiceCaptureSubsystem::Stop()
 {
@@ -347,6 +489,17 @@ void UVoiceCaptureSubsystem::Stop()
 		return;
 	}
 
+	// The thread must be joined before the capture is stopped so it is never polled while stopping
+
+	if (CaptureThread.IsValid())
+	{
+		StopCaptureThread();
+	}
+	else
+	{
+		VoiceBuffer.Reset();
+	}
+
 	if (!IsCapturing())
 	{
 		UE_LOG(LogWit, Warning, TEXT("VoiceCapture - Stop: attempting to stop before capture has been started"));
@@ -355,9 +508,78 @@ void UVoiceCaptureSubsystem::Stop()
 
 	VoiceCapture->Stop();
 
+	bIsPreRollActive = false;
+	PreRollBuffer.Reset();
+
 	UE_LOG(LogWit, Verbose, TEXT("VoiceCapture - Stop: stopping capture"));
 }
 
+/**
+ * Replace the voice buffer with the pre-roll audio kept since capture started. The pre-roll ends with the latest data read so it
+ * should be sent in place of it. Pre-roll stops being kept after this is called until capture is started again
+ *
+ * @return true if there was any pre-roll audio
+ */
+bool UVoiceCaptureSubsystem::FlushPreRoll()
+{
+	if (!bIsPreRollActive)
+	{
+		return false;
+	}
+
+	bIsPreRollActive = false;
+
+	if (PreRollBuffer.Num() == 0)
+	{
+		return false;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("VoiceCapture - FlushPreRoll: flushing (%d) bytes of pre-roll"), PreRollBuffer.Num());
+
+	PreRollBuffer.CopyTo(VoiceBuffer);
+	PreRollBuffer.Reset();
+
+	return true;
+}
+
+/**
+ * Is voice activity detection running on the captured voice data?
+ *
+ * @return true if enabled
+ */
+bool UVoiceCaptureSubsystem::IsVoiceActivityDetectionEnabled() const
+{
+	return bIsVoiceActivityDetectionEnabled;
+}
+
+/**
+ * Has the voice activity detector classified the recent voice data as speech?
+ *
+ * @return true if speech is detected
+ */
+bool UVoiceCaptureSubsystem::IsVoiceActive() const
+{
+	return IsCapturing() && VoiceActivityDetector.IsVoiceActive();
+}
+
+/**
+ * Has the end of the current utterance been detected? Always false if end of utterance detection is disabled
+ *
+ * @return true if the utterance has ended
+ */
+bool UVoiceCaptureSubsystem::IsEndOfUtterance() const
+{
+	return bIsEndOfUtteranceDetectionEnabled && Endpointer.IsEndOfUtterance();
+}
+
+/**
+ * Start looking for the end of a new utterance. Anything heard before this does not count towards it
+ */
+void UVoiceCaptureSubsystem::ResetEndOfUtterance()
+{
+	Endpointer.Reset();
+}
+
 /**
  * Returns the current amplitude of the voice capture
  *
@@ -370,7 +592,9 @@ float UVoiceCaptureSubsystem::GetCurrentAmplitude() const
 		return 0.0f;
 	}
 
-	const float Amplitude = VoiceCapture->GetCurrentAmplitude();
+	// While the capture thread runs only it calls into the voice capture so we use the amplitude it last saw
+
+	const float Amplitude = CaptureThread.IsValid() ? CaptureThread->GetCurrentAmplitude() : VoiceCapture->GetCurrentAmplitude();
 
 	// GetCurrentAmplitude returns a value of -1.0 if there is no amplitude information available. This happens on certain platforms
 	
@@ -404,6 +628,11 @@ bool UVoiceCaptureSubsystem::IsCaptureAvailable() const
  */
 bool UVoiceCaptureSubsystem::IsCapturing() const
 {
+	if (CaptureThread.IsValid())
+	{
+		return CaptureThread->IsCapturing();
+	}
+
 	return IsCaptureAvailable() && VoiceCapture->IsCapturing();
 }
 
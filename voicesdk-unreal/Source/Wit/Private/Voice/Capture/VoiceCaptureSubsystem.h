@@ -9,6 +9,11 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "Voice/Capture/VoiceActivityDetector.h"
+#include "Voice/Capture/VoiceEndpointer.h"
+#include "Voice/Capture/VoiceCapturePreRollBuffer.h"
+#include "Voice/Capture/VoiceCaptureRingBuffer.h"
+#include "Voice/Capture/VoiceCaptureThread.h"
 #include "Voice/Configuration/VoiceConfiguration.h"
 #include "VoiceCaptureSubsystem.generated.h"
 
@@ -53,18 +58,54 @@ public:
 	 * Starts capturing voice data. Captured voice data is buffered in the internal buffer
 	 * up until the maximum specified duration
 	 *
+	 * @param VoiceConfiguration [in] the configuration controlling the pre-roll, voice activity and end of utterance detection
+	 *
 	 * @return true if successfully started
 	 */
-	bool Start();
+	bool Start(const FVoiceConfiguration& VoiceConfiguration);
 
 	/**
-	 * Reads data from the voice capture module into the internal buffer for processing
-	 * This should typically be called every frame
+	 * Reads data from the voice capture module into the internal buffer for processing. With platform capture the data is
+	 * everything the capture thread has produced since the last call. This should typically be called every frame
 	 *
 	 * @return true if any data was read
 	 */
 	bool Read();
 
+	/**
+	 * Replace the voice buffer with the pre-roll audio kept since capture started. The pre-roll ends with the latest data read so it
+	 * should be sent in place of it. Pre-roll stops being kept after this is called until capture is started again
+	 *
+	 * @return true if there was any pre-roll audio
+	 */
+	bool FlushPreRoll();
+
+	/**
+	 * Is voice activity detection running on the captured voice data?
+	 *
+	 * @return true if enabled
+	 */
+	bool IsVoiceActivityDetectionEnabled() const;
+
+	/**
+	 * Has the voice activity detector classified the recent voice data as speech?
+	 *
+	 * @return true if speech is detected
+	 */
+	bool IsVoiceActive() const;
+
+	/**
+	 * Has the end of the current utterance been detected? Always false if end of utterance detection is disabled
+	 *
+	 * @return true if the utterance has ended
+	 */
+	bool IsEndOfUtterance() const;
+
+	/**
+	 * Start looking for the end of a new utterance. Anything heard before this does not count towards it
+	 */
+	void ResetEndOfUtterance();
+
 	/**
 	 * Returns the current amplitude of the voice capture
 	 *
@@ -73,7 +114,8 @@ public:
 	float GetCurrentAmplitude() const;
 	
 	/**
-	 * Stop capturing voice data. Should be paired with Start
+	 * Stop capturing voice data. Should be paired with Start. Afterwards the voice buffer holds only the data captured since the last
+	 * read, which may be none
 	 */
 	void Stop();
 
@@ -110,7 +152,7 @@ public:
 	/** The number of channels in the captured voice data. UE4 by default captures 1 channel. Changing this value may cause it to not function correctly */
 	const int32 NumChannels{1};
 
-	/** The maximum duration (in seconds) of the voice data we can store in our internal buffer */
+	/** The maximum duration (in seconds) of the voice data the capture thread can buffer between calls to Read */
 	const int32 MaxDuration{1};
 
 private:
@@ -136,6 +178,30 @@ private:
 	  * Create the emulation voice capture
 	  */
 	void CreateEmulationVoiceCapture();
+
+	/**
+	  * Start polling the platform voice capture on its own thread
+	  */
+	void StartCaptureThread();
+
+	/**
+	  * Stop and join the capture thread if it is running. Anything it captured since the last read is left in the voice buffer
+	  */
+	void StopCaptureThread();
+
+	/**
+	  * Reads data from the voice capture module directly into the internal buffer. Used when there is no capture thread
+	  *
+	  * @return true if any data was read
+	  */
+	bool ReadFromVoiceCapture();
+
+	/**
+	  * Reads the data the capture thread has produced into the internal buffer
+	  *
+	  * @return true if any data was read
+	  */
+	bool ReadFromCaptureThread();
 	
 	/** UE4's voice capture implementation */
 	TSharedPtr<class IVoiceCapture> VoiceCapture{};
@@ -146,6 +212,36 @@ private:
 	/** Buffer that stores the captured voice data */
 	TArray<uint8> VoiceBuffer{};
 
+	/** Is the voice capture a platform capture rather than emulation? Only platform capture is polled on the capture thread */
+	bool bIsPlatformCapture{false};
+
+	/** Passes captured voice data from the capture thread to the game thread */
+	FVoiceCaptureRingBuffer CaptureRingBuffer{};
+
+	/** Polls the platform voice capture while capturing */
+	TUniquePtr<FVoiceCaptureThread> CaptureThread{};
+
+	/** The number of bytes the capture thread had dropped the last time we checked */
+	int64 LastNumDroppedBytes{0};
+
+	/** Keeps the most recent voice data from before a request starts so the start of the utterance is not lost */
+	FVoiceCapturePreRollBuffer PreRollBuffer{};
+
+	/** Are we currently keeping pre-roll audio? */
+	bool bIsPreRollActive{false};
+
+	/** Classifies the captured voice data as speech or background noise */
+	FVoiceActivityDetector VoiceActivityDetector{};
+
+	/** Is voice activity detection running for the current capture? */
+	bool bIsVoiceActivityDetectionEnabled{false};
+
+	/** Detects the trailing silence at the end of an utterance */
+	FVoiceEndpointer Endpointer{};
+
+	/** Is end of utterance detection running for the current capture? */
+	bool bIsEndOfUtteranceDetectionEnabled{false};
+
 	/** Allow the use of emulation if unable to initialise mic input */
 	EVoiceCaptureEmulationMode EmulationCaptureMode{EVoiceCaptureEmulationMode::None};
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Voice/Capture/VoiceCaptureThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/VoiceCapture.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Voice/Capture/VoiceCaptureRingBuffer.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * Create and start the capture thread
+ *
+ * @param InVoiceCapture [in] the voice capture to poll. It must already be capturing
+ * @param InRingBuffer [in] the ring buffer to write captured data to. It must outlive the thread
+ * @param MaxReadSize [in] the maximum amount of data to read from the voice capture in a single poll
+ */
+FVoiceCaptureThread::FVoiceCaptureThread(const TSharedRef<IVoiceCapture>& InVoiceCapture, FVoiceCaptureRingBuffer& InRingBuffer, const int32 MaxReadSize)
+	: VoiceCapture(InVoiceCapture)
+	, RingBuffer(InRingBuffer)
+{
+	ReadBuffer.AddUninitialized(FMath::Max(MaxReadSize, 1));
+
+	Thread = FRunnableThread::Create(this, TEXT("WitVoiceCapture"), 0, TPri_AboveNormal);
+
+	UE_LOG(LogWit, Verbose, TEXT("VoiceCaptureThread: started with max read size (%d)"), ReadBuffer.Num());
+}
+
+/**
+ * Stop and join the capture thread
+ */
+FVoiceCaptureThread::~FVoiceCaptureThread()
+{
+	if (Thread != nullptr)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("VoiceCaptureThread: stopped"));
+}
+
+/**
+ * Poll the voice capture until asked to stop
+ */
+uint32 FVoiceCaptureThread::Run()
+{
+	while (!bIsStopping.load(std::memory_order_relaxed))
+	{
+		Poll();
+
+		bIsCapturing.store(VoiceCapture->IsCapturing(), std::memory_order_relaxed);
+		CurrentAmplitude.store(VoiceCapture->GetCurrentAmplitude(), std::memory_order_relaxed);
+
+		FPlatformProcess::Sleep(PollInterval);
+	}
+
+	return 0;
+}
+
+/**
+ * Ask the thread to exit after the current poll
+ */
+void FVoiceCaptureThread::Stop()
+{
+	bIsStopping.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Read any available data from the voice capture into the ring buffer
+ */
+void FVoiceCaptureThread::Poll()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FVoiceCaptureThread::Poll);
+
+	uint32 NumAvailableBytes = 0;
+	uint32 NumOutputBytes = 0;
+
+	const EVoiceCaptureState::Type State = VoiceCapture->GetCaptureState(NumAvailableBytes);
+
+	if (State != EVoiceCaptureState::Ok || NumAvailableBytes == 0)
+	{
+		return;
+	}
+
+#if PLATFORM_ANDROID
+
+	// On Android this indicates useless noise data that accumulated during standby. We still need to request it as it will 
+	// reset the circular buffer and discard the data but won't actually write anything to our buffer. The size 4096 is
+	// arbitrary but big enough to trigger the special case code in the Android voice module
+
+	const bool bIsNoiseDataToBeDiscarded = (NumAvailableBytes > 2048);
+	if (bIsNoiseDataToBeDiscarded)
+	{
+		VoiceCapture->GetVoiceData(ReadBuffer.GetData(), ReadBuffer.Num(), NumOutputBytes);
+		return;
+	}
+
+#endif
+
+	// Anything beyond the read buffer stays in the voice capture until the next poll
+
+	const uint32 NumBytesToRead = FMath::Min(NumAvailableBytes, static_cast<uint32>(ReadBuffer.Num()));
+
+	VoiceCapture->GetVoiceData(ReadBuffer.GetData(), NumBytesToRead, NumOutputBytes);
+
+	const int32 NumBytesRead = static_cast<int32>(FMath::Min(NumOutputBytes, NumBytesToRead));
+	const int32 NumBytesWritten = RingBuffer.Write(ReadBuffer.GetData(), NumBytesRead);
+
+	if (NumBytesWritten < NumBytesRead)
+	{
+		NumDroppedBytes.fetch_add(NumBytesRead - NumBytesWritten, std::memory_order_relaxed);
+	}
+}
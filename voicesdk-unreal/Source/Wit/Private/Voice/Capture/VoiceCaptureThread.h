@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+class FVoiceCaptureRingBuffer;
+class IVoiceCapture;
+
+/**
+ * Polls a platform voice capture at a fixed cadence on its own thread and writes the captured data into a ring buffer for the game
+ * thread to consume. This keeps capture independent of the frame rate so long frames no longer overrun the platform capture buffer.
+ * The thread starts when the object is created and is stopped and joined when it is destroyed. While it runs the voice capture is
+ * only called from this thread so the game thread reads the capture state this thread publishes instead
+ */
+class FVoiceCaptureThread final : public FRunnable
+{
+public:
+
+	/**
+	 * Create and start the capture thread
+	 *
+	 * @param InVoiceCapture [in] the voice capture to poll. It must already be capturing
+	 * @param InRingBuffer [in] the ring buffer to write captured data to. It must outlive the thread
+	 * @param MaxReadSize [in] the maximum amount of data to read from the voice capture in a single poll
+	 */
+	FVoiceCaptureThread(const TSharedRef<IVoiceCapture>& InVoiceCapture, FVoiceCaptureRingBuffer& InRingBuffer, const int32 MaxReadSize);
+
+	/**
+	 * Stop and join the capture thread
+	 */
+	virtual ~FVoiceCaptureThread() override;
+
+	/**
+	 * FRunnable overrides
+	 */
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	/**
+	 * Get the number of bytes dropped because the ring buffer was full
+	 *
+	 * @return the number of bytes dropped
+	 */
+	int64 GetNumDroppedBytes() const
+	{
+		return NumDroppedBytes.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Was the voice capture capturing when it was last polled?
+	 *
+	 * @return true if capturing
+	 */
+	bool IsCapturing() const
+	{
+		return bIsCapturing.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Get the amplitude of the voice capture when it was last polled
+	 *
+	 * @return the amplitude or -1.0 if the platform does not provide it
+	 */
+	float GetCurrentAmplitude() const
+	{
+		return CurrentAmplitude.load(std::memory_order_relaxed);
+	}
+
+private:
+
+	/** How often (in seconds) the voice capture is polled */
+	static constexpr float PollInterval{0.01f};
+
+	/** Read any available data from the voice capture into the ring buffer */
+	void Poll();
+
+	/** The voice capture being polled */
+	TSharedRef<IVoiceCapture> VoiceCapture;
+
+	/** The ring buffer captured data is written to */
+	FVoiceCaptureRingBuffer& RingBuffer;
+
+	/** Scratch buffer the voice capture is read into before it is written to the ring buffer */
+	TArray<uint8> ReadBuffer{};
+
+	/** The thread doing the polling */
+	FRunnableThread* Thread{nullptr};
+
+	/** Set when the thread should exit */
+	std::atomic<bool> bIsStopping{false};
+
+	/** The number of bytes dropped because the ring buffer was full */
+	std::atomic<int64> NumDroppedBytes{0};
+
+	/** Was the voice capture capturing when it was last polled? It must already be capturing when the thread starts */
+	std::atomic<bool> bIsCapturing{true};
+
+	/** The amplitude of the voice capture when it was last polled */
+	std::atomic<float> CurrentAmplitude{-1.0f};
+};
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Voice/Capture/VoiceEndpointer.h"
+
+/**
+ * Configure the endpointer. This resets any detection state
+ *
+ * @param InSampleRate [in] the sample rate of the audio that will be processed
+ * @param InSettings [in] the settings to use
+ */
+void FVoiceEndpointer::Configure(const int32 InSampleRate, const FVoiceEndpointerSettings& InSettings)
+{
+	Settings = InSettings;
+
+	WindowSize = FMath::Max(FMath::RoundToInt(InSampleRate * WindowTime), 1);
+	NumMinimumSpeechWindows = FMath::Max(FMath::CeilToInt(Settings.MinimumSpeechTime / WindowTime), 1);
+	NumEndSilenceWindows = FMath::Max(FMath::CeilToInt(Settings.SilenceTime / WindowTime), 1);
+
+	Reset();
+}
+
+/**
+ * Reset the detection state ready for a new utterance
+ */
+void FVoiceEndpointer::Reset()
+{
+	WindowSumOfSquares = 0.0;
+	WindowNumSamples = 0;
+	NumSpeechWindows = 0;
+	NumSilenceWindows = 0;
+	bIsEndOfUtterance = false;
+}
+
+/**
+ * Analyse a block of audio. Blocks can be any size, windows are carried over between calls
+ *
+ * @param Samples [in] the 16-bit little endian mono samples
+ * @param NumSamples [in] the number of samples
+ * @param NoiseFloor [in] the current background noise RMS energy (0 -> 1) if known, otherwise zero
+ */
+void FVoiceEndpointer::Process(const uint8* Samples, const int32 NumSamples, const float NoiseFloor)
+{
+	constexpr float ScaleFactor = 1.0f / 32768.0f;
+
+	for (int32 i = 0; i < NumSamples && !bIsEndOfUtterance; ++i)
+	{
+		const int16 SampleValue = Samples[i * 2] | (Samples[i * 2 + 1] << 8);
+		const float Sample = SampleValue * ScaleFactor;
+
+		WindowSumOfSquares += Sample * Sample;
+
+		if (++WindowNumSamples == WindowSize)
+		{
+			ProcessWindow(NoiseFloor);
+		}
+	}
+}
+
+/**
+ * Classify the completed window and update the utterance state
+ *
+ * @param NoiseFloor [in] the current background noise RMS energy (0 -> 1) if known, otherwise zero
+ */
+void FVoiceEndpointer::ProcessWindow(const float NoiseFloor)
+{
+	const float Energy = FMath::Sqrt(static_cast<float>(WindowSumOfSquares / WindowNumSamples));
+
+	WindowSumOfSquares = 0.0;
+	WindowNumSamples = 0;
+
+	const float SpeechThreshold = FMath::Max(Settings.SilenceEnergy, NoiseFloor * Settings.SpeechToNoiseRatio);
+
+	if (Energy > SpeechThreshold)
+	{
+		++NumSpeechWindows;
+		NumSilenceWindows = 0;
+		return;
+	}
+
+	// Silence before enough speech has been heard is either leading silence or a false start so it never ends the utterance
+
+	if (NumSpeechWindows < NumMinimumSpeechWindows)
+	{
+		return;
+	}
+
+	++NumSilenceWindows;
+
+	bIsEndOfUtterance = NumSilenceWindows >= NumEndSilenceWindows;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Settings that control when the endpointer decides an utterance has ended
+ */
+struct FVoiceEndpointerSettings
+{
+	/** The RMS energy (0 -> 1) a window must exceed to count as speech */
+	float SilenceEnergy{0.01f};
+
+	/** How many times louder than the noise floor a window must be to count as speech when a noise floor is known */
+	float SpeechToNoiseRatio{2.0f};
+
+	/** How much speech (in seconds) must be heard before trailing silence can end the utterance */
+	float MinimumSpeechTime{0.3f};
+
+	/** How long (in seconds) the silence after speech must last for the utterance to end */
+	float SilenceTime{0.5f};
+};
+
+/**
+ * Streaming end of utterance detector. Audio is analysed in short 10ms windows so the end of speech is found quickly. Once enough
+ * speech has been heard, a run of silent windows long enough to not be a pause between words marks the end of the utterance. The
+ * end of utterance is latched until the endpointer is reset. Processing does not allocate
+ */
+class FVoiceEndpointer final
+{
+public:
+
+	/**
+	 * Configure the endpointer. This resets any detection state
+	 *
+	 * @param InSampleRate [in] the sample rate of the audio that will be processed
+	 * @param InSettings [in] the settings to use
+	 */
+	void Configure(const int32 InSampleRate, const FVoiceEndpointerSettings& InSettings);
+
+	/**
+	 * Reset the detection state ready for a new utterance
+	 */
+	void Reset();
+
+	/**
+	 * Analyse a block of audio. Blocks can be any size, windows are carried over between calls
+	 *
+	 * @param Samples [in] the 16-bit little endian mono samples
+	 * @param NumSamples [in] the number of samples
+	 * @param NoiseFloor [in] the current background noise RMS energy (0 -> 1) if known, otherwise zero
+	 */
+	void Process(const uint8* Samples, const int32 NumSamples, const float NoiseFloor);
+
+	/**
+	 * Has the end of the utterance been detected?
+	 *
+	 * @return true if the utterance has ended
+	 */
+	bool IsEndOfUtterance() const
+	{
+		return bIsEndOfUtterance;
+	}
+
+	/**
+	 * Get how much speech (in seconds) has been heard since the last reset
+	 *
+	 * @return the speech duration
+	 */
+	float GetSpeechTime() const
+	{
+		return NumSpeechWindows * WindowTime;
+	}
+
+private:
+
+	/** The duration (in seconds) of a single analysis window */
+	static constexpr float WindowTime{0.01f};
+
+	/** Classify the completed window and update the utterance state */
+	void ProcessWindow(const float NoiseFloor);
+
+	/** The settings in use */
+	FVoiceEndpointerSettings Settings{};
+
+	/** The number of samples in an analysis window */
+	int32 WindowSize{160};
+
+	/** The number of speech windows needed before silence can end the utterance */
+	int32 NumMinimumSpeechWindows{30};
+
+	/** The number of consecutive silent windows that end the utterance */
+	int32 NumEndSilenceWindows{50};
+
+	/** The sum of the squared normalised samples in the current window */
+	double WindowSumOfSquares{0.0};
+
+	/** The number of samples in the current window */
+	int32 WindowNumSamples{0};
+
+	/** The number of speech windows since the last reset */
+	int32 NumSpeechWindows{0};
+
+	/** The number of consecutive silent windows since the last speech window */
+	int32 NumSilenceWindows{0};
+
+	/** Has the end of the utterance been detected? */
+	bool bIsEndOfUtterance{false};
+};
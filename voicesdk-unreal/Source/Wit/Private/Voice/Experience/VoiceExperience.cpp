@@ -7,6 +7,8 @@
 
 #include "Voice/Experience/VoiceExperience.h"
 #include "CoreMinimal.h"
+#include "Voice/Matcher/VoiceResponseDispatcher.h"
+#include "Wit/Utilities/WitExperienceRegistry.h"
 
 /**
  * Sets default values for this actor's properties
@@ -30,9 +32,46 @@ void AVoiceExperience::BeginPlay()
 		VoiceService->SetConfiguration(Configuration, bUseWebSocket);
 	}
 	
+	if (UWitExperienceRegistry* Registry = GetWorld()->GetSubsystem<UWitExperienceRegistry>())
+	{
+		Registry->RegisterExperience(this);
+	}
+
 	Super::BeginPlay();
 }
 
+/**
+ * Called when play ends. Unregisters from the experience registry
+ *
+ * @param EndPlayReason [in] why play ended
+ */
+void AVoiceExperience::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWitExperienceRegistry* Registry = GetWorld()->GetSubsystem<UWitExperienceRegistry>())
+	{
+		Registry->UnregisterExperience(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * Get the dispatcher that delivers the responses of this experience to its matchers. Matchers can begin play before the experience so
+ * it is created on first use rather than in BeginPlay
+ *
+ * @return the dispatcher
+ */
+UVoiceResponseDispatcher* AVoiceExperience::GetResponseDispatcher()
+{
+	if (ResponseDispatcher == nullptr && VoiceEvents != nullptr)
+	{
+		ResponseDispatcher = NewObject<UVoiceResponseDispatcher>(this);
+		ResponseDispatcher->Initialize(VoiceEvents);
+	}
+
+	return ResponseDispatcher;
+}
+
 /**
  * Starts receiving voice input from the microphone and begins streaming it to for interpretation
  *
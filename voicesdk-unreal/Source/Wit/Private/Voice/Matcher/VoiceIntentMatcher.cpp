@@ -56,3 +56,19 @@ void UVoiceIntentMatcher::OnWitResponse(const bool bIsSuccessful, const FWitResp
 
 	AcceptPartialResponse(Response);
 }
+
+/**
+ * Get the intent a response must have as its top intent for this matcher to act on it. The intent is always required
+ *
+ * @param OutIntentName [out] the name of the required intent
+ * @param OutConfidenceThreshold [out] the confidence the intent must exceed
+ *
+ * @return true if an intent is required, false if the matcher acts on every response
+ */
+bool UVoiceIntentMatcher::GetRequiredIntent(FString& OutIntentName, float& OutConfidenceThreshold) const
+{
+	OutIntentName = IntentName;
+	OutConfidenceThreshold = IntentConfidenceThreshold;
+
+	return true;
+}
@@ -135,3 +135,19 @@ void UVoiceIntentWithEntitiesForFullResultMatcher::OnWitResponse(const bool bIsS
 		}
 	}
 }
+
+/**
+ * Get the intent a response must have as its top intent for this matcher to act on it. The intent is only required if bIsIntentRequired is set
+ *
+ * @param OutIntentName [out] the name of the required intent
+ * @param OutConfidenceThreshold [out] the confidence the intent must exceed
+ *
+ * @return true if an intent is required, false if the matcher acts on every response
+ */
+bool UVoiceIntentWithEntitiesForFullResultMatcher::GetRequiredIntent(FString& OutIntentName, float& OutConfidenceThreshold) const
+{
+	OutIntentName = IntentName;
+	OutConfidenceThreshold = IntentConfidenceThreshold;
+
+	return bIsIntentRequired;
+}
@@ -77,3 +77,19 @@ void UVoiceIntentWithEntityMatcher::OnWitResponse(const bool bIsSuccessful, cons
 		AcceptPartialResponse(Response);
 	}
 }
+
+/**
+ * Get the intent a response must have as its top intent for this matcher to act on it. The intent is only required if bIsIntentRequired is set
+ *
+ * @param OutIntentName [out] the name of the required intent
+ * @param OutConfidenceThreshold [out] the confidence the intent must exceed
+ *
+ * @return true if an intent is required, false if the matcher acts on every response
+ */
+bool UVoiceIntentWithEntityMatcher::GetRequiredIntent(FString& OutIntentName, float& OutConfidenceThreshold) const
+{
+	OutIntentName = IntentName;
+	OutConfidenceThreshold = IntentConfidenceThreshold;
+
+	return bIsIntentRequired;
+}
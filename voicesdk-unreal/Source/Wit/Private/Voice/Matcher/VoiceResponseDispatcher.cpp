@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Voice/Matcher/VoiceResponseDispatcher.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Voice/Events/VoiceEvents.h"
+#include "Voice/Matcher/VoiceResponseMatcher.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * Remove every entry
+ */
+void FVoiceResponseDispatchTable::Reset()
+{
+	IntentEntries.Reset();
+	UnconditionalEntries.Reset();
+}
+
+/**
+ * Add the candidate matchers for a response. Only the top intent of a response is ever matched so a single lookup finds every matcher
+ * that requires an intent and the sorted thresholds mean we stop at the first matcher whose threshold is not exceeded
+ *
+ * @param Response [in] the response to find candidates for
+ * @param OutCandidates [out] the matchers that can act on the response
+ */
+void FVoiceResponseDispatchTable::GetCandidates(const FWitResponse& Response, TArray<UVoiceResponseMatcher*, TInlineAllocator<16>>& OutCandidates) const
+{
+	for (const FVoiceResponseDispatchEntry& Entry : UnconditionalEntries)
+	{
+		if (UVoiceResponseMatcher* Matcher = Entry.Matcher.Get())
+		{
+			OutCandidates.Add(Matcher);
+		}
+	}
+
+	const bool bIsNoIntent = Response.Intents.Num() == 0;
+	if (bIsNoIntent)
+	{
+		return;
+	}
+
+	const FWitIntent& TopIntent = Response.Intents[0];
+	const TArray<FVoiceResponseDispatchEntry>* Entries = IntentEntries.Find(TopIntent.Name);
+
+	if (Entries == nullptr)
+	{
+		return;
+	}
+
+	for (const FVoiceResponseDispatchEntry& Entry : *Entries)
+	{
+		if (TopIntent.Confidence <= Entry.IntentConfidenceThreshold)
+		{
+			break;
+		}
+
+		// Map keys are case insensitive but intent matching is not
+
+		if (!Entry.IntentName.Equals(TopIntent.Name))
+		{
+			continue;
+		}
+
+		if (UVoiceResponseMatcher* Matcher = Entry.Matcher.Get())
+		{
+			OutCandidates.Add(Matcher);
+		}
+	}
+}
+
+/**
+ * Start listening for the responses of a voice experience
+ *
+ * @param VoiceEvents [in] the events of the voice experience
+ */
+void UVoiceResponseDispatcher::Initialize(UVoiceEvents* VoiceEvents)
+{
+	if (VoiceEvents == nullptr)
+	{
+		return;
+	}
+
+	VoiceEvents->OnWitResponse.AddUniqueDynamic(this, &UVoiceResponseDispatcher::OnWitResponse);
+	VoiceEvents->OnWitPartialResponse.AddUniqueDynamic(this, &UVoiceResponseDispatcher::OnWitPartialResponse);
+}
+
+/**
+ * Register a matcher to receive responses
+ *
+ * @param Matcher [in] the matcher to register
+ */
+void UVoiceResponseDispatcher::RegisterMatcher(UVoiceResponseMatcher* Matcher)
+{
+	if (Matcher == nullptr)
+	{
+		return;
+	}
+
+	Matchers.AddUnique(Matcher);
+	bIsDirty = true;
+
+	UE_LOG(LogWit, Verbose, TEXT("UVoiceResponseDispatcher: registered matcher (%s), (%d) matchers registered"), *Matcher->GetName(), Matchers.Num());
+}
+
+/**
+ * Stop a matcher receiving responses
+ *
+ * @param Matcher [in] the matcher to unregister
+ */
+void UVoiceResponseDispatcher::UnregisterMatcher(UVoiceResponseMatcher* Matcher)
+{
+	Matchers.Remove(Matcher);
+	bIsDirty = true;
+}
+
+/**
+ * Recompile the dispatch table before the next response
+ */
+void UVoiceResponseDispatcher::MarkDirty()
+{
+	bIsDirty = true;
+}
+
+/**
+ * Callback that is called when a full Wit.ai response is received
+ *
+ * @param bIsSuccessful [in] true if the response was successful
+ * @param Response [in] the full response as a UStruct
+ */
+void UVoiceResponseDispatcher::OnWitResponse(const bool bIsSuccessful, const FWitResponse& Response)
+{
+	Dispatch(ResponseTable, bIsSuccessful, Response);
+}
+
+/**
+ * Callback that is called when a partial Wit.ai response is received
+ *
+ * @param bIsSuccessful [in] true if the response was successful
+ * @param Response [in] the partial response as a UStruct
+ */
+void UVoiceResponseDispatcher::OnWitPartialResponse(const bool bIsSuccessful, const FWitResponse& Response)
+{
+	Dispatch(PartialResponseTable, bIsSuccessful, Response);
+}
+
+/**
+ * Compile the registered matchers into the dispatch tables. Matchers that have been destroyed are dropped
+ */
+void UVoiceResponseDispatcher::Compile()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVoiceResponseDispatcher::Compile);
+
+	ResponseTable.Reset();
+	PartialResponseTable.Reset();
+
+	Matchers.RemoveAll([](const TWeakObjectPtr<UVoiceResponseMatcher>& Matcher)
+	{
+		return !Matcher.IsValid();
+	});
+
+	for (const TWeakObjectPtr<UVoiceResponseMatcher>& Matcher : Matchers)
+	{
+		FVoiceResponseDispatchEntry Entry{};
+		Entry.Matcher = Matcher;
+
+		const bool bIsIntentRequired = Matcher->GetRequiredIntent(Entry.IntentName, Entry.IntentConfidenceThreshold);
+
+		if (bIsIntentRequired)
+		{
+			ResponseTable.IntentEntries.FindOrAdd(Entry.IntentName).Add(Entry);
+		}
+		else
+		{
+			ResponseTable.UnconditionalEntries.Add(Entry);
+		}
+
+		if (!Matcher->bIsAlsoUsedForPartialResponse)
+		{
+			continue;
+		}
+
+		if (bIsIntentRequired)
+		{
+			PartialResponseTable.IntentEntries.FindOrAdd(Entry.IntentName).Add(Entry);
+		}
+		else
+		{
+			PartialResponseTable.UnconditionalEntries.Add(Entry);
+		}
+	}
+
+	// Sorting by threshold lets a lookup stop at the first matcher the intent confidence does not exceed. The sort is stable so matchers
+	// with the same threshold keep their registration order
+
+	const auto SortByThreshold = [](const FVoiceResponseDispatchEntry& A, const FVoiceResponseDispatchEntry& B)
+	{
+		return A.IntentConfidenceThreshold < B.IntentConfidenceThreshold;
+	};
+
+	for (TPair<FString, TArray<FVoiceResponseDispatchEntry>>& Entries : ResponseTable.IntentEntries)
+	{
+		Entries.Value.StableSort(SortByThreshold);
+	}
+
+	for (TPair<FString, TArray<FVoiceResponseDispatchEntry>>& Entries : PartialResponseTable.IntentEntries)
+	{
+		Entries.Value.StableSort(SortByThreshold);
+	}
+
+	bIsDirty = false;
+
+	UE_LOG(LogWit, Verbose, TEXT("UVoiceResponseDispatcher: compiled (%d) matchers into (%d) intents"), Matchers.Num(), ResponseTable.IntentEntries.Num());
+}
+
+/**
+ * Dispatch a response to the matchers that can act on it. The candidates are gathered before any matcher is called because accepting
+ * a partial response dispatches the final response from inside the call
+ *
+ * @param Table [in] the table to find candidates in
+ * @param bIsSuccessful [in] true if the response was successful
+ * @param Response [in] the response to dispatch
+ */
+void UVoiceResponseDispatcher::Dispatch(const FVoiceResponseDispatchTable& Table, const bool bIsSuccessful, const FWitResponse& Response)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVoiceResponseDispatcher::Dispatch);
+
+	// Matchers ignore unsuccessful responses so there is nothing to dispatch
+
+	if (!bIsSuccessful)
+	{
+		return;
+	}
+
+	if (bIsDirty)
+	{
+		Compile();
+	}
+
+	TArray<UVoiceResponseMatcher*, TInlineAllocator<16>> Candidates;
+
+	Table.GetCandidates(Response, Candidates);
+
+	UE_LOG(LogWit, Verbose, TEXT("UVoiceResponseDispatcher: dispatching response to (%d) of (%d) matchers"), Candidates.Num(), Matchers.Num());
+
+	for (UVoiceResponseMatcher* Matcher : Candidates)
+	{
+		if (IsValid(Matcher))
+		{
+			Matcher->OnWitResponse(bIsSuccessful, Response);
+		}
+	}
+}
@@ -6,6 +6,7 @@
  */
 
 #include "Voice/Matcher/VoiceResponseMatcher.h"
+#include "Voice/Matcher/VoiceResponseDispatcher.h"
 #include "Wit/Utilities/WitHelperUtilities.h"
 #include "Wit/Utilities/WitLog.h"
 
@@ -19,31 +20,71 @@ UVoiceResponseMatcher::UVoiceResponseMatcher()
 }
 
 /**
- * Called when play is started. Registers with the UWitVoiceService so we receive a callback when a new response is received
+ * Called when play is started. Registers with the response dispatcher of the voice experience so we receive a callback when a new
+ * response is received that we could act on
  */
 void UVoiceResponseMatcher::BeginPlay()
 {
 	Super::BeginPlay();
 
-	const AVoiceExperience* VoiceExperience = FWitHelperUtilities::FindVoiceExperience(GetWorld(), VoiceExperienceTag);
+	AVoiceExperience* VoiceExperience = FWitHelperUtilities::FindVoiceExperience(GetWorld(), VoiceExperienceTag);
 	
 	if (VoiceExperience == nullptr)
 	{
 		return;
 	}
-	
-	if (VoiceExperience->VoiceEvents == nullptr)
+
+	UVoiceResponseDispatcher* Dispatcher = VoiceExperience->GetResponseDispatcher();
+
+	if (Dispatcher == nullptr)
 	{
 		return;
 	}
 
 	UE_LOG(LogWit, Verbose, TEXT("UVoiceResponseMatcher: Registering response callback"));
 
-	VoiceExperience->VoiceEvents->OnWitResponse.AddUniqueDynamic(this, &UVoiceResponseMatcher::OnWitResponse);
-		
-	if (bIsAlsoUsedForPartialResponse)
+	Dispatcher->RegisterMatcher(this);
+	ResponseDispatcher = Dispatcher;
+}
+
+/**
+ * Called when play ends. Unregisters from the response dispatcher
+ *
+ * @param EndPlayReason [in] why play ended
+ */
+void UVoiceResponseMatcher::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UVoiceResponseDispatcher* Dispatcher = ResponseDispatcher.Get())
+	{
+		Dispatcher->UnregisterMatcher(this);
+	}
+
+	ResponseDispatcher.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * Get the intent a response must have as its top intent for this matcher to act on it. The base matcher acts on every response
+ *
+ * @param OutIntentName [out] the name of the required intent
+ * @param OutConfidenceThreshold [out] the confidence the intent must exceed
+ *
+ * @return true if an intent is required, false if the matcher acts on every response
+ */
+bool UVoiceResponseMatcher::GetRequiredIntent(FString& OutIntentName, float& OutConfidenceThreshold) const
+{
+	return false;
+}
+
+/**
+ * Call this after changing the match criteria of the matcher while playing so that responses are dispatched using the new settings
+ */
+void UVoiceResponseMatcher::RefreshMatchCriteria()
+{
+	if (UVoiceResponseDispatcher* Dispatcher = ResponseDispatcher.Get())
 	{
-		VoiceExperience->VoiceEvents->OnWitPartialResponse.AddUniqueDynamic(this, &UVoiceResponseMatcher::OnWitResponse);
+		Dispatcher->MarkDirty();
 	}
 }
 
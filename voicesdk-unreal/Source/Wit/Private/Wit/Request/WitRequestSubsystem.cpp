@@ -6,18 +6,51 @@
  */
 
 #include "Wit/Request/WitRequestSubsystem.h"
+#include "Algo/BinarySearch.h"
 #include "Wit/Utilities/WitLog.h"
+#include "Wit/Configuration/WitAppConfiguration.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "Dom/JsonObject.h"
 #include "Wit/Request/HTTP/WitHttpRequest.h"
+#include "Wit/Request/WitRequestBuilder.h"
+#include "Wit/Request/WitResponseChunkParser.h"
+#include "Wit/Request/WitResponseDecoder.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Wit"), STATGROUP_Wit, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Response Storage Allocations"), STAT_WitResponseStorageAllocations, STATGROUP_Wit);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Request Response Storage Allocations"), STAT_WitLastRequestResponseStorageAllocations, STATGROUP_Wit);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Request Decoded Responses"), STAT_WitLastRequestDecodedResponses, STATGROUP_Wit);
+
+/**
+ * Destructor. The response storage is released in one go with the request so this is where its allocations for the whole request are
+ * reported
+ */
+FWitRequestState::~FWitRequestState()
+{
+	const int32 NumDecodes = ResponseStorage.GetNumDecodes();
+
+	if (NumDecodes == 0)
+	{
+		return;
+	}
+
+	const uint32 NumAllocations = static_cast<uint32>(ResponseStorage.GetNumAllocations());
+
+	INC_DWORD_STAT_BY(STAT_WitResponseStorageAllocations, NumAllocations);
+	SET_DWORD_STAT(STAT_WitLastRequestResponseStorageAllocations, NumAllocations);
+	SET_DWORD_STAT(STAT_WitLastRequestDecodedResponses, NumDecodes);
+
+	UE_LOG(LogWit, Verbose, TEXT("FWitRequestState: request decoded (%d) responses with (%u) response storage allocations"), NumDecodes, NumAllocations);
+}
 
 /**
  * Initialize the subsystem. USubsystem override
  */
 void UWitRequestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
-	MemoryReader = MakeShared<FMemoryReader, ESPMode::ThreadSafe>(ContentStream);
+	ApplyConfiguration(FWitAppAdvancedConfiguration{});
 }
 
 /**
@@ -25,77 +58,196 @@ void UWitRequestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
  */
 void UWitRequestSubsystem::Deinitialize()
 {
-	
+	// Drop the queue first so cancelling the active requests does not start the queued ones only to cancel them straight away
+
+	for (const TSharedPtr<FWitRequestState>& QueuedRequest : QueuedRequests)
+	{
+		QueuedRequest->bIsQueued = false;
+	}
+
+	QueuedRequests.Empty();
+
+	TArray<FWitRequestHandle> Handles;
+	Requests.GetKeys(Handles);
+
+	for (const FWitRequestHandle& Handle : Handles)
+	{
+		CancelRequest(Handle);
+	}
 }
 
 /**
- * Start a Wit.ai request. Depending on the request endpoint this may be a streaming request or not. Only
- * the /speech endpoint supports streaming. This should always be paired with a call to EndStreamRequest
+ * Start a Wit.ai request. The body is buffered as it is written and the request is sent (or queued if no slot is free) when
+ * EndStreamRequest is called. This should always be paired with a call to EndStreamRequest
  *
  * @param RequestConfiguration [in] the configuration to use to setup the request
+ * @return the handle used to refer to the request in further calls
  */
-void UWitRequestSubsystem::BeginStreamRequest(const FWitRequestConfiguration& RequestConfiguration)
+FWitRequestHandle UWitRequestSubsystem::BeginStreamRequest(const FWitRequestConfiguration& RequestConfiguration)
 {
-	if (IsRequestInProgress())
+	const TSharedRef<FWitRequestState> Request = MakeShared<FWitRequestState>();
+
+	Request->Handle = FWitRequestHandle(NextHandleId++);
+	Request->Configuration = RequestConfiguration;
+
+	// Guard against the id wrapping round to the invalid handle
+
+	if (NextHandleId == 0)
 	{
-		UE_LOG(LogWit, Warning, TEXT("BeginRequest: Attempting to begin request when one is already in progress"));
-		return;
+		NextHandleId = 1;
 	}
 
-	ContentStream.Reset();
-	
-	MemoryReader->Reset();
-	MemoryReader->Seek(0);
+	Requests.Add(Request->Handle, Request);
 
-	Configuration = RequestConfiguration;
-	LastResponseSize = 0;
-	bHasConfiguration = true;
+	// The UE HTTP layer reads the whole body as soon as the request starts and cannot wait for more so we buffer everything
+	// until the request is ended
 
-	bIsRequestStreaming = RequestConfiguration.bShouldUseChunkedTransfer;
-
-	// With the new implementation, we no longer send the request immediately for streaming.
-	// Instead, we wait for EndStreamRequest to be called, which happens after all audio is captured.
+	return Request->Handle;
 }
 
 /**
  * Finish a Wit.ai request. In the case of a streaming request this should be called when there is no more
  * data to send. In the case of one shot requests it can be called immediately after BeginStreamRequest
+ *
+ * @param Handle [in] the request to finish
+ */
+void UWitRequestSubsystem::EndStreamRequest(const FWitRequestHandle& Handle)
+{
+	const TSharedPtr<FWitRequestState> Request = FindRequest(Handle);
+
+	if (!Request.IsValid())
+	{
+		UE_LOG(LogWit, Warning, TEXT("EndStreamRequest: Attempting to end a request that is not in progress"));
+		return;
+	}
+
+	const bool bIsAlreadySubmitted = Request->bIsQueued || Request->HttpRequest.IsValid();
+
+	if (bIsAlreadySubmitted)
+	{
+		UE_LOG(LogWit, Warning, TEXT("EndStreamRequest: Attempting to end a request that has already been sent"));
+		return;
+	}
+
+	SubmitRequest(Request.ToSharedRef());
+}
+
+/**
+ * Find the state for a request
+ *
+ * @param Handle [in] the request to find
+ * @return the request state or null if the request is not in progress
  */
-void UWitRequestSubsystem::EndStreamRequest()
+TSharedPtr<FWitRequestState> UWitRequestSubsystem::FindRequest(const FWitRequestHandle& Handle) const
 {
-	MemoryReader->Close();
+	const TSharedPtr<FWitRequestState>* Request = Requests.Find(Handle);
 
-	if (bIsRequestStreaming)
+	if (Request == nullptr)
 	{
-		bIsRequestStreaming = false;
+		return nullptr;
 	}
-	
-	SendRequest();
+
+	return *Request;
 }
 
 /**
- * Actually sends the HTTP request
+ * Send the request if a slot is free otherwise add it to the queue. Queued requests are kept ordered by priority and then by the order
+ * they were submitted so requests of the same priority are sent in order
+ *
+ * @param Request [in] the request to submit
  */
-void UWitRequestSubsystem::SendRequest()
+void UWitRequestSubsystem::SubmitRequest(const TSharedRef<FWitRequestState>& Request)
 {
-	if (IsRequestInProgress())
+	if (CanSendRequest(Request->Configuration.Endpoint))
 	{
-		UE_LOG(LogWit, Warning, TEXT("SendRequest: Attempting to process request when one is already in progress"));
+		SendRequest(Request);
 		return;
 	}
 
-	if (!bHasConfiguration)
+	UE_LOG(LogWit, Verbose, TEXT("SubmitRequest: No free slot for endpoint (%s), queueing request with priority (%d)"), *Request->Configuration.Endpoint, Request->Configuration.Priority);
+
+	Request->bIsQueued = true;
+
+	const int32 InsertIndex = Algo::UpperBoundBy(QueuedRequests, Request->Configuration.Priority, [](const TSharedPtr<FWitRequestState>& QueuedRequest)
 	{
-		UE_LOG(LogWit, Warning, TEXT("SendRequest: No configuration has been specified for the request"));
-		return;
+		return QueuedRequest->Configuration.Priority;
+	}, TGreater<int32>());
+
+	QueuedRequests.Insert(Request, InsertIndex);
+}
+
+/**
+ * Send as many queued requests as there are free slots for. A request that is blocked by its endpoint limit does not prevent lower
+ * priority requests to other endpoints from being sent
+ */
+void UWitRequestSubsystem::SendQueuedRequests()
+{
+	for (int32 QueueIndex = 0; QueueIndex < QueuedRequests.Num() && GetNumActiveRequests() < MaxConcurrentRequests;)
+	{
+		const TSharedPtr<FWitRequestState> Request = QueuedRequests[QueueIndex];
+
+		if (!CanSendRequest(Request->Configuration.Endpoint))
+		{
+			++QueueIndex;
+			continue;
+		}
+
+		QueuedRequests.RemoveAt(QueueIndex);
+		Request->bIsQueued = false;
+
+		SendRequest(Request.ToSharedRef());
+	}
+}
+
+/**
+ * Is there a free slot to send a request to the given endpoint?
+ *
+ * @param Endpoint [in] the endpoint of the request
+ * @return true if the request can be sent
+ */
+bool UWitRequestSubsystem::CanSendRequest(const FString& Endpoint) const
+{
+	int32 NumActiveRequests = 0;
+	int32 NumActiveEndpointRequests = 0;
+
+	for (const TPair<FWitRequestHandle, TSharedPtr<FWitRequestState>>& RequestPair : Requests)
+	{
+		if (RequestPair.Value->HttpRequest.IsValid())
+		{
+			++NumActiveRequests;
+
+			if (RequestPair.Value->Configuration.Endpoint == Endpoint)
+			{
+				++NumActiveEndpointRequests;
+			}
+		}
 	}
 
+	if (NumActiveRequests >= MaxConcurrentRequests)
+	{
+		return false;
+	}
+
+	const int32* MaxEndpointRequests = MaxConcurrentRequestsPerEndpoint.Find(Endpoint);
+
+	return MaxEndpointRequests == nullptr || NumActiveEndpointRequests < *MaxEndpointRequests;
+}
+
+/**
+ * Actually sends the HTTP request
+ *
+ * @param Request [in] the request to send
+ */
+void UWitRequestSubsystem::SendRequest(const TSharedRef<FWitRequestState>& Request)
+{
+	const FWitRequestConfiguration& Configuration = Request->Configuration;
+
 	// Create our custom request wrapper. This allows us to add custom logic and headers
 
-	HttpRequest = MakeShared<FWitHttpRequest>();
+	const FHttpRequestPtr HttpRequest = MakeShared<FWitHttpRequest>();
 
 	// Construct the final URL for the request
-	
+
 	FString Url = FString::Format(TEXT("{0}/{1}"), { Configuration.BaseUrl, Configuration.Endpoint });
 
 	const bool bIsVersionParameter = !Configuration.Version.IsEmpty();
@@ -105,7 +257,7 @@ void UWitRequestSubsystem::SendRequest()
 	{
 		Url.Append("?");
 	}
-	
+
 	if (bIsVersionParameter)
 	{
 		Url.Append(TEXT("v="));
@@ -122,7 +274,7 @@ void UWitRequestSubsystem::SendRequest()
 	HttpRequest->SetVerb(Configuration.Verb);
 
 	// Add headers. This varies per endpoint but all requests require the Authorization header
-	
+
 	const FString Authorization = FString::Format(TEXT("Bearer {0}"), { Configuration.AuthToken });
 
 	HttpRequest->SetHeader("Authorization", Authorization);
@@ -132,10 +284,10 @@ void UWitRequestSubsystem::SendRequest()
 	{
 		HttpRequest->SetHeader("Accept", Configuration.Accept);
 	}
-	
+
 	FString ContentType;
 	bool bIsSeparatorRequired = false;
-	
+
 	for (const TPair<FString, FString >& ContentTypePair : Configuration.ContentTypes)
 	{
 		if (bIsSeparatorRequired)
@@ -146,36 +298,35 @@ void UWitRequestSubsystem::SendRequest()
 		{
 			bIsSeparatorRequired = true;
 		}
-		
+
 		ContentType.Append(ContentTypePair.Key);
-		ContentType.Append(ContentTypePair.Value);		
+		ContentType.Append(ContentTypePair.Value);
 	}
 
 	if (!ContentType.IsEmpty())
 	{
 		HttpRequest->SetHeader("Content-Type", ContentType);
 	}
-	
+
 	if (Configuration.bShouldUseChunkedTransfer)
 	{
 		HttpRequest->SetHeader("Transfer-Encoding", TEXT("chunked"));
 	}
 
-	// Add body content. With the new implementation, we always set the content directly. The old streaming
-	// implementation is no longer supported by the public HTTP interface.
+	// Add the buffered body content
 
-	if (Configuration.bShouldUseChunkedTransfer || ContentStream.Num() > 0)
+	if (Request->ContentStream.Num() > 0)
 	{
-		static_cast<FWitHttpRequest*>(HttpRequest.Get())->SetContentFromStream(MemoryReader.ToSharedRef());
+		HttpRequest->SetContent(MoveTemp(Request->ContentStream));
 	}
 
-	// Setup callbacks to inform of request progress and request completion
+	// Setup callbacks to inform of request progress and request completion. The handle lets us find the matching request state
 #if UE_VERSION_OLDER_THAN(5, 4, 0)
-	HttpRequest->OnRequestProgress().BindUObject(this, &UWitRequestSubsystem::OnRequestProgress);
+	HttpRequest->OnRequestProgress().BindUObject(this, &UWitRequestSubsystem::OnRequestProgress, Request->Handle);
 #else
-	HttpRequest->OnRequestProgress64().BindUObject(this, &UWitRequestSubsystem::OnRequestProgress);
+	HttpRequest->OnRequestProgress64().BindUObject(this, &UWitRequestSubsystem::OnRequestProgress, Request->Handle);
 #endif
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UWitRequestSubsystem::OnRequestComplete);
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UWitRequestSubsystem::OnRequestComplete, Request->Handle);
 
 	// Set custom timeout
 
@@ -183,38 +334,47 @@ void UWitRequestSubsystem::SendRequest()
 	{
 		UE_LOG(LogWit, Verbose, TEXT("SendRequest: Setting custom timeout to (%f)"), Configuration.HttpTimeout);
 
-		HttpRequest->SetTimeout(Configuration.HttpTimeout);	
+		HttpRequest->SetTimeout(Configuration.HttpTimeout);
 	}
 
 	// Finally send off the request
-	
-	if (HttpRequest != nullptr)
-	{
-		HttpRequest->ProcessRequest();
 
-		UE_LOG(LogWit, Verbose, TEXT("SendRequest: Url is (%s), Content type is (%s) and Content length is (%d)"), *HttpRequest->GetURL(), *HttpRequest->GetHeader("Content-Type"), ContentStream.Num());
-	}
-	else
+	Request->HttpRequest = HttpRequest;
+
+	const bool bIsProcessing = HttpRequest->ProcessRequest();
+	if (!bIsProcessing)
 	{
-		UE_LOG(LogWit, Warning, TEXT("SendRequest: failed"));
+		FailRequest(Request->Handle, TEXT("Request failed to start"), TEXT("The HTTP request could not be started"));
+		return;
 	}
+
+	UE_LOG(LogWit, Verbose, TEXT("SendRequest: Url is (%s), Content type is (%s), Content length is (%llu) and Chunked is (%d)"), *HttpRequest->GetURL(), *HttpRequest->GetHeader("Content-Type"), HttpRequest->GetContentLength(), Configuration.bShouldUseChunkedTransfer);
 }
 
 /**
  * Writes the given data to the internal stream that the request is using
  *
+ * @param Handle [in] the request to write to
  * @param Data [in] the content to add to the stream buffer
  */
-void UWitRequestSubsystem::WriteBinaryData(const TArray<uint8>& Data)
+void UWitRequestSubsystem::WriteBinaryData(const FWitRequestHandle& Handle, const TArray<uint8>& Data)
 {
 	const int32 NumBytesToCopy = Data.Num();
-	
+
 	if (NumBytesToCopy <= 0)
 	{
 		return;
 	}
 
-	UE_LOG(LogWit, Verbose, TEXT("WriteBinaryData: Old reader size is (%lld)"), MemoryReader->TotalSize());
+	const TSharedPtr<FWitRequestState> Request = FindRequest(Handle);
+
+	if (!Request.IsValid())
+	{
+		UE_LOG(LogWit, Warning, TEXT("WriteBinaryData: Attempting to write to a request that is not in progress"));
+		return;
+	}
+
+	TArray<uint8>& ContentStream = Request->ContentStream;
 
 	const int32 Offset = ContentStream.AddUninitialized(NumBytesToCopy);
 	const uint8* CopyFrom = Data.GetData();
@@ -222,25 +382,34 @@ void UWitRequestSubsystem::WriteBinaryData(const TArray<uint8>& Data)
 
 	FMemory::Memcpy(CopyTo, CopyFrom, NumBytesToCopy);
 
-	UE_LOG(LogWit, Verbose, TEXT("WriteBinaryData: Wrote (%d) bytes. New array size is (%d) New reader size is (%lld)"), NumBytesToCopy, ContentStream.Num(), MemoryReader->TotalSize());
+	UE_LOG(LogWit, Verbose, TEXT("WriteBinaryData: Wrote (%d) bytes. New array size is (%d)"), NumBytesToCopy, ContentStream.Num());
 }
 
 /**
  * Writes the given data to the internal stream that the request is using
  *
+ * @param Handle [in] the request to write to
  * @param Data [in] the content to add to the stream buffer
  */
-void UWitRequestSubsystem::WriteJsonData(const TSharedRef<FJsonObject> Data)
+void UWitRequestSubsystem::WriteJsonData(const FWitRequestHandle& Handle, const TSharedRef<FJsonObject> Data)
 {
+	const TSharedPtr<FWitRequestState> Request = FindRequest(Handle);
+
+	if (!Request.IsValid())
+	{
+		UE_LOG(LogWit, Warning, TEXT("WriteJsonData: Attempting to write to a request that is not in progress"));
+		return;
+	}
+
 	// Stringify the Json object
-	
+
 	FString ContentString;
 	const TSharedRef<TJsonWriter<TCHAR>> Writer = TJsonWriterFactory<TCHAR>::Create(&ContentString);
-	
+
 	FJsonSerializer::Serialize(Data, Writer);
 
 	// Convert the string to UTF8 and copy in place
-	
+
 	const int32 NumBytesToCopy = FTCHARToUTF8_Convert::ConvertedLength(*ContentString, ContentString.Len());
 
 	if (NumBytesToCopy <= 0)
@@ -248,104 +417,260 @@ void UWitRequestSubsystem::WriteJsonData(const TSharedRef<FJsonObject> Data)
 		return;
 	}
 
-	UE_LOG(LogWit, Verbose, TEXT("WriteJsonData: Old reader size is (%lld)"), MemoryReader->TotalSize());
+	TArray<uint8>& ContentStream = Request->ContentStream;
 
 	const int32 Offset = ContentStream.AddUninitialized(NumBytesToCopy);
 	uint8* CopyTo = ContentStream.GetData() + Offset;
 
 	FTCHARToUTF8_Convert::Convert(reinterpret_cast<ANSICHAR*>(CopyTo), NumBytesToCopy, *ContentString, ContentString.Len());
 
-	UE_LOG(LogWit, Verbose, TEXT("WriteJsonData: Wrote (%d) bytes. New array size is (%d) New reader size is (%lld)"), NumBytesToCopy, ContentStream.Num(), MemoryReader->TotalSize());
+	UE_LOG(LogWit, Verbose, TEXT("WriteJsonData: Wrote (%d) bytes. New array size is (%d)"), NumBytesToCopy, ContentStream.Num());
 }
 
 /**
- * Cancels an inflight Wit.ai request
+ * Cancels an inflight or queued Wit.ai request. No further callbacks will be made for the request
+ *
+ * @param Handle [in] the request to cancel
  */
-void UWitRequestSubsystem::CancelRequest()
+void UWitRequestSubsystem::CancelRequest(const FWitRequestHandle& Handle)
 {
-	if (!IsRequestInProgress())
+	TSharedPtr<FWitRequestState> Request;
+
+	if (!Requests.RemoveAndCopyValue(Handle, Request))
 	{
 		return;
 	}
 
-	HttpRequest->CancelRequest();
-	HttpRequest = nullptr;
+	if (Request->bIsQueued)
+	{
+		QueuedRequests.Remove(Request);
+	}
+
+	if (Request->HttpRequest.IsValid())
+	{
+		Request->HttpRequest->CancelRequest();
+		Request->HttpRequest = nullptr;
+	}
+
+	SendQueuedRequests();
 }
 
 /**
- * Is a Wit.ai request currently in progress?
+ * Cancel a request and report the given error for it. The error is reported after the request is removed so the callback is free to
+ * start a new request
  *
- * @return true if a request is in progress
+ * @param Handle [in] the request to fail
+ * @param ErrorMessage [in] the error message
+ * @param HumanReadableErrorMessage [in] the human readable error message
  */
- 
-bool UWitRequestSubsystem::IsRequestInProgress() const
+void UWitRequestSubsystem::FailRequest(const FWitRequestHandle& Handle, const FString& ErrorMessage, const FString& HumanReadableErrorMessage)
 {
-	const bool bIsHttpRequestInProgress = HttpRequest.IsValid() && (HttpRequest->GetStatus() == EHttpRequestStatus::Processing);
-	return bIsHttpRequestInProgress || bIsRequestStreaming;
+	const TSharedPtr<FWitRequestState> Request = FindRequest(Handle);
+
+	if (!Request.IsValid())
+	{
+		return;
+	}
+
+	UE_LOG(LogWit, Warning, TEXT("FailRequest: request failed with error (%s)"), *ErrorMessage);
+
+	CancelRequest(Handle);
+
+	Request->Configuration.OnRequestError.Broadcast(ErrorMessage, HumanReadableErrorMessage);
+}
+
+/**
+ * Is a Wit.ai request currently in progress? This includes requests that are queued waiting to be sent
+ *
+ * @param Handle [in] the request to check
+ * @return true if the request is in progress
+ */
+bool UWitRequestSubsystem::IsRequestInProgress(const FWitRequestHandle& Handle) const
+{
+	return Requests.Contains(Handle);
+}
+
+/**
+ * Set the maximum number of requests that can be in flight at once across all endpoints
+ *
+ * @param MaxRequests [in] the maximum number of requests. Must be at least 1
+ */
+void UWitRequestSubsystem::SetMaxConcurrentRequests(const int32 MaxRequests)
+{
+	MaxConcurrentRequests = FMath::Max(MaxRequests, 1);
+
+	SendQueuedRequests();
+}
+
+/**
+ * Set the maximum number of requests that can be in flight at once for a specific endpoint
+ *
+ * @param Endpoint [in] the endpoint to limit
+ * @param MaxRequests [in] the maximum number of requests. A value of 0 or less removes the limit
+ */
+void UWitRequestSubsystem::SetMaxConcurrentRequestsForEndpoint(const EWitRequestEndpoint Endpoint, const int32 MaxRequests)
+{
+	const FString& EndpointString = FWitRequestBuilder::GetEndpointString(Endpoint);
+
+	if (MaxRequests > 0)
+	{
+		MaxConcurrentRequestsPerEndpoint.Add(EndpointString, MaxRequests);
+	}
+	else
+	{
+		MaxConcurrentRequestsPerEndpoint.Remove(EndpointString);
+	}
+
+	SendQueuedRequests();
+}
+
+/**
+ * Apply the request limits from an application configuration. This replaces any previously set limits
+ *
+ * @param Configuration [in] the advanced application configuration to take the limits from
+ */
+void UWitRequestSubsystem::ApplyConfiguration(const FWitAppAdvancedConfiguration& Configuration)
+{
+	MaxConcurrentRequestsPerEndpoint.Reset();
+
+	for (const TPair<EWitRequestEndpoint, int32>& EndpointLimit : Configuration.MaxConcurrentRequestsPerEndpoint)
+	{
+		SetMaxConcurrentRequestsForEndpoint(EndpointLimit.Key, EndpointLimit.Value);
+	}
+
+	SetMaxConcurrentRequests(Configuration.MaxConcurrentRequests);
+}
+
+/**
+ * Get the number of requests currently in flight
+ *
+ * @return the number of active requests
+ */
+int32 UWitRequestSubsystem::GetNumActiveRequests() const
+{
+	int32 NumActiveRequests = 0;
+
+	for (const TPair<FWitRequestHandle, TSharedPtr<FWitRequestState>>& RequestPair : Requests)
+	{
+		if (RequestPair.Value->HttpRequest.IsValid())
+		{
+			++NumActiveRequests;
+		}
+	}
+
+	return NumActiveRequests;
+}
+
+/**
+ * Get the number of requests currently waiting for a free slot
+ *
+ * @return the number of queued requests
+ */
+int32 UWitRequestSubsystem::GetNumQueuedRequests() const
+{
+	return QueuedRequests.Num();
 }
 
 /**
  * Called when an HTTP request is in progress to retrieve any changes to the response payload
  *
- * @param Request the in progress request
+ * @param HttpRequest the in progress request
  * @param BytesSent the amount of bytes that have so far been sent to server
  * @param BytesReceived the amount of bytes that have so far been received from server
+ * @param Handle the request the progress is for
  */
 #if UE_VERSION_OLDER_THAN(5, 4, 0)
-void UWitRequestSubsystem::OnRequestProgress(FHttpRequestPtr Request, int32 BytesSent, int32 BytesReceived)
+void UWitRequestSubsystem::OnRequestProgress(FHttpRequestPtr HttpRequest, int32 BytesSent, int32 BytesReceived, FWitRequestHandle Handle)
 #else
-void UWitRequestSubsystem::OnRequestProgress(FHttpRequestPtr Request, uint64 BytesSent, uint64 BytesReceived)
+void UWitRequestSubsystem::OnRequestProgress(FHttpRequestPtr HttpRequest, uint64 BytesSent, uint64 BytesReceived, FWitRequestHandle Handle)
 #endif
 
 {
-	if (!Configuration.OnRequestProgress.IsBound())
+	const TSharedPtr<FWitRequestState> Request = FindRequest(Handle);
+
+	if (!Request.IsValid())
+	{
+		return;
+	}
+
+	const bool bIsProgressBound = Request->Configuration.OnRequestProgress.IsBound();
+	const bool bIsResponseProgressBound = Request->Configuration.OnResponseProgress.IsBound();
+
+	if (!bIsProgressBound && !bIsResponseProgressBound)
 	{
-		return;	
+		return;
 	}
-	
-	    const FHttpResponsePtr Response = Request->GetResponse();
+
+	const FHttpResponsePtr Response = HttpRequest->GetResponse();
 	if (!Response.IsValid())
 	{
 		return;
 	}
-	
+
 	const TArray<uint8>& ContentAsBytes(Response->GetContent());
-	const bool bIsNewResponseData = ContentAsBytes.Num() != LastResponseSize;
+	const bool bIsNewResponseData = ContentAsBytes.Num() != Request->LastResponseSize;
 
 	if (!bIsNewResponseData)
 	{
 		UE_LOG(LogWit, Verbose, TEXT("OnRequestProgress: Ignoring response progress because size has not changed"));
-		return;	
+		return;
 	}
-	
-	const FString Url = Request->GetURL();
+
+	Request->LastResponseSize = ContentAsBytes.Num();
+
+	const FString Url = HttpRequest->GetURL();
 	if (Url.Contains("synthesize"))
 	{
-		Configuration.OnRequestProgress.Broadcast(ContentAsBytes, nullptr);
+		Request->Configuration.OnRequestProgress.Broadcast(ContentAsBytes, nullptr);
 		return;
 	}
 
 	UE_LOG(LogWit, Verbose, TEXT("OnRequestProgress: Content size (%d) bytes received (%d)"), ContentAsBytes.Num(), BytesReceived);
 
-	const FUTF8ToTCHAR ContentAsTChar(reinterpret_cast<const ANSICHAR*>(ContentAsBytes.GetData()), ContentAsBytes.Num());
-	const FString Content(ContentAsTChar.Length(), ContentAsTChar.Get());
+	// The speech endpoint returns chunked responses which contain multiple JSON objects. The most recently completed chunk represents the
+	// most recent response (at this time) while the other chunks are intermediate results that can be safely ignored. The parser only
+	// scans the bytes received since the last call so we never re-process the earlier part of the response
 
-	UE_LOG(LogWit, Verbose, TEXT("OnRequestProgress: Content as string (%s)"), *Content);
+	TArray<FWitResponseChunk> NewChunks;
 
-	// The speech endpoint returns chunked responses which contain multiple JSON objects. The final chunk represents the most recent response (at this time)
-	// while the other chunks are intermediate results that can be safely ignored
+	const bool bIsNewChunk = Request->ResponseParser.Parse(ContentAsBytes.GetData(), ContentAsBytes.Num(), NewChunks);
+	if (!bIsNewChunk)
+	{
+		return;
+	}
 
-	TArray<FString> ChunkedResponses;
+	const FString FinalResponse = FWitResponseChunkParser::GetChunkAsString(ContentAsBytes.GetData(), NewChunks.Last());
 
-	SplitResponseIntoChunks(Content, ChunkedResponses);
+	UE_LOG(LogWit, Verbose, TEXT("OnRequestProgress: Latest chunk as string (%s)"), *FinalResponse);
 
-	const bool bIsMalformedResponse = (ChunkedResponses.Num() == 0);
-	if (bIsMalformedResponse)
+	// Decoding straight into the response struct avoids building a JSON object tree for every partial response. The tree is only built
+	// if someone still wants the raw JSON
+
+	if (bIsResponseProgressBound)
 	{
-		return;
+		FWitResponseStorage& Storage = Request->ResponseStorage;
+		FWitResponseDecodeInfo DecodeInfo{};
+
+		const bool bIsValidPartialResponse = FWitResponseDecoder::Decode(FinalResponse, Storage, Request->Configuration.bShouldRecycleResponses, &DecodeInfo)
+			&& DecodeInfo.bHasText;
+
+		if (bIsValidPartialResponse)
+		{
+			Request->Configuration.OnResponseProgress.Broadcast(Storage.GetResponse(), DecodeInfo.bHasIntents);
+		}
+
+		// A listener may have accepted the partial response and cancelled the request so there is nothing more to report
+
+		if (!Requests.Contains(Handle))
+		{
+			return;
+		}
 	}
 
-	const FString FinalResponse{ChunkedResponses.Last()};
+	if (!bIsProgressBound)
+	{
+		return;
+	}
 
 	TSharedPtr<FJsonObject> Json = MakeShareable(new FJsonObject());
 	const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FinalResponse);
@@ -362,23 +687,36 @@ void UWitRequestSubsystem::OnRequestProgress(FHttpRequestPtr Request, uint64 Byt
 		return;
 	}
 
-	LastResponseSize = ContentAsBytes.Num();
-			
-	Configuration.OnRequestProgress.Broadcast(ContentAsBytes, Json);
+	Request->Configuration.OnRequestProgress.Broadcast(ContentAsBytes, Json);
 }
 
 /**
  * Called when an HTTP request is fully completed to process the response payload
  *
- * @param Request the completed request
+ * @param HttpRequest the completed request
  * @param Response the full and final response
  * @param bIsSuccessful whether the request successfully completed
+ * @param Handle the request that completed
  */
-void UWitRequestSubsystem::OnRequestComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bIsSuccessful)
+void UWitRequestSubsystem::OnRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr Response, bool bIsSuccessful, FWitRequestHandle Handle)
 {
-	bIsRequestStreaming = false;
-	HttpRequest = nullptr;
-	
+	// Requests that were cancelled will already have been removed so there is nothing to report
+
+	TSharedPtr<FWitRequestState> Request;
+
+	if (!Requests.RemoveAndCopyValue(Handle, Request))
+	{
+		return;
+	}
+
+	Request->HttpRequest = nullptr;
+
+	// Now the slot is free give any waiting requests a chance to go before we call out to user code which may start new requests
+
+	SendQueuedRequests();
+
+	const FWitRequestConfiguration& Configuration = Request->Configuration;
+
 	if (!bIsSuccessful)
 	{
 		if (Response)
@@ -391,31 +729,54 @@ void UWitRequestSubsystem::OnRequestComplete(FHttpRequestPtr Request, FHttpRespo
 		return;
 	}
 
-	const FString Content = Response->GetContentAsString();
 	const FString ContentType = Response->GetContentType();
 
 	const bool bIsJsonContentType = ContentType.Contains(TEXT("application/json"));
 	const bool bIsAudioContentType = ContentType.Contains(TEXT("audio/wav")) || ContentType.Contains(TEXT("audio/raw"));
 
-	UE_LOG(LogWit, Verbose, TEXT("OnRequestComplete: Content as string (%s)"), *Content);
+	UE_LOG(LogWit, Verbose, TEXT("OnRequestComplete: Content as string (%s)"), *Response->GetContentAsString());
 
 	if (bIsJsonContentType)
 	{
 		// The speech endpoint returns chunked responses which contain multiple JSON objects. The final chunk represents the final response to the
-		// entire request while the other chunks are intermediate results that can be safely ignored
+		// entire request while the other chunks are intermediate results that can be safely ignored. Any part of the response already scanned
+		// during progress updates is not scanned again
+
+		const TArray<uint8>& ContentAsBytes(Response->GetContent());
 
-		TArray<FString> ChunkedResponses;
+		TArray<FWitResponseChunk> NewChunks;
+		FWitResponseChunk FinalChunk;
 
-		SplitResponseIntoChunks(Content, ChunkedResponses);
+		Request->ResponseParser.Parse(ContentAsBytes.GetData(), ContentAsBytes.Num(), NewChunks);
 
-		const bool bIsMalformedResponse = (ChunkedResponses.Num() == 0);
+		const bool bIsMalformedResponse = !Request->ResponseParser.GetLastChunk(FinalChunk);
 		if (bIsMalformedResponse)
 		{
 			Configuration.OnRequestError.Broadcast(TEXT("Invalid response"), TEXT("Response is incomplete or otherwise invalid"));
 			return;
 		}
 
-		const FString FinalResponse{ChunkedResponses.Last()};
+		const FString FinalResponse = FWitResponseChunkParser::GetChunkAsString(ContentAsBytes.GetData(), FinalChunk);
+
+		if (Configuration.OnResponseComplete.IsBound())
+		{
+			FWitResponseStorage& Storage = Request->ResponseStorage;
+			FWitResponseDecodeInfo DecodeInfo{};
+
+			const bool bIsDecodeError = !FWitResponseDecoder::Decode(FinalResponse, Storage, Configuration.bShouldRecycleResponses, &DecodeInfo);
+			if (bIsDecodeError)
+			{
+				Configuration.OnRequestError.Broadcast(TEXT("Deserialization failed"), TEXT("Decoding the response failed"));
+				return;
+			}
+
+			Configuration.OnResponseComplete.Broadcast(Storage.GetResponse(), DecodeInfo.bHasIntents);
+		}
+
+		if (!Configuration.OnRequestComplete.IsBound())
+		{
+			return;
+		}
 
 		TSharedPtr<FJsonObject> Json = MakeShareable(new FJsonObject());
 		const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FinalResponse);
@@ -428,13 +789,13 @@ void UWitRequestSubsystem::OnRequestComplete(FHttpRequestPtr Request, FHttpRespo
 		}
 
 		UE_LOG(LogWit, Verbose, TEXT("OnRequestComplete: calling delegate"));
-		
+
 		Configuration.OnRequestComplete.Broadcast(Response->GetContent(), Json);
 	}
 	else if (bIsAudioContentType)
 	{
 		// The synthesize endpoint returns binary data in the form of a wav
-		
+
 		Configuration.OnRequestComplete.Broadcast(Response->GetContent(), nullptr);
 	}
 	else
@@ -442,55 +803,3 @@ void UWitRequestSubsystem::OnRequestComplete(FHttpRequestPtr Request, FHttpRespo
 		Configuration.OnRequestError.Broadcast(TEXT("Invalid content type"), TEXT("Response has invalid content type"));
 	}
 }
-
-/**
- * Splits a response JSON string into chunks as defined by the Wit.ai response format
- *
- * @param Response the string version of the response
- * @param ChunkedResponses the response broken down into brace delimited chunks
- */
-void UWitRequestSubsystem::SplitResponseIntoChunks(const FString& Response, TArray<FString>& ChunkedResponses)
-{
-	int32 StringIndex = 0;
-
-	ChunkedResponses.Reset();
-
-	// The speech endpoint implements chunked responses by using a JSON format that does not strictly conform to the JSON specification.
-	// Because of this UE4's JSON object converter cannot handle it without some preprocessing to break each chunk down into its own
-	// conforming chunk. See the Wit.ai documentation for the specifics of the response format; it consists of a sequence of brace
-	// delimited JSON objects
-
-	while (StringIndex < Response.Len())
-	{
-		const int32 OpeningBraceIndex = Response.Find(TEXT("{"), ESearchCase::IgnoreCase, ESearchDir::FromStart, StringIndex);
-
-		const bool bIsStartOfNewChunk = (OpeningBraceIndex != INDEX_NONE);
-		if (!bIsStartOfNewChunk)
-		{
-			return;
-		}
-
-		StringIndex = OpeningBraceIndex + 1;
-		int32 BraceCount = 1;
-
-		while (BraceCount > 0 && StringIndex < Response.Len())
-		{
-			if (Response[StringIndex] == L'{')
-			{
-				++BraceCount;
-			}
-			else if (Response[StringIndex] == L'}')
-			{
-				--BraceCount;
-			}
-
-			++StringIndex;
-		}
-
-		FString ChunkedResponseString{Response.Mid(OpeningBraceIndex, StringIndex - OpeningBraceIndex)};
-
-		ChunkedResponses.Add(ChunkedResponseString);
-
-		UE_LOG(LogWit, VeryVerbose, TEXT("Chunk string found (%s)"), *ChunkedResponseString);
-	}
-}
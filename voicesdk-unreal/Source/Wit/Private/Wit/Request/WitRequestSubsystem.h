@@ -11,18 +11,56 @@
 #include "Http.h"
 #include "Serialization/BufferArchive.h"
 #include "Wit/Request/WitRequestConfiguration.h"
+#include "Wit/Request/WitRequestTypes.h"
 #include "Subsystems/EngineSubsystem.h"
-#include "Serialization/MemoryReader.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Wit/Request/WitResponseChunkParser.h"
+#include "Wit/Request/WitResponseStorage.h"
 #include "WitRequestSubsystem.generated.h"
 
 class FJsonObject;
-class FMemoryReader;
+struct FWitAppAdvancedConfiguration;
 class FSubsystemCollectionBase;
 
 /**
- * A class to track an in progress Wit.ai request. It essentially wraps a UE4 HTTP request
- * while also providing a streaming read buffer
+ * The state of a single request tracked by the request subsystem
+ */
+struct FWitRequestState
+{
+	/**
+	 * Destructor. Reports the response storage statistics of the request
+	 */
+	~FWitRequestState();
+
+	/** The handle used to identify the request */
+	FWitRequestHandle Handle{};
+
+	/** The configuration the request was started with */
+	FWitRequestConfiguration Configuration{};
+
+	/** The underlying UE4 HTTP request. Only valid once the request has been sent */
+	FHttpRequestPtr HttpRequest{nullptr};
+
+	/** The raw content data that makes up the body of a POST request */
+	TArray<uint8> ContentStream{};
+
+	/** Incrementally splits the response into its JSON chunks as it arrives */
+	FWitResponseChunkParser ResponseParser{};
+
+	/** The storage responses to the request are decoded into. Released in one go when the request ends */
+	FWitResponseStorage ResponseStorage{};
+
+	/** The most recently received response length */
+	int32 LastResponseSize{0};
+
+	/** Is the request waiting for a free slot? */
+	bool bIsQueued{false};
+};
+
+/**
+ * Tracks all in progress Wit.ai requests. Each request is identified by a handle and essentially wraps a UE4 HTTP request while also
+ * providing a streaming write buffer. Multiple requests can be in flight at once up to a configurable limit, both overall and per
+ * endpoint. Requests that cannot be sent immediately wait in a priority ordered queue until a slot becomes free
  */
 UCLASS()
 class UWitRequestSubsystem final : public UEngineSubsystem
@@ -46,82 +84,134 @@ public:
 	virtual void Deinitialize() override;
 
 	/**
-	 * Start a Wit.ai request. Depending on the request endpoint this may be a streaming request or not. Only
-	 * the /speech endpoint supports streaming. This should always be paired with a call to EndStreamRequest
+	 * Start a Wit.ai request. The body is buffered as it is written and the request is sent (or queued if no slot is free)
+	 * when EndStreamRequest is called. This should always be paired with a call to EndStreamRequest
 	 *
 	 * @param RequestConfiguration [in] The configuration to use to setup the request
+	 * @return the handle used to refer to the request in further calls
 	 */
-	void BeginStreamRequest(const FWitRequestConfiguration& RequestConfiguration);
+	FWitRequestHandle BeginStreamRequest(const FWitRequestConfiguration& RequestConfiguration);
 
 	/**
 	 * Finish a Wit.ai request. In the case of a streaming request this should be called when there is no more
 	 * data to send. In the case of one shot requests it can be called immediately after BeginStreamRequest
+	 *
+	 * @param Handle [in] the request to finish
 	 */
-	void EndStreamRequest();
+	void EndStreamRequest(const FWitRequestHandle& Handle);
 
 	/**
-	 * Cancels an inflight Wit.ai request
+	 * Cancels an inflight or queued Wit.ai request. No further callbacks will be made for the request
+	 *
+	 * @param Handle [in] the request to cancel
 	 */
-	void CancelRequest();
+	void CancelRequest(const FWitRequestHandle& Handle);
 
 	/**
-	 * Is a Wit.ai request currently in progress?
+	 * Is a Wit.ai request currently in progress? This includes requests that are queued waiting to be sent
 	 *
-	 * @return true if a request is in progress
+	 * @param Handle [in] the request to check
+	 * @return true if the request is in progress
 	 */
-	bool IsRequestInProgress() const;
-
-	/** Is the request a streaming request? */
-	UPROPERTY(VisibleAnywhere, Category="Wit|Private")
-	bool bIsRequestStreaming{false};
+	bool IsRequestInProgress(const FWitRequestHandle& Handle) const;
 
 	/**
 	 * Writes the given binary data to the internal stream that the request is using
 	 *
+	 * @param Handle [in] the request to write to
 	 * @param Data [in] the content to add to the stream buffer
 	 */
-	void WriteBinaryData(const TArray<uint8>& Data);
+	void WriteBinaryData(const FWitRequestHandle& Handle, const TArray<uint8>& Data);
 
 	/**
 	 * Writes the given Json data to the internal stream that the request is using
 	 *
+	 * @param Handle [in] the request to write to
 	 * @param Data [in] the content to add to the stream buffer
 	 */
-	void WriteJsonData(const TSharedRef<FJsonObject> Data);
+	void WriteJsonData(const FWitRequestHandle& Handle, const TSharedRef<FJsonObject> Data);
+
+	/**
+	 * Set the maximum number of requests that can be in flight at once across all endpoints
+	 *
+	 * @param MaxRequests [in] the maximum number of requests. Must be at least 1
+	 */
+	void SetMaxConcurrentRequests(const int32 MaxRequests);
+
+	/**
+	 * Set the maximum number of requests that can be in flight at once for a specific endpoint
+	 *
+	 * @param Endpoint [in] the endpoint to limit
+	 * @param MaxRequests [in] the maximum number of requests. A value of 0 or less removes the limit
+	 */
+	void SetMaxConcurrentRequestsForEndpoint(const EWitRequestEndpoint Endpoint, const int32 MaxRequests);
+
+	/**
+	 * Apply the request limits from an application configuration. This replaces any previously set limits
+	 *
+	 * @param Configuration [in] the advanced application configuration to take the limits from
+	 */
+	void ApplyConfiguration(const FWitAppAdvancedConfiguration& Configuration);
+
+	/**
+	 * Get the number of requests currently in flight
+	 *
+	 * @return the number of active requests
+	 */
+	int32 GetNumActiveRequests() const;
+
+	/**
+	 * Get the number of requests currently waiting for a free slot
+	 *
+	 * @return the number of queued requests
+	 */
+	int32 GetNumQueuedRequests() const;
+
+	/** The default maximum number of requests that can be in flight at once */
+	static constexpr int32 DefaultMaxConcurrentRequests{4};
 
 private:
 
+	/** Find the state for a request */
+	TSharedPtr<FWitRequestState> FindRequest(const FWitRequestHandle& Handle) const;
+
+	/** Send the request if a slot is free otherwise add it to the queue */
+	void SubmitRequest(const TSharedRef<FWitRequestState>& Request);
+
+	/** Send as many queued requests as there are free slots for */
+	void SendQueuedRequests();
+
+	/** Is there a free slot to send a request to the given endpoint? */
+	bool CanSendRequest(const FString& Endpoint) const;
+
 	/** Actually sends the HTTP request */
-	void SendRequest();
+	void SendRequest(const TSharedRef<FWitRequestState>& Request);
+
+	/** Cancel a request and report the given error for it */
+	void FailRequest(const FWitRequestHandle& Handle, const FString& ErrorMessage, const FString& HumanReadableErrorMessage);
 
 	/** Called when an HTTP request is in progress to retrieve any changes to the response payload */
 #if UE_VERSION_OLDER_THAN(5, 4, 0)
-    void OnRequestProgress(FHttpRequestPtr Request, int32 BytesSent, int32 BytesReceived);
+    void OnRequestProgress(FHttpRequestPtr HttpRequest, int32 BytesSent, int32 BytesReceived, FWitRequestHandle Handle);
 #else
-    void OnRequestProgress(FHttpRequestPtr Request, uint64 BytesSent, uint64 BytesReceived);
+    void OnRequestProgress(FHttpRequestPtr HttpRequest, uint64 BytesSent, uint64 BytesReceived, FWitRequestHandle Handle);
 #endif
 
 	/** Called when an HTTP request is fully completed to process the response payload */
-	void OnRequestComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bIsSuccessful);
-	
-	/** Splits a response JSON string into chunks as defined by the Wit.ai response format */
-	static void SplitResponseIntoChunks(const FString& Response, TArray<FString>& ChunkedResponses);
+	void OnRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr Response, bool bIsSuccessful, FWitRequestHandle Handle);
 
-	/** Used to track if a configuration has been set or not */
-	bool bHasConfiguration{false};
+	/** All requests that are in progress, keyed by their handle */
+	TMap<FWitRequestHandle, TSharedPtr<FWitRequestState>> Requests{};
 
-	/** The current configuration setup */
-	FWitRequestConfiguration Configuration{};
+	/** Requests waiting for a free slot, ordered by priority and then by the order they were submitted */
+	TArray<TSharedPtr<FWitRequestState>> QueuedRequests{};
 
-	/** The underlying UE4 HTTP request that is used to process the Wit.ai request */
-	FHttpRequestPtr HttpRequest{nullptr};
+	/** The maximum number of requests that can be in flight at once */
+	int32 MaxConcurrentRequests{DefaultMaxConcurrentRequests};
 
-	/** The raw content data that makes up the body of a POST request */
-	TArray<uint8> ContentStream{};
+	/** Optional per endpoint limits on the number of requests that can be in flight at once */
+	TMap<FString, int32> MaxConcurrentRequestsPerEndpoint{};
 
-	/** Wraps the ContentStream to provide an FArchive interface for a streaming Wit.ai request */
-	TSharedPtr<FMemoryReader, ESPMode::ThreadSafe> MemoryReader{};
-
-	/** The most recently received response length */
-	int32 LastResponseSize{0};
+	/** Used to generate unique request handles */
+	uint32 NextHandleId{1};
 };
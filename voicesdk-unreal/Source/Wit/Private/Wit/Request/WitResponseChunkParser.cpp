@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Wit/Request/WitResponseChunkParser.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * Reset the parser ready for a new response
+ */
+void FWitResponseChunkParser::Reset()
+{
+	NumBytesParsed = 0;
+	BraceDepth = 0;
+	ChunkOffset = INDEX_NONE;
+	LastChunk = FWitResponseChunk();
+	bHasLastChunk = false;
+	bIsInString = false;
+	bIsEscaped = false;
+}
+
+/**
+ * Scan any bytes that have been added to the response since the last call. The speech endpoint implements chunked responses by using
+ * a JSON format that does not strictly conform to the JSON specification. It consists of a sequence of brace delimited JSON objects
+ * so we track the brace depth to find where each object ends. Braces and quotes are single byte in UTF-8 and can never appear inside
+ * a multi-byte sequence so we can safely scan the raw bytes
+ *
+ * @param Content [in] the full response payload received so far
+ * @param NumBytes [in] the size of the payload in bytes
+ * @param NewChunks [out] the chunks that were completed by the new bytes in the order they appear
+ * @return true if at least one new chunk was completed
+ */
+bool FWitResponseChunkParser::Parse(const uint8* Content, int32 NumBytes, TArray<FWitResponseChunk>& NewChunks)
+{
+	NewChunks.Reset();
+
+	if (Content == nullptr || NumBytes <= NumBytesParsed)
+	{
+		return false;
+	}
+
+	for (int32 Index = NumBytesParsed; Index < NumBytes; ++Index)
+	{
+		const uint8 Character = Content[Index];
+
+		if (bIsInString)
+		{
+			if (bIsEscaped)
+			{
+				bIsEscaped = false;
+			}
+			else if (Character == '\\')
+			{
+				bIsEscaped = true;
+			}
+			else if (Character == '"')
+			{
+				bIsInString = false;
+			}
+
+			continue;
+		}
+
+		if (Character == '"')
+		{
+			// Strings only have meaning inside a chunk. Anything between chunks is skipped
+
+			bIsInString = BraceDepth > 0;
+		}
+		else if (Character == '{')
+		{
+			if (BraceDepth == 0)
+			{
+				ChunkOffset = Index;
+			}
+
+			++BraceDepth;
+		}
+		else if (Character == '}' && BraceDepth > 0)
+		{
+			--BraceDepth;
+
+			if (BraceDepth == 0)
+			{
+				LastChunk.Offset = ChunkOffset;
+				LastChunk.Length = Index + 1 - ChunkOffset;
+				bHasLastChunk = true;
+
+				NewChunks.Add(LastChunk);
+
+				ChunkOffset = INDEX_NONE;
+
+				UE_LOG(LogWit, VeryVerbose, TEXT("Parse: chunk found at offset (%d) with length (%d)"), LastChunk.Offset, LastChunk.Length);
+			}
+		}
+	}
+
+	NumBytesParsed = NumBytes;
+
+	return NewChunks.Num() > 0;
+}
+
+/**
+ * Get the most recently completed chunk
+ *
+ * @param Chunk [out] the most recently completed chunk
+ * @return true if any chunk has been completed
+ */
+bool FWitResponseChunkParser::GetLastChunk(FWitResponseChunk& Chunk) const
+{
+	if (!bHasLastChunk)
+	{
+		return false;
+	}
+
+	Chunk = LastChunk;
+
+	return true;
+}
+
+/**
+ * Convert a chunk to a string
+ *
+ * @param Content [in] the response payload the chunk refers to
+ * @param Chunk [in] the chunk to convert
+ * @return the chunk as a string
+ */
+FString FWitResponseChunkParser::GetChunkAsString(const uint8* Content, const FWitResponseChunk& Chunk)
+{
+	const FUTF8ToTCHAR ChunkAsTChar(reinterpret_cast<const ANSICHAR*>(Content + Chunk.Offset), Chunk.Length);
+
+	return FString(ChunkAsTChar.Length(), ChunkAsTChar.Get());
+}
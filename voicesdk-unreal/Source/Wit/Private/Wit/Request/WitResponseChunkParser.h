@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The location of a single complete JSON object within a response payload
+ */
+struct FWitResponseChunk
+{
+	/** The byte offset of the opening brace */
+	int32 Offset{0};
+
+	/** The length in bytes including both braces */
+	int32 Length{0};
+};
+
+/**
+ * Incremental parser for the chunked response format used by the Wit.ai streaming endpoints. The response is a sequence of brace
+ * delimited JSON objects that grows as the request progresses. The parser remembers where it got to so each call only scans the
+ * newly received bytes and each completed chunk is reported exactly once. Scanning is done directly on the UTF-8 payload
+ */
+class FWitResponseChunkParser
+{
+public:
+
+	/**
+	 * Reset the parser ready for a new response
+	 */
+	void Reset();
+
+	/**
+	 * Scan any bytes that have been added to the response since the last call
+	 *
+	 * @param Content [in] the full response payload received so far
+	 * @param NumBytes [in] the size of the payload in bytes
+	 * @param NewChunks [out] the chunks that were completed by the new bytes in the order they appear
+	 * @return true if at least one new chunk was completed
+	 */
+	bool Parse(const uint8* Content, int32 NumBytes, TArray<FWitResponseChunk>& NewChunks);
+
+	/**
+	 * Get the number of bytes of the response that have been scanned so far
+	 *
+	 * @return the number of bytes scanned
+	 */
+	int32 GetNumBytesParsed() const { return NumBytesParsed; }
+
+	/**
+	 * Get the most recently completed chunk
+	 *
+	 * @param Chunk [out] the most recently completed chunk
+	 * @return true if any chunk has been completed
+	 */
+	bool GetLastChunk(FWitResponseChunk& Chunk) const;
+
+	/**
+	 * Convert a chunk to a string
+	 *
+	 * @param Content [in] the response payload the chunk refers to
+	 * @param Chunk [in] the chunk to convert
+	 * @return the chunk as a string
+	 */
+	static FString GetChunkAsString(const uint8* Content, const FWitResponseChunk& Chunk);
+
+private:
+
+	/** The number of bytes scanned so far */
+	int32 NumBytesParsed{0};
+
+	/** The current brace depth. Zero when between chunks */
+	int32 BraceDepth{0};
+
+	/** The offset of the opening brace of the chunk currently being scanned */
+	int32 ChunkOffset{INDEX_NONE};
+
+	/** The most recently completed chunk */
+	FWitResponseChunk LastChunk{};
+
+	/** Has any chunk been completed? */
+	bool bHasLastChunk{false};
+
+	/** Are we inside a JSON string? Braces inside strings are ignored */
+	bool bIsInString{false};
+
+	/** Was the previous character inside a string an escape? */
+	bool bIsEscaped{false};
+};
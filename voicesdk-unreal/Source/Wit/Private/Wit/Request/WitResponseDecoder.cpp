@@ -0,0 +1,1234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Wit/Request/WitResponseDecoder.h"
+#include "Misc/EngineVersionComparison.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Wit/Request/WitResponse.h"
+#include "Wit/Request/WitResponseStorage.h"
+
+/**
+ * Does a JSON field name match a struct field? Matching is case insensitive in the same way as FJsonObjectConverter
+ *
+ * @param Identifier [in] the JSON field name
+ * @param FieldName [in] the struct field name
+ *
+ * @return true if the names match
+ */
+static bool IsField(const FString& Identifier, const TCHAR* FieldName)
+{
+	return Identifier.Equals(FieldName, ESearchCase::IgnoreCase);
+}
+
+/**
+ * Decode a response
+ *
+ * @param JsonText [in] the JSON text of the response
+ * @param OutResponse [out] the decoded response
+ * @param OutInfo [out] optional information about what the response contained
+ *
+ * @return true if the response was decoded successfully
+ */
+bool FWitResponseDecoder::Decode(const FString& JsonText, FWitResponse& OutResponse, FWitResponseDecodeInfo* OutInfo)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FWitResponseDecoder::Decode);
+
+	FWitResponseDecoder Decoder(CreateReader(JsonText), nullptr);
+	FWitResponseDecodeInfo Info{};
+
+	const bool bIsDecoded = Decoder.DecodeResponse(OutResponse, Info);
+
+	if (OutInfo != nullptr)
+	{
+		*OutInfo = Info;
+	}
+
+	return bIsDecoded;
+}
+
+/**
+ * Decode a response into storage that may be recycled from the previous decode. When recycling, the strings, array elements and map
+ * entries of the previous response are reused so a response of a similar shape does not allocate
+ *
+ * @param JsonText [in] the JSON text of the response
+ * @param Storage [in,out] the storage to decode into
+ * @param bShouldRecycle [in] should the allocations of the previous response be reused or released first
+ * @param OutInfo [out] optional information about what the response contained
+ *
+ * @return true if the response was decoded successfully
+ */
+bool FWitResponseDecoder::Decode(const FString& JsonText, FWitResponseStorage& Storage, const bool bShouldRecycle, FWitResponseDecodeInfo* OutInfo)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FWitResponseDecoder::Decode);
+
+	if (bShouldRecycle)
+	{
+		Storage.Recycle();
+	}
+	else
+	{
+		Storage.Release();
+	}
+
+	++Storage.NumDecodes;
+
+	FWitResponseDecoder Decoder(CreateReader(JsonText), &Storage);
+	FWitResponseDecodeInfo Info{};
+
+	const bool bIsDecoded = Decoder.DecodeResponse(Storage.Response, Info);
+
+	// Intents are reused in place rather than moved to the spares so they have to be cleared if this response has none
+
+	if (!Info.bHasIntents)
+	{
+		TruncateElements(Storage.Response.Intents, 0);
+	}
+
+	if (OutInfo != nullptr)
+	{
+		*OutInfo = Info;
+	}
+
+	return bIsDecoded;
+}
+
+/**
+ * Create a decoder reading from the given reader
+ *
+ * @param InReader [in] the reader to take tokens from
+ * @param InStorage [in] optional storage to take spare allocations from and count allocations in
+ */
+FWitResponseDecoder::FWitResponseDecoder(const TSharedRef<TJsonReader<TCHAR>>& InReader, FWitResponseStorage* InStorage)
+	: Reader(InReader)
+	, Storage(InStorage)
+{
+}
+
+/**
+ * Create a reader for the JSON text. The view reader reads the text in place where it is available so the response is never copied
+ *
+ * @param JsonText [in] the JSON text to read
+ *
+ * @return the reader
+ */
+TSharedRef<TJsonReader<TCHAR>> FWitResponseDecoder::CreateReader(const FString& JsonText)
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	return TJsonReaderFactory<TCHAR>::Create(JsonText);
+#else
+	return TJsonReaderFactory<TCHAR>::CreateFromView(JsonText);
+#endif
+}
+
+/**
+ * Decode the top level response object
+ *
+ * @param OutResponse [out] the decoded response
+ * @param OutInfo [out] information about what the response contained
+ *
+ * @return true if the response was decoded successfully
+ */
+bool FWitResponseDecoder::DecodeResponse(FWitResponse& OutResponse, FWitResponseDecodeInfo& OutInfo)
+{
+	EJsonNotation Notation;
+
+	const bool bIsRootObject = Reader->ReadNext(Notation) && Notation == EJsonNotation::ObjectStart;
+	if (!bIsRootObject)
+	{
+		return false;
+	}
+
+	while (Reader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("text")))
+		{
+			OutInfo.bHasText = true;
+			bIsValid = ReadString(Notation, OutResponse.Text);
+		}
+		else if (IsField(Identifier, TEXT("intents")))
+		{
+			OutInfo.bHasIntents = Notation == EJsonNotation::ArrayStart;
+			bIsValid = DecodeIntents(Notation, OutResponse.Intents);
+		}
+		else if (IsField(Identifier, TEXT("entities")))
+		{
+			bIsValid = DecodeEntities(Notation, OutResponse.Entities, OutResponse.AllEntities);
+		}
+		else if (IsField(Identifier, TEXT("traits")))
+		{
+			bIsValid = DecodeTraits(Notation, OutResponse.Traits);
+		}
+		else if (IsField(Identifier, TEXT("is_final")))
+		{
+			bIsValid = ReadBool(Notation, OutResponse.Is_Final);
+		}
+		else
+		{
+			bIsValid = SkipValue(Notation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode an array of intents. Like FJsonObjectConverter the array is replaced and elements that are not objects are ignored
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutIntents [out] the decoded intents
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeIntents(const EJsonNotation Notation, TArray<FWitIntent>& OutIntents)
+{
+	if (Notation != EJsonNotation::ArrayStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	int32 NumIntents = 0;
+	EJsonNotation ElementNotation;
+
+	while (Reader->ReadNext(ElementNotation))
+	{
+		if (ElementNotation == EJsonNotation::ArrayEnd)
+		{
+			TruncateElements(OutIntents, NumIntents);
+			return true;
+		}
+
+		if (ElementNotation != EJsonNotation::ObjectStart)
+		{
+			if (!SkipValue(ElementNotation))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (!DecodeIntent(ElementNotation, AddElement(OutIntents, NumIntents)))
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode a single intent object
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutIntent [out] the decoded intent
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeIntent(const EJsonNotation Notation, FWitIntent& OutIntent)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	EJsonNotation FieldNotation;
+
+	while (Reader->ReadNext(FieldNotation))
+	{
+		if (FieldNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("name")))
+		{
+			bIsValid = ReadString(FieldNotation, OutIntent.Name);
+		}
+		else if (IsField(Identifier, TEXT("id")))
+		{
+			bIsValid = ReadInt64(FieldNotation, OutIntent.Id);
+		}
+		else if (IsField(Identifier, TEXT("confidence")))
+		{
+			bIsValid = ReadFloat(FieldNotation, OutIntent.Confidence);
+		}
+		else
+		{
+			bIsValid = SkipValue(FieldNotation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode the entities object. Each key holds an array of entities. Like FJsonObjectConverter the first entity of each key goes into
+ * the entities map and, like FWitHelperUtilities::ConvertJsonToAllEntities, every entity of each key goes into the all entities map
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutEntities [out] the first entity for each key
+ * @param OutAllEntities [out] every entity for each key
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeEntities(const EJsonNotation Notation, TMap<FString, FWitEntity>& OutEntities, TMap<FString, FWitEntities>& OutAllEntities)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	TWitResponseSpareValues<FWitEntity>* SpareEntities = Storage != nullptr ? &Storage->SpareEntities : nullptr;
+	TWitResponseSpareValues<FWitEntities>* SpareAllEntities = Storage != nullptr ? &Storage->SpareAllEntities : nullptr;
+
+	ResetMap(OutEntities, SpareEntities);
+	ResetMap(OutAllEntities, SpareAllEntities);
+
+	EJsonNotation KeyNotation;
+
+	while (Reader->ReadNext(KeyNotation))
+	{
+		if (KeyNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString Key = Reader->GetIdentifier();
+
+		if (KeyNotation == EJsonNotation::ObjectStart)
+		{
+			// A lone entity rather than an array of them only ever reaches the entities map
+
+			TruncateElements(AddMapValue(OutAllEntities, SpareAllEntities, Key).Entities, 0);
+
+			if (!DecodeEntity(KeyNotation, AddMapValue(OutEntities, SpareEntities, Key)))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (KeyNotation != EJsonNotation::ArrayStart)
+		{
+			if (!SkipValue(KeyNotation))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		FWitEntity& FirstEntity = AddMapValue(OutEntities, SpareEntities, Key);
+		FWitEntities& AllEntities = AddMapValue(OutAllEntities, SpareAllEntities, Key);
+
+		EJsonNotation ElementNotation;
+		bool bIsArrayEnd = false;
+		int32 NumEntities = 0;
+
+		while (!bIsArrayEnd && Reader->ReadNext(ElementNotation))
+		{
+			if (ElementNotation == EJsonNotation::ArrayEnd)
+			{
+				bIsArrayEnd = true;
+				continue;
+			}
+
+			if (ElementNotation != EJsonNotation::ObjectStart)
+			{
+				if (!SkipValue(ElementNotation))
+				{
+					return false;
+				}
+				continue;
+			}
+
+			FWitEntity& Entity = AddElement(AllEntities.Entities, NumEntities);
+
+			if (!DecodeEntity(ElementNotation, Entity))
+			{
+				return false;
+			}
+
+			AssignString(AllEntities.Name, Key);
+
+			if (NumEntities == 1)
+			{
+				FirstEntity = Entity;
+			}
+		}
+
+		if (!bIsArrayEnd)
+		{
+			return false;
+		}
+
+		TruncateElements(AllEntities.Entities, NumEntities);
+	}
+
+	return false;
+}
+
+/**
+ * Decode a single entity object
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutEntity [out] the decoded entity
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeEntity(const EJsonNotation Notation, FWitEntity& OutEntity)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	EJsonNotation FieldNotation;
+	bool bHasValues = false;
+
+	while (Reader->ReadNext(FieldNotation))
+	{
+		if (FieldNotation == EJsonNotation::ObjectEnd)
+		{
+			// A reused entity may still hold the values of a previous response
+
+			if (!bHasValues)
+			{
+				TruncateElements(OutEntity.Values, 0);
+			}
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("value")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Value);
+		}
+		else if (IsField(Identifier, TEXT("name")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Name);
+		}
+		else if (IsField(Identifier, TEXT("id")))
+		{
+			bIsValid = ReadInt64(FieldNotation, OutEntity.Id);
+		}
+		else if (IsField(Identifier, TEXT("role")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Role);
+		}
+		else if (IsField(Identifier, TEXT("body")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Body);
+		}
+		else if (IsField(Identifier, TEXT("confidence")))
+		{
+			bIsValid = ReadFloat(FieldNotation, OutEntity.Confidence);
+		}
+		else if (IsField(Identifier, TEXT("type")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Type);
+		}
+		else if (IsField(Identifier, TEXT("unit")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Unit);
+		}
+		else if (IsField(Identifier, TEXT("grain")))
+		{
+			bIsValid = ReadString(FieldNotation, OutEntity.Grain);
+		}
+		else if (IsField(Identifier, TEXT("start")))
+		{
+			bIsValid = ReadInt32(FieldNotation, OutEntity.Start);
+		}
+		else if (IsField(Identifier, TEXT("end")))
+		{
+			bIsValid = ReadInt32(FieldNotation, OutEntity.End);
+		}
+		else if (IsField(Identifier, TEXT("from")))
+		{
+			bIsValid = DecodeEntityInterval(FieldNotation, OutEntity.From);
+		}
+		else if (IsField(Identifier, TEXT("to")))
+		{
+			bIsValid = DecodeEntityInterval(FieldNotation, OutEntity.To);
+		}
+		else if (IsField(Identifier, TEXT("normalized")))
+		{
+			bIsValid = DecodeEntityNormalized(FieldNotation, OutEntity.Normalized);
+		}
+		else if (IsField(Identifier, TEXT("values")))
+		{
+			bHasValues = FieldNotation == EJsonNotation::ArrayStart;
+			bIsValid = DecodeEntityValues(FieldNotation, OutEntity.Values);
+		}
+		else
+		{
+			bIsValid = SkipValue(FieldNotation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode an array of entity values. Like FJsonObjectConverter the array is replaced and elements that are not objects are ignored
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValues [out] the decoded values
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeEntityValues(const EJsonNotation Notation, TArray<FWitEntityValue>& OutValues)
+{
+	if (Notation != EJsonNotation::ArrayStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	int32 NumValues = 0;
+	EJsonNotation ElementNotation;
+
+	while (Reader->ReadNext(ElementNotation))
+	{
+		if (ElementNotation == EJsonNotation::ArrayEnd)
+		{
+			TruncateElements(OutValues, NumValues);
+			return true;
+		}
+
+		if (ElementNotation != EJsonNotation::ObjectStart)
+		{
+			if (!SkipValue(ElementNotation))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (!DecodeEntityValue(ElementNotation, AddElement(OutValues, NumValues)))
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode a single entity value object
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValue [out] the decoded value
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeEntityValue(const EJsonNotation Notation, FWitEntityValue& OutValue)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	EJsonNotation FieldNotation;
+
+	while (Reader->ReadNext(FieldNotation))
+	{
+		if (FieldNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("value")))
+		{
+			bIsValid = ReadString(FieldNotation, OutValue.Value);
+		}
+		else if (IsField(Identifier, TEXT("type")))
+		{
+			bIsValid = ReadString(FieldNotation, OutValue.Type);
+		}
+		else if (IsField(Identifier, TEXT("grain")))
+		{
+			bIsValid = ReadString(FieldNotation, OutValue.Grain);
+		}
+		else if (IsField(Identifier, TEXT("from")))
+		{
+			bIsValid = DecodeEntityInterval(FieldNotation, OutValue.From);
+		}
+		else if (IsField(Identifier, TEXT("to")))
+		{
+			bIsValid = DecodeEntityInterval(FieldNotation, OutValue.To);
+		}
+		else
+		{
+			bIsValid = SkipValue(FieldNotation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode an entity interval object
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutInterval [out] the decoded interval
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeEntityInterval(const EJsonNotation Notation, FWitEntityInterval& OutInterval)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	EJsonNotation FieldNotation;
+
+	while (Reader->ReadNext(FieldNotation))
+	{
+		if (FieldNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("value")))
+		{
+			bIsValid = ReadString(FieldNotation, OutInterval.Value);
+		}
+		else if (IsField(Identifier, TEXT("unit")))
+		{
+			bIsValid = ReadString(FieldNotation, OutInterval.Unit);
+		}
+		else if (IsField(Identifier, TEXT("grain")))
+		{
+			bIsValid = ReadString(FieldNotation, OutInterval.Grain);
+		}
+		else if (IsField(Identifier, TEXT("product")))
+		{
+			bIsValid = ReadString(FieldNotation, OutInterval.Product);
+		}
+		else
+		{
+			bIsValid = SkipValue(FieldNotation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode an entity normalized object
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutNormalized [out] the decoded normalized value
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeEntityNormalized(const EJsonNotation Notation, FWitEntityNormalized& OutNormalized)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	EJsonNotation FieldNotation;
+
+	while (Reader->ReadNext(FieldNotation))
+	{
+		if (FieldNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("value")))
+		{
+			bIsValid = ReadString(FieldNotation, OutNormalized.Value);
+		}
+		else if (IsField(Identifier, TEXT("unit")))
+		{
+			bIsValid = ReadString(FieldNotation, OutNormalized.Unit);
+		}
+		else
+		{
+			bIsValid = SkipValue(FieldNotation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode the traits object. Each key holds an array of traits of which only the first is kept, the same as FJsonObjectConverter
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutTraits [out] the first trait for each key
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeTraits(const EJsonNotation Notation, TMap<FString, FWitTrait>& OutTraits)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	TWitResponseSpareValues<FWitTrait>* SpareTraits = Storage != nullptr ? &Storage->SpareTraits : nullptr;
+
+	ResetMap(OutTraits, SpareTraits);
+
+	EJsonNotation KeyNotation;
+
+	while (Reader->ReadNext(KeyNotation))
+	{
+		if (KeyNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString Key = Reader->GetIdentifier();
+
+		if (KeyNotation == EJsonNotation::ObjectStart)
+		{
+			if (!DecodeTrait(KeyNotation, AddMapValue(OutTraits, SpareTraits, Key)))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (KeyNotation != EJsonNotation::ArrayStart)
+		{
+			if (!SkipValue(KeyNotation))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		FWitTrait& Trait = AddMapValue(OutTraits, SpareTraits, Key);
+
+		EJsonNotation ElementNotation;
+		bool bIsArrayEnd = false;
+		bool bIsFirstElement = true;
+
+		while (!bIsArrayEnd && Reader->ReadNext(ElementNotation))
+		{
+			if (ElementNotation == EJsonNotation::ArrayEnd)
+			{
+				bIsArrayEnd = true;
+				continue;
+			}
+
+			const bool bIsValid = bIsFirstElement ? DecodeTrait(ElementNotation, Trait) : SkipValue(ElementNotation);
+			if (!bIsValid)
+			{
+				return false;
+			}
+
+			bIsFirstElement = false;
+		}
+
+		if (!bIsArrayEnd)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decode a single trait object
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutTrait [out] the decoded trait
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::DecodeTrait(const EJsonNotation Notation, FWitTrait& OutTrait)
+{
+	if (Notation != EJsonNotation::ObjectStart)
+	{
+		return SkipValue(Notation);
+	}
+
+	EJsonNotation FieldNotation;
+
+	while (Reader->ReadNext(FieldNotation))
+	{
+		if (FieldNotation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		bool bIsValid;
+
+		if (IsField(Identifier, TEXT("value")))
+		{
+			bIsValid = ReadString(FieldNotation, OutTrait.Value);
+		}
+		else if (IsField(Identifier, TEXT("id")))
+		{
+			bIsValid = ReadInt64(FieldNotation, OutTrait.Id);
+		}
+		else if (IsField(Identifier, TEXT("confidence")))
+		{
+			bIsValid = ReadFloat(FieldNotation, OutTrait.Confidence);
+		}
+		else
+		{
+			bIsValid = SkipValue(FieldNotation);
+		}
+
+		if (!bIsValid)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Read the current value as a string. Numbers and booleans are converted the same way FJsonValue does. Anything else leaves the
+ * string untouched
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValue [out] the string
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::ReadString(const EJsonNotation Notation, FString& OutValue)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::String:
+		AssignString(OutValue, Reader->GetValueAsString());
+		return true;
+
+	case EJsonNotation::Number:
+		AssignString(OutValue, FString::SanitizeFloat(Reader->GetValueAsNumber(), 0));
+		return true;
+
+	case EJsonNotation::Boolean:
+		AssignString(OutValue, Reader->GetValueAsBoolean() ? FString(TEXT("true")) : FString(TEXT("false")));
+		return true;
+
+	default:
+		return SkipValue(Notation);
+	}
+}
+
+/**
+ * Read the current value as a 64 bit integer. Wit.ai sends ids as strings so strings are parsed
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValue [out] the integer
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::ReadInt64(const EJsonNotation Notation, int64& OutValue)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::String:
+		OutValue = FCString::Atoi64(*Reader->GetValueAsString());
+		return true;
+
+	case EJsonNotation::Number:
+		OutValue = static_cast<int64>(Reader->GetValueAsNumber());
+		return true;
+
+	case EJsonNotation::Boolean:
+		OutValue = Reader->GetValueAsBoolean() ? 1 : 0;
+		return true;
+
+	default:
+		return SkipValue(Notation);
+	}
+}
+
+/**
+ * Read the current value as a 32 bit integer
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValue [out] the integer
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::ReadInt32(const EJsonNotation Notation, int32& OutValue)
+{
+	int64 Value = OutValue;
+
+	if (!ReadInt64(Notation, Value))
+	{
+		return false;
+	}
+
+	OutValue = static_cast<int32>(Value);
+
+	return true;
+}
+
+/**
+ * Read the current value as a float. Strings are only used if they hold a number
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValue [out] the float
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::ReadFloat(const EJsonNotation Notation, float& OutValue)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::String:
+		{
+			const FString& Value = Reader->GetValueAsString();
+			if (Value.IsNumeric())
+			{
+				OutValue = FCString::Atof(*Value);
+			}
+			return true;
+		}
+
+	case EJsonNotation::Number:
+		OutValue = static_cast<float>(Reader->GetValueAsNumber());
+		return true;
+
+	case EJsonNotation::Boolean:
+		OutValue = Reader->GetValueAsBoolean() ? 1.0f : 0.0f;
+		return true;
+
+	default:
+		return SkipValue(Notation);
+	}
+}
+
+/**
+ * Read the current value as a boolean
+ *
+ * @param Notation [in] the notation of the current value
+ * @param OutValue [out] the boolean
+ *
+ * @return true if the value was read successfully
+ */
+bool FWitResponseDecoder::ReadBool(const EJsonNotation Notation, bool& OutValue)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::String:
+		OutValue = Reader->GetValueAsString().ToBool();
+		return true;
+
+	case EJsonNotation::Number:
+		OutValue = Reader->GetValueAsNumber() != 0.0;
+		return true;
+
+	case EJsonNotation::Boolean:
+		OutValue = Reader->GetValueAsBoolean();
+		return true;
+
+	default:
+		return SkipValue(Notation);
+	}
+}
+
+/**
+ * Skip the current value including anything nested inside it
+ *
+ * @param Notation [in] the notation of the current value
+ *
+ * @return true if the value was skipped successfully
+ */
+bool FWitResponseDecoder::SkipValue(const EJsonNotation Notation)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::ObjectStart:
+		return Reader->SkipObject();
+
+	case EJsonNotation::ArrayStart:
+		return Reader->SkipArray();
+
+	case EJsonNotation::Error:
+		return false;
+
+	default:
+		return true;
+	}
+}
+
+/**
+ * Assign a string reusing its existing allocation when it is big enough
+ *
+ * @param OutValue [out] the string to assign to
+ * @param Value [in] the value to assign
+ */
+void FWitResponseDecoder::AssignString(FString& OutValue, const FString& Value)
+{
+	const bool bIsGrowing = !Value.IsEmpty() && Value.Len() + 1 > OutValue.GetCharArray().Max();
+
+	if (bIsGrowing && Storage != nullptr)
+	{
+		++Storage->NumAllocations;
+	}
+
+	OutValue.Reset();
+	OutValue.Append(Value);
+}
+
+/**
+ * Add the next element to an array. Elements left from a previous decode are reset and reused so their strings keep their allocations
+ *
+ * @param Array [in,out] the array to add to
+ * @param NumElements [in,out] the number of elements decoded into the array so far
+ *
+ * @return the element to decode into
+ */
+template <typename ElementType>
+ElementType& FWitResponseDecoder::AddElement(TArray<ElementType>& Array, int32& NumElements)
+{
+	if (NumElements < Array.Num())
+	{
+		ElementType& Element = Array[NumElements++];
+		ResetElement(Element);
+		return Element;
+	}
+
+	if (Array.Num() == Array.Max() && Storage != nullptr)
+	{
+		++Storage->NumAllocations;
+	}
+
+	++NumElements;
+
+	return Array.AddDefaulted_GetRef();
+}
+
+/**
+ * Add a value to a map. A spare key and value from a previous decode are reused if there is one
+ *
+ * @param Map [in,out] the map to add to
+ * @param SpareValues [in,out] optional spare keys and values to reuse
+ * @param Key [in] the key to add
+ *
+ * @return the value to decode into
+ */
+template <typename ValueType>
+ValueType& FWitResponseDecoder::AddMapValue(TMap<FString, ValueType>& Map, TWitResponseSpareValues<ValueType>* SpareValues, const FString& Key)
+{
+	ValueType* ExistingValue = Map.Find(Key);
+	if (ExistingValue != nullptr)
+	{
+		return *ExistingValue;
+	}
+
+	const bool bHasSpareValue = SpareValues != nullptr && SpareValues->NumSpare > 0;
+	if (!bHasSpareValue)
+	{
+		if (Storage != nullptr)
+		{
+			++Storage->NumAllocations;
+		}
+
+		return Map.Add(Key, ValueType());
+	}
+
+	--SpareValues->NumSpare;
+
+	FString& SpareKey = SpareValues->Keys[SpareValues->NumSpare];
+	ValueType& SpareValue = SpareValues->Values[SpareValues->NumSpare];
+
+	AssignString(SpareKey, Key);
+	ResetElement(SpareValue);
+
+	return Map.Add(MoveTemp(SpareKey), MoveTemp(SpareValue));
+}
+
+/**
+ * Empty a map. If there is somewhere to keep them the keys and values are kept as spares for reuse
+ *
+ * @param Map [in,out] the map to empty
+ * @param SpareValues [in,out] optional place to keep the keys and values
+ */
+template <typename ValueType>
+void FWitResponseDecoder::ResetMap(TMap<FString, ValueType>& Map, TWitResponseSpareValues<ValueType>* SpareValues)
+{
+	if (SpareValues != nullptr)
+	{
+		SpareValues->Recycle(Map);
+	}
+	else
+	{
+		Map.Reset();
+	}
+}
+
+/**
+ * Remove any elements beyond the ones decoded without releasing the array allocation
+ *
+ * @param Array [in,out] the array to truncate
+ * @param NumElements [in] the number of elements to keep
+ */
+template <typename ElementType>
+void FWitResponseDecoder::TruncateElements(TArray<ElementType>& Array, const int32 NumElements)
+{
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	Array.SetNum(NumElements, false);
+#else
+	Array.SetNum(NumElements, EAllowShrinking::No);
+#endif
+}
+
+/**
+ * Reset a reused intent to its defaults while keeping its string allocations
+ *
+ * @param Intent [in,out] the intent to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitIntent& Intent)
+{
+	Intent.Name.Reset();
+	Intent.Id = 0;
+	Intent.Confidence = 0.0f;
+}
+
+/**
+ * Reset a reused entity to its defaults while keeping its string allocations. The values are truncated once the entity is decoded
+ *
+ * @param Entity [in,out] the entity to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitEntity& Entity)
+{
+	Entity.Value.Reset();
+	Entity.Name.Reset();
+	Entity.Id = 0;
+	Entity.Role.Reset();
+	Entity.Body.Reset();
+	Entity.Confidence = 0.0f;
+	Entity.Type.Reset();
+	Entity.Unit.Reset();
+	Entity.Grain.Reset();
+	Entity.Start = 0;
+	Entity.End = 0;
+
+	ResetElement(Entity.From);
+	ResetElement(Entity.To);
+	ResetElement(Entity.Normalized);
+}
+
+/**
+ * Reset a reused group of entities while keeping its allocations. The entities are truncated once the group is decoded
+ *
+ * @param Entities [in,out] the group of entities to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitEntities& Entities)
+{
+	Entities.Name.Reset();
+}
+
+/**
+ * Reset a reused entity value to its defaults while keeping its string allocations
+ *
+ * @param Value [in,out] the entity value to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitEntityValue& Value)
+{
+	Value.Value.Reset();
+	Value.Type.Reset();
+	Value.Grain.Reset();
+
+	ResetElement(Value.From);
+	ResetElement(Value.To);
+}
+
+/**
+ * Reset a reused entity interval to its defaults while keeping its string allocations
+ *
+ * @param Interval [in,out] the entity interval to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitEntityInterval& Interval)
+{
+	Interval.Value.Reset();
+	Interval.Unit.Reset();
+	Interval.Grain.Reset();
+	Interval.Product.Reset();
+}
+
+/**
+ * Reset a reused entity normalized value to its defaults while keeping its string allocations
+ *
+ * @param Normalized [in,out] the entity normalized value to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitEntityNormalized& Normalized)
+{
+	Normalized.Value.Reset();
+	Normalized.Unit.Reset();
+}
+
+/**
+ * Reset a reused trait to its defaults while keeping its string allocations
+ *
+ * @param Trait [in,out] the trait to reset
+ */
+void FWitResponseDecoder::ResetElement(FWitTrait& Trait)
+{
+	Trait.Value.Reset();
+	Trait.Id = 0;
+	Trait.Confidence = 0.0f;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonReader.h"
+
+class FWitResponseStorage;
+struct FWitEntity;
+struct FWitEntities;
+struct FWitEntityInterval;
+struct FWitEntityNormalized;
+struct FWitEntityValue;
+struct FWitIntent;
+struct FWitResponse;
+struct FWitTrait;
+template <typename ValueType> struct TWitResponseSpareValues;
+
+/**
+ * What the decoder found at the top level of a response
+ */
+struct FWitResponseDecodeInfo
+{
+	/** Did the response contain a text field? */
+	bool bHasText{false};
+
+	/** Did the response contain an intents array? Only full responses do, partial transcriptions only contain text */
+	bool bHasIntents{false};
+};
+
+/**
+ * Decodes a Wit.ai response straight from its JSON text into an FWitResponse in a single pass over the JSON tokens. No intermediate
+ * FJsonObject tree is built and no reflection is used. The result matches FWitHelperUtilities::ConvertJsonToWitResponse: fields are
+ * matched case insensitively, missing fields are left untouched, Entities holds the first entity for each key and AllEntities holds
+ * every entity for each key
+ */
+class FWitResponseDecoder final
+{
+public:
+
+	/**
+	 * Decode a response
+	 *
+	 * @param JsonText [in] the JSON text of the response
+	 * @param OutResponse [out] the decoded response
+	 * @param OutInfo [out] optional information about what the response contained
+	 *
+	 * @return true if the response was decoded successfully
+	 */
+	static bool Decode(const FString& JsonText, FWitResponse& OutResponse, FWitResponseDecodeInfo* OutInfo = nullptr);
+
+	/**
+	 * Decode a response into storage that may be recycled from the previous decode
+	 *
+	 * @param JsonText [in] the JSON text of the response
+	 * @param Storage [in,out] the storage to decode into
+	 * @param bShouldRecycle [in] should the allocations of the previous response be reused or released first
+	 * @param OutInfo [out] optional information about what the response contained
+	 *
+	 * @return true if the response was decoded successfully
+	 */
+	static bool Decode(const FString& JsonText, FWitResponseStorage& Storage, const bool bShouldRecycle, FWitResponseDecodeInfo* OutInfo = nullptr);
+
+private:
+
+	/**
+	 * Create a decoder reading from the given reader
+	 *
+	 * @param InReader [in] the reader to take tokens from
+	 * @param InStorage [in] optional storage to take spare allocations from and count allocations in
+	 */
+	FWitResponseDecoder(const TSharedRef<TJsonReader<TCHAR>>& InReader, FWitResponseStorage* InStorage);
+
+	/** Create a reader for the JSON text */
+	static TSharedRef<TJsonReader<TCHAR>> CreateReader(const FString& JsonText);
+
+	/** Decode the top level response object */
+	bool DecodeResponse(FWitResponse& OutResponse, FWitResponseDecodeInfo& OutInfo);
+
+	/** Decode an array of intents */
+	bool DecodeIntents(const EJsonNotation Notation, TArray<FWitIntent>& OutIntents);
+
+	/** Decode a single intent object */
+	bool DecodeIntent(const EJsonNotation Notation, FWitIntent& OutIntent);
+
+	/** Decode the entities object into both the first entity and all entities maps */
+	bool DecodeEntities(const EJsonNotation Notation, TMap<FString, FWitEntity>& OutEntities, TMap<FString, FWitEntities>& OutAllEntities);
+
+	/** Decode a single entity object */
+	bool DecodeEntity(const EJsonNotation Notation, FWitEntity& OutEntity);
+
+	/** Decode an array of entity values */
+	bool DecodeEntityValues(const EJsonNotation Notation, TArray<FWitEntityValue>& OutValues);
+
+	/** Decode a single entity value object */
+	bool DecodeEntityValue(const EJsonNotation Notation, FWitEntityValue& OutValue);
+
+	/** Decode an entity interval object */
+	bool DecodeEntityInterval(const EJsonNotation Notation, FWitEntityInterval& OutInterval);
+
+	/** Decode an entity normalized object */
+	bool DecodeEntityNormalized(const EJsonNotation Notation, FWitEntityNormalized& OutNormalized);
+
+	/** Decode the traits object */
+	bool DecodeTraits(const EJsonNotation Notation, TMap<FString, FWitTrait>& OutTraits);
+
+	/** Decode a single trait object */
+	bool DecodeTrait(const EJsonNotation Notation, FWitTrait& OutTrait);
+
+	/** Read the current value as a string */
+	bool ReadString(const EJsonNotation Notation, FString& OutValue);
+
+	/** Read the current value as a 64 bit integer */
+	bool ReadInt64(const EJsonNotation Notation, int64& OutValue);
+
+	/** Read the current value as a 32 bit integer */
+	bool ReadInt32(const EJsonNotation Notation, int32& OutValue);
+
+	/** Read the current value as a float */
+	bool ReadFloat(const EJsonNotation Notation, float& OutValue);
+
+	/** Read the current value as a boolean */
+	bool ReadBool(const EJsonNotation Notation, bool& OutValue);
+
+	/** Skip the current value including anything nested inside it */
+	bool SkipValue(const EJsonNotation Notation);
+
+	/** Assign a string reusing its existing allocation when it is big enough */
+	void AssignString(FString& OutValue, const FString& Value);
+
+	/** Add the next element to an array, reusing an element left from a previous decode if there is one */
+	template <typename ElementType>
+	ElementType& AddElement(TArray<ElementType>& Array, int32& NumElements);
+
+	/** Add a value to a map, reusing a spare key and value if there is one */
+	template <typename ValueType>
+	ValueType& AddMapValue(TMap<FString, ValueType>& Map, TWitResponseSpareValues<ValueType>* SpareValues, const FString& Key);
+
+	/** Empty a map, keeping its keys and values as spares if there is somewhere to keep them */
+	template <typename ValueType>
+	static void ResetMap(TMap<FString, ValueType>& Map, TWitResponseSpareValues<ValueType>* SpareValues);
+
+	/** Remove any elements beyond the ones decoded without releasing the array allocation */
+	template <typename ElementType>
+	static void TruncateElements(TArray<ElementType>& Array, const int32 NumElements);
+
+	/** Reset reused elements to their defaults while keeping their string allocations. Arrays are truncated by the decoder */
+	static void ResetElement(FWitIntent& Intent);
+	static void ResetElement(FWitEntity& Entity);
+	static void ResetElement(FWitEntities& Entities);
+	static void ResetElement(FWitEntityValue& Value);
+	static void ResetElement(FWitEntityInterval& Interval);
+	static void ResetElement(FWitEntityNormalized& Normalized);
+	static void ResetElement(FWitTrait& Trait);
+
+	/** The reader tokens are taken from */
+	TSharedRef<TJsonReader<TCHAR>> Reader;
+
+	/** The storage being decoded into if there is one */
+	FWitResponseStorage* Storage{nullptr};
+};
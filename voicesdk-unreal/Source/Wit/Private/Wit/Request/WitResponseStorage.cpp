@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Wit/Request/WitResponseStorage.h"
+
+/**
+ * Release the response and every spare allocation held for reuse
+ */
+void FWitResponseStorage::Release()
+{
+	Response = FWitResponse();
+
+	SpareEntities.Release();
+	SpareAllEntities.Release();
+	SpareTraits.Release();
+}
+
+/**
+ * Prepare the response for the next decode. Map entries are moved to the spares so the decoder can reuse them for whichever keys the
+ * next response contains. Array elements stay where they are and are reused in place by the decoder
+ */
+void FWitResponseStorage::Recycle()
+{
+	Response.Text.Reset();
+	Response.Is_Final = false;
+
+	SpareEntities.Recycle(Response.Entities);
+	SpareAllEntities.Recycle(Response.AllEntities);
+	SpareTraits.Recycle(Response.Traits);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Wit/Request/WitResponse.h"
+
+/**
+ * Map values taken out of a recycled response that are waiting to be reused. The keys and values keep their allocations so reusing
+ * them for the next response does not allocate as long as they are big enough
+ */
+template <typename ValueType>
+struct TWitResponseSpareValues
+{
+	/** The spare keys. Only the first NumSpare are waiting to be reused */
+	TArray<FString> Keys{};
+
+	/** The spare values. Only the first NumSpare are waiting to be reused */
+	TArray<ValueType> Values{};
+
+	/** The number of spare keys and values waiting to be reused */
+	int32 NumSpare{0};
+
+	/**
+	 * Move every key and value out of a map so they can be reused and leave the map empty. The map keeps its own allocation
+	 *
+	 * @param Map [in,out] the map to recycle
+	 */
+	void Recycle(TMap<FString, ValueType>& Map)
+	{
+		for (TPair<FString, ValueType>& Pair : Map)
+		{
+			if (NumSpare < Keys.Num())
+			{
+				Keys[NumSpare] = MoveTemp(Pair.Key);
+				Values[NumSpare] = MoveTemp(Pair.Value);
+			}
+			else
+			{
+				Keys.Add(MoveTemp(Pair.Key));
+				Values.Add(MoveTemp(Pair.Value));
+			}
+
+			++NumSpare;
+		}
+
+		Map.Reset();
+	}
+
+	/**
+	 * Release every spare key and value
+	 */
+	void Release()
+	{
+		Keys.Empty();
+		Values.Empty();
+		NumSpare = 0;
+	}
+};
+
+/**
+ * The storage a response is decoded into. When it is recycled between decodes the strings, arrays and maps of the previous response
+ * are reused by the next one, so partial responses within a request mostly stop allocating once the storage has grown to fit them.
+ * Everything is released in one go by Release or when the storage is destroyed at the end of the request
+ */
+class FWitResponseStorage final
+{
+public:
+
+	/**
+	 * Get the most recently decoded response
+	 */
+	const FWitResponse& GetResponse() const
+	{
+		return Response;
+	}
+
+	/**
+	 * Release the response and every spare allocation held for reuse
+	 */
+	void Release();
+
+	/**
+	 * Get the number of responses decoded into this storage
+	 */
+	int32 GetNumDecodes() const
+	{
+		return NumDecodes;
+	}
+
+	/**
+	 * Get the number of times the storage had to allocate or grow while decoding. With recycling this stops increasing once the storage
+	 * is big enough for the largest response
+	 */
+	int64 GetNumAllocations() const
+	{
+		return NumAllocations;
+	}
+
+private:
+
+	friend class FWitResponseDecoder;
+
+	/** Prepare the response for the next decode, keeping its allocations for reuse */
+	void Recycle();
+
+	/** The response decoded into */
+	FWitResponse Response{};
+
+	/** Spare entities waiting to be reused */
+	TWitResponseSpareValues<FWitEntity> SpareEntities{};
+
+	/** Spare groups of entities waiting to be reused */
+	TWitResponseSpareValues<FWitEntities> SpareAllEntities{};
+
+	/** Spare traits waiting to be reused */
+	TWitResponseSpareValues<FWitTrait> SpareTraits{};
+
+	/** The number of responses decoded */
+	int32 NumDecodes{0};
+
+	/** The number of times the storage had to allocate or grow */
+	int64 NumAllocations{0};
+};
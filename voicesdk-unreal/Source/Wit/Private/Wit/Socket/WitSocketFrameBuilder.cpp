@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Wit/Socket/WitSocketFrameBuilder.h"
+#include "Dom/JsonObject.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Build a frame that only contains JSON data
+ *
+ * @param JsonData [in] the JSON data
+ *
+ * @return the frame
+ */
+const TArray<uint8>& FWitSocketFrameBuilder::BuildJsonFrame(const FString& JsonData)
+{
+	const FTCHARToUTF8 JsonDataUtf8(*JsonData);
+
+	return WriteFrame(reinterpret_cast<const uint8*>(JsonDataUtf8.Get()), JsonDataUtf8.Length(), nullptr, 0);
+}
+
+/**
+ * Build a frame that contains binary data for a request. The JSON section identifying the request is only serialized when the request
+ * changes
+ *
+ * @param RequestId [in] the id of the request the data belongs to
+ * @param BinaryData [in] the binary data
+ * @param BinaryDataSize [in] the size of the binary data in bytes
+ *
+ * @return the frame
+ */
+const TArray<uint8>& FWitSocketFrameBuilder::BuildRequestFrame(const FString& RequestId, const uint8* BinaryData, const int32 BinaryDataSize)
+{
+	const bool bIsNewRequest = CachedRequestHeader.Num() == 0 || !CachedRequestId.Equals(RequestId, ESearchCase::CaseSensitive);
+	if (bIsNewRequest)
+	{
+		const TSharedRef<FJsonObject> RequestData = MakeShared<FJsonObject>();
+		RequestData->SetStringField("client_request_id", RequestId);
+
+		FString StringMessage;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&StringMessage);
+		FJsonSerializer::Serialize(RequestData, Writer);
+
+		const FTCHARToUTF8 StringMessageUtf8(*StringMessage);
+
+		CachedRequestId = RequestId;
+		CachedRequestHeader.Reset();
+		CachedRequestHeader.Append(reinterpret_cast<const uint8*>(StringMessageUtf8.Get()), StringMessageUtf8.Length());
+	}
+
+	return WriteFrame(CachedRequestHeader.GetData(), CachedRequestHeader.Num(), BinaryData, BinaryDataSize);
+}
+
+/**
+ * Write a frame into the frame buffer. The sizes in the header are written as 64 bit little endian values
+ *
+ * @param JsonData [in] the JSON data
+ * @param JsonDataSize [in] the size of the JSON data in bytes
+ * @param BinaryData [in] the binary data
+ * @param BinaryDataSize [in] the size of the binary data in bytes
+ *
+ * @return the frame
+ */
+const TArray<uint8>& FWitSocketFrameBuilder::WriteFrame(const uint8* JsonData, const int32 JsonDataSize, const uint8* BinaryData, const int32 BinaryDataSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FWitSocketFrameBuilder::WriteFrame);
+
+	const int32 FrameSize = HeaderSize + JsonDataSize + BinaryDataSize;
+
+	if (FrameSize > FrameBuffer.Max())
+	{
+		++NumAllocations;
+	}
+
+	// Reset keeps the existing allocation so this only allocates when the frame is bigger than any before it
+
+	FrameBuffer.Reset();
+	FrameBuffer.AddUninitialized(FrameSize);
+
+	uint8* Frame = FrameBuffer.GetData();
+
+	const bool bHasBinaryData = BinaryDataSize > 0;
+	const uint64 JsonSectionSize = INTEL_ORDER64(static_cast<uint64>(JsonDataSize));
+	const uint64 BinarySectionSize = INTEL_ORDER64(static_cast<uint64>(BinaryDataSize));
+
+	Frame[0] = bHasBinaryData ? 0x3 : 0x2;
+
+	FMemory::Memcpy(Frame + 1, &JsonSectionSize, sizeof(JsonSectionSize));
+	FMemory::Memcpy(Frame + 9, &BinarySectionSize, sizeof(BinarySectionSize));
+
+	if (JsonDataSize > 0)
+	{
+		FMemory::Memcpy(Frame + HeaderSize, JsonData, JsonDataSize);
+	}
+
+	if (bHasBinaryData)
+	{
+		FMemory::Memcpy(Frame + HeaderSize + JsonDataSize, BinaryData, BinaryDataSize);
+	}
+
+	++NumFrames;
+	NumBytes += FrameSize;
+
+	return FrameBuffer;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Builds the frames sent over the Wit.ai WebSocket connection. A frame is a 17 byte header made up of a flag byte and the 64 bit sizes
+ * of the JSON and binary sections followed by the sections themselves. Frames are written straight into a single buffer that is reused
+ * so steady state streaming does not allocate. The built frame is only valid until the next frame is built
+ */
+class FWitSocketFrameBuilder final
+{
+public:
+
+	/** The size of the frame header in bytes */
+	static constexpr int32 HeaderSize{17};
+
+	/**
+	 * Build a frame that only contains JSON data
+	 *
+	 * @param JsonData [in] the JSON data
+	 *
+	 * @return the frame
+	 */
+	const TArray<uint8>& BuildJsonFrame(const FString& JsonData);
+
+	/**
+	 * Build a frame that contains binary data for a request. The JSON section identifying the request is only serialized when the
+	 * request changes
+	 *
+	 * @param RequestId [in] the id of the request the data belongs to
+	 * @param BinaryData [in] the binary data
+	 * @param BinaryDataSize [in] the size of the binary data in bytes
+	 *
+	 * @return the frame
+	 */
+	const TArray<uint8>& BuildRequestFrame(const FString& RequestId, const uint8* BinaryData, const int32 BinaryDataSize);
+
+	/**
+	 * Get the number of frames built
+	 */
+	int64 GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+	/**
+	 * Get the total size of the frames built in bytes
+	 */
+	int64 GetNumBytes() const
+	{
+		return NumBytes;
+	}
+
+	/**
+	 * Get the number of times the frame buffer had to grow. This stops increasing once the buffer is large enough for the biggest frame
+	 */
+	int64 GetNumAllocations() const
+	{
+		return NumAllocations;
+	}
+
+private:
+
+	/** Write a frame into the frame buffer */
+	const TArray<uint8>& WriteFrame(const uint8* JsonData, const int32 JsonDataSize, const uint8* BinaryData, const int32 BinaryDataSize);
+
+	/** The reused frame buffer */
+	TArray<uint8> FrameBuffer{};
+
+	/** The request the cached request header was built for */
+	FString CachedRequestId{};
+
+	/** The UTF-8 JSON section identifying the cached request */
+	TArray<uint8> CachedRequestHeader{};
+
+	/** The number of frames built */
+	int64 NumFrames{0};
+
+	/** The total size of the frames built in bytes */
+	int64 NumBytes{0};
+
+	/** The number of times the frame buffer had to grow */
+	int64 NumAllocations{0};
+};
@@ -7,8 +7,11 @@
 
 #include "Wit/Socket/WitSocketSubsystem.h"
 #include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/ByteSwap.h"
+#include "Misc/EngineVersionComparison.h"
 #include "Misc/Guid.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "WebSocketsModule.h"
@@ -20,6 +23,11 @@
   */
 void UWitSocketSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+#if UE_VERSION_OLDER_THAN(5,0,0)
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UWitSocketSubsystem::Tick), TickInterval);
+#else
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UWitSocketSubsystem::Tick), TickInterval);
+#endif
 }
 
 /**
@@ -27,37 +35,62 @@ void UWitSocketSubsystem::Initialize(FSubsystemCollectionBase& Collection)
  */
 void UWitSocketSubsystem::Deinitialize()
 {
-	if (Socket)
-	{
-		Socket->Close();
-	}
+#if UE_VERSION_OLDER_THAN(5,0,0)
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#else
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#endif
+
+	bShouldBeConnected = false;
+	bIsReconnectScheduled = false;
+	SocketUsers.Empty();
+
+	DestroySocket();
 }
 
 /**
- * Create a WebSocket connection
+ * Create a WebSocket connection. The connection is kept alive and re-established after it drops until CloseSocket is called so
+ * calling this again while connected or while a reconnection is scheduled does nothing
  *
  * @param AuthToken [in] Authentication token used to establish a WebSocket connection
  */
 void UWitSocketSubsystem::CreateSocket(const FString AuthToken)
 {
-	if (Socket && Socket->IsConnected())
+	CachedAuthToken = AuthToken;
+	bShouldBeConnected = true;
+
+	if (bIsReconnectScheduled)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("CreateSocket: reconnection already scheduled"));
+		return;
+	}
+
+	if (Socket && SocketStatus != ESocketState::Disconnected)
 	{
-		UE_LOG(LogWit, Warning, TEXT("CreateSocket: Socket already connected"));
+		UE_LOG(LogWit, Verbose, TEXT("CreateSocket: Socket already connected"));
 		return;
 	}
 
+	Connect();
+}
+
+/**
+ * Start connecting the WebSocket using the cached authentication token
+ */
+void UWitSocketSubsystem::Connect()
+{
+	DestroySocket();
+
 	Socket = FWebSocketsModule::Get().CreateWebSocket(ServerURL, ServerProtocol);
+	FragmentState = EFragmentState::None;
 
-	Socket->OnConnected().AddLambda([this, AuthToken]() -> void
+	Socket->OnConnected().AddLambda([this]() -> void
 		{
 			UE_LOG(LogWit, Display, TEXT("WebSockets: Connection Success"));
 
-			std::string Encoded = Encode(std::string(("{\"wit_auth_token\": \"" + std::string(TCHAR_TO_UTF8(*AuthToken)) + "\"}")));
-
-			const bool bIsBinary = true;
 			SocketStatus = ESocketState::Connected;
 			OnSocketStateChange.Broadcast();
-			Socket->Send(reinterpret_cast<const uint8_t*>(&Encoded[0]), Encoded.length(), bIsBinary);
+			SendAuthentication();
 			SocketStatus = ESocketState::Authenticating;
 			OnSocketStateChange.Broadcast();
 		});
@@ -67,8 +100,7 @@ void UWitSocketSubsystem::CreateSocket(const FString AuthToken)
 			std::string ErrorText = std::string(TCHAR_TO_UTF8(*Error));
 			UE_LOG(LogWit, Warning, TEXT("WebSockets: Connection Failed: %s"), *FString(ErrorText.c_str()));
 
-			SocketStatus = ESocketState::Disconnected;
-			OnSocketStateChange.Broadcast();
+			OnDisconnected();
 		});
 
 	Socket->OnClosed().AddLambda(
@@ -76,9 +108,8 @@ void UWitSocketSubsystem::CreateSocket(const FString AuthToken)
 		{
 			std::string ErrorText = std::string(TCHAR_TO_UTF8(*Reason));
 			UE_LOG(LogWit, Display, TEXT("WebSockets: Connection Closed: %d %s"), StatusCode, *FString(ErrorText.c_str()));
-			bWebSocketAuthenticated = false;
-			SocketStatus = ESocketState::Disconnected;
-			OnSocketStateChange.Broadcast();
+
+			OnDisconnected();
 		});
 
 	Socket->OnMessage().AddLambda([](const FString& Message) -> void
@@ -86,306 +117,1132 @@ void UWitSocketSubsystem::CreateSocket(const FString AuthToken)
 			/* Purposefully empty as all responses are binary */
 		});
 
-	Socket->OnRawMessage().AddLambda(
-		[this](const void* Data, SIZE_T Size, SIZE_T BytesRemaining) -> void
-		{
-			UE_LOG(LogWit, Verbose, TEXT("WebSockets: Binary message received"));
-			TArray<uint8> DataArray;
-			DataArray.Append((const uint8*)Data, Size);
-
-			FString DataString;
-			std::string ResultCstr;
-			for (int i = 0; i < DataArray.Num(); i++)
-			{
-				DataString.AppendChar(DataArray[i]);
-				ResultCstr += DataArray[i];
-			}
-
-			EncodedData Encoded;
-			if (!bSynthesizeInProgress)
-			{
-				Encoded = Decode(ResultCstr);
-			}
-
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(&Encoded.JsonData[0]);
-			if (!FJsonSerializer::Deserialize(Reader, JsonObject))
-			{
-				UE_LOG(LogWit, Warning, TEXT("WebSockets: Could not parse JSON %s"), *DataString);
-			}
-
-			FString ResponseType;
-			if (JsonObject)
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Getting response type"));
-				ResponseType = JsonObject->GetStringField("type");
-			}
-
-			if (DataString.Contains("SYNTHESIZE_DATA"))
-			{
-				DataArray.Reset(0);
-				DataArray.Append(&Encoded.BinaryData[0], (Size < Encoded.BinaryData.size()) ? Size : Encoded.BinaryData.size());
-				bSynthesizeInProgress = true;
-			}
-			else if (!ResponseType.IsEmpty() && ResponseType.Equals("INITIALIZED"))
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Initialized: %s"), *DataString);
-				DataArray.Reset(0);
-				bConverseInProgress = true;
-			}
-			else if (!ResponseType.IsEmpty() && ResponseType.Equals("EXECUTION_RESULT"))
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Result: %s"), *DataString);
-				bWebSocketAuthenticated = true;
-				SocketStatus = ESocketState::Authenticated;
-				OnSocketStateChange.Broadcast();
-			}
-			else if (DataString.Contains("END_STREAM"))
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Synthesize Ended: %s"), *DataString);
-				bSynthesizeInProgress = false;
-				OnSocketStreamComplete.Broadcast();
-			}
-			else if (!ResponseType.IsEmpty() && ResponseType.Equals("END_TRANSCRIPTION"))
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Synthesize Ended: %s"), *DataString);
-				bConverseInProgress = false;
-				OnSocketStreamComplete.Broadcast();
-			}
-			else if (!ResponseType.IsEmpty() && ResponseType.Equals("PARTIAL_TRANSCRIPTION"))
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Partial Transcription: %s"), *DataString);
-				TArray<unsigned char> BinaryData;
-				BinaryData.Append(&Encoded.BinaryData[0], Encoded.BinaryData.size());
-
-				OnSocketStreamProgress.Broadcast(BinaryData, JsonObject);			
-			}
-			else if (!ResponseType.IsEmpty() && ResponseType.Equals("FINAL_TRANSCRIPTION"))
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Transcription Ended: %s"), *DataString);
-				bSynthesizeInProgress = false;
-				OnSocketStreamComplete.Broadcast();
-			}
-			else
-			{
-				UE_LOG(LogWit, Verbose, TEXT("WebSockets: Undefined message: %s"), *DataString);
-			}
-			if (bSynthesizeInProgress || (bConverseInProgress && DataArray.Num() > 0))
-			{
-				OnSocketStreamProgress.Broadcast(DataArray, nullptr);
-			}
-
-		});
+	Socket->OnRawMessage().AddUObject(this, &UWitSocketSubsystem::OnRawMessage);
 
 	Socket->OnMessageSent().AddLambda([](const FString& MessageString) -> void
 		{
 			UE_LOG(LogWit, Verbose, TEXT("WebSockets: Message sent %s"), *MessageString);
 		});
 
+	ConnectStartTime = FPlatformTime::Seconds();
+	++ConnectionStats.NumConnects;
+
 	Socket->Connect();
 	SocketStatus = ESocketState::Connecting;
 	OnSocketStateChange.Broadcast();
 }
 
-void UWitSocketSubsystem::CloseSocket()
+/**
+ * Unbind from and close the current WebSocket if there is one. Nothing is broadcast since the socket is being replaced or shut down
+ */
+void UWitSocketSubsystem::DestroySocket()
 {
-	if (Socket && Socket->IsConnected())
+	if (!Socket)
+	{
+		return;
+	}
+
+	Socket->OnConnected().Clear();
+	Socket->OnConnectionError().Clear();
+	Socket->OnClosed().Clear();
+	Socket->OnMessage().Clear();
+	Socket->OnRawMessage().Clear();
+	Socket->OnMessageSent().Clear();
+
+	if (Socket->IsConnected())
 	{
 		Socket->Close();
 	}
-	bSynthesizeInProgress = false;
-	bConverseInProgress = false;
+
+	Socket.Reset();
+
+	bWebSocketAuthenticated = false;
+	bIsPingInFlight = false;
+	bIsPingAnswered = false;
+	SocketStatus = ESocketState::Disconnected;
 }
 
 /**
- * Checks if there is an active synthesize request in progress
- *
- * @return Is there a synethesize currently in progress
+ * Send the authentication message
  */
-bool UWitSocketSubsystem::IsSynthesizeInProgress()
+void UWitSocketSubsystem::SendAuthentication()
 {
-	return bSynthesizeInProgress;
+	const TArray<uint8>& Frame = FrameBuilder.BuildJsonFrame(TEXT("{\"wit_auth_token\": \"") + CachedAuthToken + TEXT("\"}"));
+
+	Socket->Send(Frame.GetData(), Frame.Num(), true);
+
+	LastActivityTime = FPlatformTime::Seconds();
 }
 
 /**
- * Checks if there is an active synthesize request in progress
- *
- * @return Is there a synethesize currently in progress
+ * Send a keep-alive ping. The ping is a frame that only carries a fresh client_request_id so the auth token is never re-sent. We do not
+ * rely on the server answering it in any particular way since anything received afterwards shows the connection is alive
  */
-bool UWitSocketSubsystem::IsConverseInProgress()
+void UWitSocketSubsystem::SendPing()
 {
-	return bConverseInProgress;
+	bIsPingInFlight = true;
+	PingSendTime = FPlatformTime::Seconds();
+
+	const TArray<uint8>& Frame = FrameBuilder.BuildJsonFrame(TEXT("{\"client_request_id\": \"") + FGuid::NewGuid().ToString() + TEXT("\"}"));
+
+	Socket->Send(Frame.GetData(), Frame.Num(), true);
+
+	LastActivityTime = PingSendTime;
 }
 
 /**
- * Checks the current status of the WebSocket connection
- *
- * @return Current state of the WebSocket connection
+ * Called when anything is received while a keep-alive ping is waiting to be answered
  */
-ESocketState UWitSocketSubsystem::GetSocketState()
+void UWitSocketSubsystem::OnPong()
 {
-	return SocketStatus;
+	bIsPingInFlight = false;
+	bIsPingAnswered = true;
+	ConnectionStats.LastPingRoundTripTime = FPlatformTime::Seconds() - PingSendTime;
+
+	UE_LOG(LogWit, VeryVerbose, TEXT("WebSockets: keep-alive round trip (%.3f) seconds"), ConnectionStats.LastPingRoundTripTime);
 }
 
 /**
- * Send binary data across an active WebSocket connection
+ * Called when the connection fails or closes. Requests that were already sent cannot complete so they are failed while requests that
+ * are still queued wait for the reconnection
+ */
+void UWitSocketSubsystem::OnDisconnected()
+{
+	bWebSocketAuthenticated = false;
+	bIsPingInFlight = false;
+	bIsPingAnswered = false;
+
+	// Remove the failed requests before calling out so the callbacks are free to start new requests
+
+	const bool bShouldIncludeQueued = false;
+	const TArray<FRequest> FailedRequests = RemoveRequests(bShouldIncludeQueued);
+
+	SynthesizingRequestId.Reset();
+	FragmentState = EFragmentState::None;
+
+	// The reconnection is scheduled before we broadcast so that anyone asking to reconnect in response waits for the backoff
+
+	if (bShouldBeConnected)
+	{
+		ScheduleReconnect();
+	}
+
+	SocketStatus = ESocketState::Disconnected;
+
+	FailRequests(FailedRequests, TEXT("Connection closed"), TEXT("The WebSocket connection closed while the request was in progress"));
+
+	OnSocketStateChange.Broadcast();
+}
+
+/**
+ * Remove the requests that are in progress
  *
- * @param Data [in] binary data to send over connection
+ * @param bShouldIncludeQueued [in] should requests that are still waiting to be sent be removed too?
+ *
+ * @return the removed requests
  */
-void UWitSocketSubsystem::SendBinaryData(const TArray<uint8>& Data)
+TArray<UWitSocketSubsystem::FRequest> UWitSocketSubsystem::RemoveRequests(const bool bShouldIncludeQueued)
 {
-	const int32 NumBytesToCopy = Data.Num();
+	TArray<FRequest> RemovedRequests;
 
-	if (NumBytesToCopy <= 0)
+	for (auto It = Requests.CreateIterator(); It; ++It)
+	{
+		if (bShouldIncludeQueued || !It.Value().bIsQueued)
+		{
+			UE_LOG(LogWit, Warning, TEXT("WebSockets: failing request (%s) that was in progress when the connection closed"), *It.Key());
+
+			RemovedRequests.Add(MoveTemp(It.Value()));
+			It.RemoveCurrent();
+		}
+	}
+
+	return RemovedRequests;
+}
+
+/**
+ * Report the failure of requests that have already been removed. Each request's error callback is called or its complete callback if
+ * it has none
+ *
+ * @param FailedRequests [in] the requests that failed
+ * @param ErrorMessage [in] the error message
+ * @param HumanReadableErrorMessage [in] a human readable version of the error message
+ */
+void UWitSocketSubsystem::FailRequests(const TArray<FRequest>& FailedRequests, const FString& ErrorMessage, const FString& HumanReadableErrorMessage)
+{
+	if (FailedRequests.Num() == 0)
 	{
-		UE_LOG(LogWit, Warning, TEXT("SendBinaryData: No Data to Copy"));
 		return;
 	}
 
-	if (!Socket->IsConnected())
+	for (const FRequest& FailedRequest : FailedRequests)
+	{
+		if (FailedRequest.OnError.IsBound())
+		{
+			FailedRequest.OnError.Execute(ErrorMessage, HumanReadableErrorMessage);
+		}
+		else
+		{
+			FailedRequest.OnComplete.ExecuteIfBound();
+		}
+	}
+
+	OnSocketStreamError.Broadcast(ErrorMessage, HumanReadableErrorMessage);
+}
+
+/**
+ * Schedule a reconnection after an exponential backoff. The delay is jittered so many clients dropped at the same time do not all
+ * reconnect at once
+ */
+void UWitSocketSubsystem::ScheduleReconnect()
+{
+	const float MaximumDelay = FMath::Min(MaximumReconnectDelay, InitialReconnectDelay * FMath::Pow(2.0f, static_cast<float>(NumReconnectAttempts)));
+	const float Delay = FMath::FRandRange(MaximumDelay * 0.5f, MaximumDelay);
+
+	NumReconnectAttempts = FMath::Min(NumReconnectAttempts + 1, 16);
+
+	ReconnectTime = FPlatformTime::Seconds() + Delay;
+	bIsReconnectScheduled = true;
+
+	UE_LOG(LogWit, Display, TEXT("WebSockets: reconnecting in (%.2f) seconds"), Delay);
+}
+
+/**
+ * Called when Wit.ai confirms the authentication
+ */
+void UWitSocketSubsystem::OnAuthenticated()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (SocketStatus == ESocketState::Authenticated)
 	{
-		UE_LOG(LogWit, Warning, TEXT("SendBinaryData: Not Connected"));
 		return;
 	}
 
-	if (bWebSocketAuthenticated)
+	ConnectionStats.LastConnectLatency = Now - ConnectStartTime;
+	ConnectionStats.TotalConnectLatency += ConnectionStats.LastConnectLatency;
+	++ConnectionStats.NumSuccessfulConnects;
+
+	if (NumReconnectAttempts > 0)
+	{
+		++ConnectionStats.NumReconnects;
+	}
+
+	NumReconnectAttempts = 0;
+
+	UE_LOG(LogWit, Verbose, TEXT("WebSockets: authenticated in (%.3f) seconds"), ConnectionStats.LastConnectLatency);
+
+	bWebSocketAuthenticated = true;
+	SocketStatus = ESocketState::Authenticated;
+
+	SendQueuedRequests();
+
+	OnSocketStateChange.Broadcast();
+}
+
+/**
+ * Send the requests that were made while we were not authenticated in the order they were made
+ */
+void UWitSocketSubsystem::SendQueuedRequests()
+{
+	TArray<TPair<uint32, FString>> QueuedRequestIds;
+
+	for (const TPair<FString, FRequest>& Request : Requests)
 	{
-		std::vector<unsigned char> SendData;
-		for (int i = 0; i < Data.Num(); i++)
+		if (Request.Value.bIsQueued)
 		{
-			SendData.push_back(Data[i]);
+			QueuedRequestIds.Emplace(Request.Value.SequenceNumber, Request.Key);
 		}
+	}
 
-		const TSharedPtr<FJsonObject> RequestData = MakeShared<FJsonObject>();
-		RequestData->SetStringField("client_request_id", RequestId);
+	QueuedRequestIds.Sort([](const TPair<uint32, FString>& A, const TPair<uint32, FString>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (const TPair<uint32, FString>& QueuedRequestId : QueuedRequestIds)
+	{
+		FRequest& Request = Requests[QueuedRequestId.Value];
+
+		UE_LOG(LogWit, Verbose, TEXT("SendQueuedRequests: sending queued request (%s)"), *QueuedRequestId.Value);
 
-		FString StringMessage;
-		TSharedRef< TJsonWriter<> > Writer = TJsonWriterFactory<>::Create(&StringMessage);
-		FJsonSerializer::Serialize(RequestData.ToSharedRef(), Writer);
+		const TArray<uint8>& Frame = FrameBuilder.BuildJsonFrame(Request.QueuedMessage);
+		Socket->Send(Frame.GetData(), Frame.Num(), true);
 
-		std::string Message = Encode(std::string(TCHAR_TO_UTF8(*StringMessage)), SendData);
-		UE_LOG(LogWit, Verbose, TEXT("SendBinaryData: Message %d"), Message.length());
-		Socket->Send(reinterpret_cast<const uint8_t*>(&Message[0]), Message.length(), true);
+		Request.bIsQueued = false;
+		Request.QueuedMessage.Empty();
+
+		++ConnectionStats.NumQueuedRequestsSent;
 	}
-	else
+
+	if (QueuedRequestIds.Num() > 0)
 	{
-		UE_LOG(LogWit, Warning, TEXT("WebSockets: WebSocket not authenticated"));
+		LastActivityTime = FPlatformTime::Seconds();
 	}
 }
 
 /**
- * Send JSON data across an active WebSocket connection
+ * Drive reconnection and keep-alive
  *
- * @param Data [in] JSON data to send over connection
+ * @param DeltaTime [in] the time since the last tick
+ *
+ * @return true to keep ticking
  */
-void UWitSocketSubsystem::SendJsonData(const ERequestType Type, const TSharedRef<FJsonObject> RequestBody)
+bool UWitSocketSubsystem::Tick(float DeltaTime)
 {
-	if (!Socket->IsConnected())
+	const double Now = FPlatformTime::Seconds();
+
+	if (bIsReconnectScheduled && Now >= ReconnectTime)
 	{
-		UE_LOG(LogWit, Warning, TEXT("SendJsonData: Not Connected"));
-		return;
+		bIsReconnectScheduled = false;
+
+		if (bShouldBeConnected)
+		{
+			Connect();
+		}
+
+		return true;
 	}
 
-	if (bWebSocketAuthenticated)
+	if (SocketStatus != ESocketState::Authenticated || !Socket)
 	{
-		const TSharedPtr<FJsonObject> RequestData = MakeShared<FJsonObject>();
-		const TSharedPtr<FJsonObject> RequestSynth = MakeShared<FJsonObject>();
-		const FGuid Guid = FGuid();
-		switch (Type)
+		return true;
+	}
+
+	if (bIsPingInFlight)
+	{
+		if (Now - PingSendTime < KeepAliveTimeout)
+		{
+			return true;
+		}
+
+		++ConnectionStats.NumPingTimeouts;
+
+		// A server that has never answered a ping may simply not answer them so we only give up on a connection that used to
+
+		if (bIsPingAnswered)
 		{
-			case ERequestType::Converse:
-				RequestSynth->SetObjectField("converse", RequestBody);
-				break;
-			case ERequestType::Synthesize:
-				RequestSynth->SetObjectField("synthesize", RequestBody);
-				break;
-			default:
-				break;
+			UE_LOG(LogWit, Warning, TEXT("WebSockets: keep-alive timed out, reconnecting"));
+
+			DestroySocket();
+			OnDisconnected();
+
+			return true;
 		}
-		RequestData->SetObjectField("data", RequestSynth);
-		RequestId = Guid.NewGuid().ToString();
-		RequestData->SetStringField("client_request_id", RequestId);
 
-		FString StringMessage;
-		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&StringMessage);
-		FJsonSerializer::Serialize(RequestData.ToSharedRef(), Writer);
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: keep-alive was not answered"));
 
-		std::string Message = Encode(std::string(TCHAR_TO_UTF8(*StringMessage)));
-		Socket->Send(reinterpret_cast<const uint8_t*>(&Message[0]), Message.length(), true);
+		bIsPingInFlight = false;
 	}
-	else
+
+	// Only ping an idle connection. Traffic for requests already shows the connection is alive
+
+	const bool bIsIdle = Requests.Num() == 0 && Now - LastActivityTime >= KeepAliveInterval;
+
+	if (bIsIdle)
 	{
-		UE_LOG(LogWit, Warning, TEXT("WebSockets: WebSocket not authenticated"));
+		SendPing();
+	}
+
+	return true;
+}
+
+/**
+ * Close a WebSocket connection. The connection is not re-established until CreateSocket is called again and any requests still in
+ * progress are failed
+ */
+void UWitSocketSubsystem::CloseSocket()
+{
+	UE_LOG(LogWit, Verbose, TEXT("CloseSocket: sent (%lld) frames totalling (%lld) bytes with (%lld) frame buffer allocations"), FrameBuilder.GetNumFrames(),
+		FrameBuilder.GetNumBytes(), FrameBuilder.GetNumAllocations());
+
+	UE_LOG(LogWit, Verbose, TEXT("CloseSocket: (%d) connects (%d) reconnects average connect latency (%.3f) seconds"), ConnectionStats.NumConnects,
+		ConnectionStats.NumReconnects, ConnectionStats.GetAverageConnectLatency());
+
+	bShouldBeConnected = false;
+	bIsReconnectScheduled = false;
+	NumReconnectAttempts = 0;
+
+	if (Socket && Socket->IsConnected())
+	{
+		Socket->Close();
+	}
+
+	const bool bShouldIncludeQueued = true;
+	const TArray<FRequest> ClosedRequests = RemoveRequests(bShouldIncludeQueued);
+
+	SynthesizingRequestId.Reset();
+	FragmentState = EFragmentState::None;
+
+	FailRequests(ClosedRequests, TEXT("Connection closed"), TEXT("The WebSocket connection was closed before the request finished"));
+}
+
+/**
+ * Register a user of the shared connection and make sure it is connecting. The connection stays open while it has any users
+ *
+ * @param User [in] the object using the connection
+ * @param AuthToken [in] Authentication token used to establish a WebSocket connection
+ */
+void UWitSocketSubsystem::AddSocketUser(const UObject* User, const FString& AuthToken)
+{
+	if (User == nullptr)
+	{
+		return;
+	}
+
+	SocketUsers.Add(FObjectKey(User));
+
+	CreateSocket(AuthToken);
+}
+
+/**
+ * Unregister a user of the shared connection. The connection is closed once its last user is removed
+ *
+ * @param User [in] the object that was using the connection
+ */
+void UWitSocketSubsystem::RemoveSocketUser(const UObject* User)
+{
+	const int32 NumRemoved = SocketUsers.Remove(FObjectKey(User));
+
+	if (NumRemoved == 0 || SocketUsers.Num() > 0)
+	{
+		return;
 	}
+
+	UE_LOG(LogWit, Verbose, TEXT("RemoveSocketUser: last user removed, closing the connection"));
+
+	CloseSocket();
 }
 
 /**
- * Encodes data to send over the WebSocket connection
+ * Get the connection statistics
  *
- * @param JsonData [in] JSON data to send over the WebSocket connection
- * @param BinaryData [in] binary data to send over the WebSocket connection
+ * @return the statistics
+ */
+const FWitSocketConnectionStats& UWitSocketSubsystem::GetConnectionStats() const
+{
+	return ConnectionStats;
+}
+
+/**
+ * Checks if there is an active synthesize request in progress
+ *
+ * @return Is there a synethesize currently in progress
  */
-std::string UWitSocketSubsystem::Encode(
-	const std::string& JsonData,
-	const std::vector<unsigned char>& BinaryData)
+bool UWitSocketSubsystem::IsSynthesizeInProgress()
 {
-	uint8_t Flag = 0;
-	if (!BinaryData.empty())
+	for (const TPair<FString, FRequest>& Request : Requests)
 	{
-		Flag |= 1 << 0;
-		Flag |= 1 << 1;
+		if (Request.Value.Type == ERequestType::Synthesize)
+		{
+			return true;
+		}
 	}
-	else {
-		Flag |= 1 << 1;
+
+	return false;
+}
+
+/**
+ * Checks if there is an active converse request in progress
+ *
+ * @return Is there a converse currently in progress
+ */
+bool UWitSocketSubsystem::IsConverseInProgress()
+{
+	for (const TPair<FString, FRequest>& Request : Requests)
+	{
+		if (Request.Value.Type == ERequestType::Converse && Request.Value.bIsConverseInitialized)
+		{
+			return true;
+		}
 	}
 
-	size_t JsonStrSize = JsonData.length() * sizeof(char);
-	size_t BinaryDataSize = BinaryData.size();
+	return false;
+}
+
+/**
+ * Checks if a specific request is in progress
+ *
+ * @param RequestId [in] the id of the request returned by SendJsonData
+ *
+ * @return Is the request currently in progress
+ */
+bool UWitSocketSubsystem::IsRequestInProgress(const FString& RequestId) const
+{
+	return !RequestId.IsEmpty() && Requests.Contains(RequestId);
+}
 
-	std::vector<unsigned char> Result;
-	Result.resize(1 + 8 + 8 + JsonStrSize + BinaryDataSize);
+/**
+ * Checks if a specific converse request has been initialized by Wit.ai and is ready for audio
+ *
+ * @param RequestId [in] the id of the request returned by SendJsonData
+ *
+ * @return Is the converse ready for audio
+ */
+bool UWitSocketSubsystem::IsConverseInProgress(const FString& RequestId) const
+{
+	const FRequest* Request = Requests.Find(RequestId);
 
-	Result[0] = Flag;
-	std::memcpy(&Result[1], &JsonStrSize, sizeof(JsonStrSize));
-	std::memcpy(&Result[9], &BinaryDataSize, sizeof(BinaryDataSize));
-	std::memcpy(&Result[17], JsonData.c_str(), JsonStrSize);
-	std::memcpy(&Result[17 + JsonStrSize], BinaryData.data(), BinaryDataSize);
+	return Request != nullptr && Request->Type == ERequestType::Converse && Request->bIsConverseInitialized;
+}
 
-	return std::string(reinterpret_cast<const char*>(Result.data()), Result.size());
+/**
+ * Checks the current status of the WebSocket connection
+ *
+ * @return Current state of the WebSocket connection
+ */
+ESocketState UWitSocketSubsystem::GetSocketState()
+{
+	return SocketStatus;
 }
 
 /**
- * Decodes data received over the WebSocket connection
+ * Send binary data across an active WebSocket connection
  *
- * @param Message [in] data returned from WebSocket connection
- * @return Data from WebSocket parsed into an EncodedData struct
+ * @param RequestId [in] the id of the request the data belongs to
+ * @param Data [in] binary data to send over connection
  */
-EncodedData UWitSocketSubsystem::Decode(const std::string Message)
+void UWitSocketSubsystem::SendBinaryData(const FString& RequestId, const TArray<uint8>& Data)
 {
-	EncodedData Decoded;
+	const int32 NumBytesToCopy = Data.Num();
+
+	if (NumBytesToCopy <= 0)
+	{
+		UE_LOG(LogWit, Warning, TEXT("SendBinaryData: No Data to Copy"));
+		return;
+	}
 
-	if (Message.size() < 17)
+	if (!Socket || !Socket->IsConnected())
 	{
-		UE_LOG(LogWit, Warning, TEXT("WebSockets: Message not a valid size"));
-		return EncodedData{};
+		UE_LOG(LogWit, Warning, TEXT("SendBinaryData: Not Connected"));
+		return;
 	}
 
-	// Read the length of the JSON data section
-	uint32_t JsonDataSize =
-		*reinterpret_cast<const uint32_t*>(Message.data() + 1);
+	const FRequest* Request = Requests.Find(RequestId);
 
-	// Read the length of the binary data section
-	uint32_t BinaryDataSize =
-		*reinterpret_cast<const uint32_t*>(Message.data() + 9);
+	if (Request == nullptr || Request->bIsQueued)
+	{
+		UE_LOG(LogWit, Warning, TEXT("SendBinaryData: Request (%s) is not in progress"), *RequestId);
+		return;
+	}
+
+	if (bWebSocketAuthenticated)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UWitSocketSubsystem::SendBinaryData);
+
+		// The frame is built straight from the voice buffer into a reused send buffer so streaming audio does not allocate
+
+		const TArray<uint8>& Frame = FrameBuilder.BuildRequestFrame(RequestId, Data.GetData(), NumBytesToCopy);
+
+		UE_LOG(LogWit, Verbose, TEXT("SendBinaryData: Message %d"), Frame.Num());
+		Socket->Send(Frame.GetData(), Frame.Num(), true);
+
+		LastActivityTime = FPlatformTime::Seconds();
+	}
+	else
+	{
+		UE_LOG(LogWit, Warning, TEXT("WebSockets: WebSocket not authenticated"));
+	}
+}
+
+/**
+ * Send JSON data across an active WebSocket connection to start a new request. Responses are routed to the request by their
+ * client_request_id so several requests can share the connection
+ *
+ * @param Type [in] Type of request to send over connection
+ * @param RequestBody [in] JSON data to send over connection
+ * @param OnProgress [in] optional callback for this request's progress
+ * @param OnComplete [in] optional callback for when this request completes
+ * @param OnError [in] optional callback for when this request fails. If not bound a failed request calls OnComplete instead
+ * @param MinimumSynthesizeDataSize [in] synthesize audio is gathered until there is at least this many bytes before it is forwarded
+ *
+ * @return the id of the request or empty if it could not be sent
+ */
+FString UWitSocketSubsystem::SendJsonData(const ERequestType Type, const TSharedRef<FJsonObject> RequestBody, FOnWitSocketRequestProgressDelegate OnProgress,
+	FOnWitSocketRequestCompleteDelegate OnComplete, FOnWitSocketRequestErrorDelegate OnError, const int32 MinimumSynthesizeDataSize)
+{
+	const TSharedPtr<FJsonObject> RequestData = MakeShared<FJsonObject>();
+	const TSharedPtr<FJsonObject> RequestSynth = MakeShared<FJsonObject>();
+	const FGuid Guid = FGuid();
+	switch (Type)
+	{
+		case ERequestType::Converse:
+			RequestSynth->SetObjectField("converse", RequestBody);
+			break;
+		case ERequestType::Synthesize:
+			RequestSynth->SetObjectField("synthesize", RequestBody);
+			break;
+		default:
+			break;
+	}
+	RequestData->SetObjectField("data", RequestSynth);
+	const FString RequestId = Guid.NewGuid().ToString();
+	RequestData->SetStringField("client_request_id", RequestId);
+
+	FString StringMessage;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&StringMessage);
+	FJsonSerializer::Serialize(RequestData.ToSharedRef(), Writer);
+
+	FRequest& Request = Requests.Add(RequestId);
+
+	Request.Type = Type;
+	Request.SequenceNumber = NextRequestSequenceNumber++;
+	Request.OnProgress = MoveTemp(OnProgress);
+	Request.OnComplete = MoveTemp(OnComplete);
+	Request.OnError = MoveTemp(OnError);
+	Request.MinimumSynthesizeDataSize = MinimumSynthesizeDataSize;
+
+	// Requests made while we are not authenticated are queued and sent in order once we are
+
+	const bool bCanSend = bWebSocketAuthenticated && Socket && Socket->IsConnected();
+
+	if (!bCanSend)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("SendJsonData: queued request (%s) until the WebSocket is authenticated"), *RequestId);
+
+		Request.bIsQueued = true;
+		Request.QueuedMessage = MoveTemp(StringMessage);
+
+		if (!bShouldBeConnected)
+		{
+			UE_LOG(LogWit, Warning, TEXT("SendJsonData: WebSocket has not been created so the request will wait until it is"));
+		}
+		else if (SocketStatus == ESocketState::Disconnected && !bIsReconnectScheduled)
+		{
+			Connect();
+		}
+
+		return RequestId;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("SendJsonData: started request (%s) with (%d) requests in progress"), *RequestId, Requests.Num());
+
+	const TArray<uint8>& Frame = FrameBuilder.BuildJsonFrame(StringMessage);
+	Socket->Send(Frame.GetData(), Frame.Num(), true);
+
+	LastActivityTime = FPlatformTime::Seconds();
+
+	return RequestId;
+}
+
+/**
+ * Stop routing responses to a request. Any further responses for it are ignored
+ *
+ * @param RequestId [in] the id of the request returned by SendJsonData
+ */
+void UWitSocketSubsystem::CancelRequest(const FString& RequestId)
+{
+	if (RequestId.IsEmpty())
+	{
+		return;
+	}
+
+	Requests.Remove(RequestId);
+
+	if (SynthesizingRequestId.Equals(RequestId))
+	{
+		SynthesizingRequestId.Reset();
+	}
+}
+
+/**
+ * Handle a message or message fragment received over the WebSocket connection. Whole messages are decoded in place. Fragmented messages
+ * are reassembled in a buffer that is reused across messages unless they carry synthesize data and streaming is enabled, in which case
+ * the audio is forwarded as each fragment arrives
+ *
+ * @param Data [in] the received data
+ * @param Size [in] the size of the received data in bytes
+ * @param BytesRemaining [in] the number of bytes of the message still to be received
+ */
+void UWitSocketSubsystem::OnRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UWitSocketSubsystem::OnRawMessage);
+
+	const TArrayView<const uint8> Fragment(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+
+	LastActivityTime = FPlatformTime::Seconds();
+
+	// Anything from the server shows the connection is alive so it answers an outstanding keep-alive ping
+
+	if (bIsPingInFlight)
+	{
+		OnPong();
+	}
+
+	const bool bIsFirstFragment = FragmentState == EFragmentState::None;
+	const bool bIsLastFragment = BytesRemaining == 0;
+
+	if (bIsFirstFragment && bIsLastFragment)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Binary message received"));
+		HandleMessage(Fragment);
+		return;
+	}
+
+	if (bIsFirstFragment)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Fragmented binary message received (%llu) bytes"), static_cast<uint64>(Size + BytesRemaining));
+
+		ReassemblyBuffer.Reset();
+		PendingJsonObject.Reset();
+		PendingResponseType.Reset();
+
+		FragmentState = bShouldStreamSynthesizeData ? EFragmentState::WaitingForJson : EFragmentState::Buffering;
+	}
+
+	if (FragmentState == EFragmentState::Streaming)
+	{
+		StreamSynthesizeData(SynthesizingRequestId, Fragment);
+	}
+	else
+	{
+		ReassemblyBuffer.Append(Fragment.GetData(), Fragment.Num());
+	}
+
+	if (FragmentState == EFragmentState::WaitingForJson)
+	{
+		TryBeginStreaming();
+	}
+
+	if (!bIsLastFragment)
+	{
+		return;
+	}
+
+	const EFragmentState FinalState = FragmentState;
+	FragmentState = EFragmentState::None;
+
+	if (FinalState == EFragmentState::Streaming)
+	{
+		return;
+	}
+
+	// The JSON section may already have been parsed while we were waiting to see if the message could be streamed
+
+	FWitSocketFrameView Frame;
+
+	if (PendingJsonObject.IsValid() && Decode(ReassemblyBuffer.GetData(), ReassemblyBuffer.Num(), Frame))
+	{
+		HandleFrame(Frame, PendingJsonObject.ToSharedRef(), PendingResponseType);
+	}
+	else
+	{
+		HandleMessage(ReassemblyBuffer);
+	}
+
+	PendingJsonObject.Reset();
+}
+
+/**
+ * Check whether enough of a fragmented message has been received to know what it is. Synthesize data is handled straight away and the
+ * rest of the message is streamed. Anything else is buffered until the whole message has been received
+ */
+void UWitSocketSubsystem::TryBeginStreaming()
+{
+	uint64 JsonDataSize = 0;
+	uint64 BinaryDataSize = 0;
+
+	const bool bHasHeader = ReadFrameHeader(ReassemblyBuffer.GetData(), ReassemblyBuffer.Num(), JsonDataSize, BinaryDataSize);
+	const bool bHasJson = bHasHeader && JsonDataSize <= static_cast<uint64>(ReassemblyBuffer.Num() - FWitSocketFrameBuilder::HeaderSize);
+
+	if (!bHasJson)
+	{
+		return;
+	}
+
+	FragmentState = EFragmentState::Buffering;
+
+	FWitSocketFrameView Frame;
+
+	if (!Decode(ReassemblyBuffer.GetData(), ReassemblyBuffer.Num(), Frame) || !ParseFrameJson(Frame, PendingJsonObject, PendingResponseType))
+	{
+		PendingJsonObject.Reset();
+		return;
+	}
+
+	if (!PendingResponseType.Equals(TEXT("SYNTHESIZE_DATA")))
+	{
+		return;
+	}
+
+	HandleFrame(Frame, PendingJsonObject.ToSharedRef(), PendingResponseType);
+
+	FragmentState = EFragmentState::Streaming;
+
+	ReassemblyBuffer.Reset();
+	PendingJsonObject.Reset();
+}
+
+/**
+ * Handle a complete message received over the WebSocket connection
+ *
+ * @param Message [in] the message
+ */
+void UWitSocketSubsystem::HandleMessage(TArrayView<const uint8> Message)
+{
+	FWitSocketFrameView Frame;
+
+	if (!Decode(Message.GetData(), Message.Num(), Frame))
+	{
+		// Audio that arrives as separate unframed messages while we are synthesizing is passed straight through
+
+		if (!SynthesizingRequestId.IsEmpty())
+		{
+			StreamSynthesizeData(SynthesizingRequestId, Message);
+		}
+
+		return;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	FString ResponseType;
+
+	if (ParseFrameJson(Frame, JsonObject, ResponseType))
+	{
+		HandleFrame(Frame, JsonObject.ToSharedRef(), ResponseType);
+	}
+}
+
+/**
+ * Handle a decoded frame. The binary section may only be the start of the data if the rest of the message is being streamed
+ *
+ * @param Frame [in] the frame
+ * @param JsonObject [in] the parsed JSON section
+ * @param ResponseType [in] the type of the response
+ */
+void UWitSocketSubsystem::HandleFrame(const FWitSocketFrameView& Frame, const TSharedRef<FJsonObject>& JsonObject, const FString& ResponseType)
+{
+	const FString RequestId = FindRequestId(JsonObject, ResponseType);
+	FRequest* Request = Requests.Find(RequestId);
+
+	if (ResponseType.Equals(TEXT("SYNTHESIZE_DATA")))
+	{
+		UE_LOG(LogWit, VeryVerbose, TEXT("WebSockets: Synthesize data (%d) bytes for (%s)"), Frame.BinaryData.Num(), *RequestId);
+		SynthesizingRequestId = RequestId;
+		StreamSynthesizeData(RequestId, Frame.BinaryData);
+	}
+	else if (ResponseType.Equals(TEXT("INITIALIZED")))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Initialized: %s"), *GetJsonText(Frame));
+
+		if (Request != nullptr)
+		{
+			Request->bIsConverseInitialized = true;
+		}
+	}
+	else if (ResponseType.Equals(TEXT("EXECUTION_RESULT")))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Result: %s"), *GetJsonText(Frame));
+		OnAuthenticated();
+	}
+	else if (ResponseType.Equals(TEXT("END_STREAM")))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Synthesize Ended: %s"), *GetJsonText(Frame));
+
+		if (SynthesizingRequestId.Equals(RequestId))
+		{
+			SynthesizingRequestId.Reset();
+		}
+
+		FlushSynthesizeData(RequestId);
+		CompleteRequest(RequestId);
+	}
+	else if (ResponseType.Equals(TEXT("END_TRANSCRIPTION")))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Transcription Ended: %s"), *GetJsonText(Frame));
+		CompleteRequest(RequestId);
+	}
+	else if (ResponseType.Equals(TEXT("PARTIAL_TRANSCRIPTION")))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Partial Transcription: %s"), *GetJsonText(Frame));
+		BroadcastProgress(Request, Frame.BinaryData, JsonObject);
+	}
+	else if (ResponseType.Equals(TEXT("FINAL_TRANSCRIPTION")))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Transcription Ended: %s"), *GetJsonText(Frame));
+
+		// The converse takes no more audio once the transcription is final but it is not complete until the transcription ends
+
+		if (Request != nullptr)
+		{
+			Request->bIsConverseInitialized = false;
+		}
+
+		OnSocketStreamComplete.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Undefined message: %s"), *GetJsonText(Frame));
+	}
+}
+
+/**
+ * Find the request a response belongs to. Responses normally carry the client_request_id we sent. If one does not we fall back to the
+ * oldest request of the type the response belongs to
+ *
+ * @param JsonObject [in] the parsed JSON section of the response
+ * @param ResponseType [in] the type of the response
+ *
+ * @return the id of the request or empty if there is none
+ */
+FString UWitSocketSubsystem::FindRequestId(const TSharedRef<FJsonObject>& JsonObject, const FString& ResponseType) const
+{
+	FString RequestId;
+
+	if (JsonObject->TryGetStringField(TEXT("client_request_id"), RequestId) && Requests.Contains(RequestId))
+	{
+		return RequestId;
+	}
+
+	const bool bIsSynthesizeResponse = ResponseType.Equals(TEXT("SYNTHESIZE_DATA")) || ResponseType.Equals(TEXT("END_STREAM"));
+	const ERequestType RequestType = bIsSynthesizeResponse ? ERequestType::Synthesize : ERequestType::Converse;
+
+	if (bIsSynthesizeResponse && Requests.Contains(SynthesizingRequestId))
+	{
+		return SynthesizingRequestId;
+	}
+
+	const FRequest* OldestRequest = nullptr;
+	RequestId.Reset();
+
+	for (const TPair<FString, FRequest>& Request : Requests)
+	{
+		const bool bIsOlder = OldestRequest == nullptr || Request.Value.SequenceNumber < OldestRequest->SequenceNumber;
+
+		if (Request.Value.Type == RequestType && bIsOlder)
+		{
+			OldestRequest = &Request.Value;
+			RequestId = Request.Key;
+		}
+	}
+
+	return RequestId;
+}
+
+/**
+ * Remove a request that has completed and notify its listeners. The request is removed before the callbacks are called so that they
+ * can start a new request
+ *
+ * @param RequestId [in] the id of the request
+ */
+void UWitSocketSubsystem::CompleteRequest(const FString& RequestId)
+{
+	FRequest Request;
+
+	if (Requests.RemoveAndCopyValue(RequestId, Request))
+	{
+		UE_LOG(LogWit, Verbose, TEXT("CompleteRequest: completed request (%s) with (%d) requests in progress"), *RequestId, Requests.Num());
+		Request.OnComplete.ExecuteIfBound();
+	}
+
+	OnSocketStreamComplete.Broadcast();
+}
+
+/**
+ * Forward progress to the listeners of a request and to the listeners of every request
+ *
+ * @param Request [in] the request or null if it is not known
+ * @param BinaryData [in] the binary data
+ * @param JsonObject [in] the JSON data if any
+ */
+void UWitSocketSubsystem::BroadcastProgress(const FRequest* Request, TArrayView<const uint8> BinaryData, const TSharedPtr<FJsonObject>& JsonObject)
+{
+	if (Request != nullptr)
+	{
+		Request->OnProgress.ExecuteIfBound(BinaryData, JsonObject);
+	}
+
+	OnSocketStreamProgress.Broadcast(BinaryData, JsonObject);
+}
+
+/**
+ * Gather synthesize audio and forward it to the listeners once there is enough. Messages and fragments can be much smaller than the
+ * amount the TTS service needs to start playback so the audio is gathered until it reaches the minimum size the request asked for. The
+ * audio is 16 bit PCM so we only ever forward whole samples. A trailing odd byte is kept back and joined with the next data
+ *
+ * @param RequestId [in] the id of the request the audio belongs to
+ * @param Data [in] the audio data
+ */
+void UWitSocketSubsystem::StreamSynthesizeData(const FString& RequestId, TArrayView<const uint8> Data)
+{
+	FRequest* Request = Requests.Find(RequestId);
+
+	if (Request == nullptr || Data.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<uint8>& PendingData = Request->PendingSynthesizeData;
+
+	// Forward straight from the received data when nothing is gathered and there is enough of it to save a copy
+
+	const bool bCanForwardDirectly = PendingData.Num() == 0 && Data.Num() >= FMath::Max(Request->MinimumSynthesizeDataSize, 2);
+
+	if (bCanForwardDirectly)
+	{
+		const int32 NumWholeSampleBytes = Data.Num() & ~1;
+
+		if (NumWholeSampleBytes < Data.Num())
+		{
+			PendingData.Add(Data.Last());
+		}
+
+		BroadcastProgress(Request, Data.Slice(0, NumWholeSampleBytes), nullptr);
+		return;
+	}
+
+	PendingData.Append(Data.GetData(), Data.Num());
+
+	if (PendingData.Num() < FMath::Max(Request->MinimumSynthesizeDataSize, 2))
+	{
+		return;
+	}
+
+	FlushSynthesizeData(RequestId);
+}
+
+/**
+ * Forward any whole samples of synthesize audio still gathered for a request. A trailing odd byte is kept for the next data
+ *
+ * @param RequestId [in] the id of the request
+ */
+void UWitSocketSubsystem::FlushSynthesizeData(const FString& RequestId)
+{
+	FRequest* Request = Requests.Find(RequestId);
+
+	if (Request == nullptr)
+	{
+		return;
+	}
+
+	TArray<uint8>& PendingData = Request->PendingSynthesizeData;
+
+	const int32 NumWholeSampleBytes = PendingData.Num() & ~1;
+
+	if (NumWholeSampleBytes == 0)
+	{
+		return;
+	}
+
+	// Move the data out first since the listeners may start or cancel requests which would invalidate the request
+
+	TArray<uint8> Samples = MoveTemp(PendingData);
+
+	PendingData.Reset();
+
+	if (NumWholeSampleBytes < Samples.Num())
+	{
+		PendingData.Add(Samples.Last());
+	}
+
+	BroadcastProgress(Request, TArrayView<const uint8>(Samples.GetData(), NumWholeSampleBytes), nullptr);
+}
+
+/**
+ * Parse the JSON section of a frame
+ *
+ * @param Frame [in] the frame
+ * @param JsonObject [out] the parsed JSON
+ * @param ResponseType [out] the type of the response or empty if it has none
+ *
+ * @return true if the JSON section was parsed
+ */
+bool UWitSocketSubsystem::ParseFrameJson(const FWitSocketFrameView& Frame, TSharedPtr<FJsonObject>& JsonObject, FString& ResponseType)
+{
+	const auto JsonText = StringCast<TCHAR>(Frame.JsonData.GetData(), Frame.JsonData.Len());
+	const FStringView JsonTextView(JsonText.Get(), JsonText.Length());
+
+#if UE_VERSION_OLDER_THAN(5,0,0)
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(JsonTextView));
+#else
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(JsonTextView);
+#endif
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogWit, Warning, TEXT("WebSockets: Could not parse JSON %s"), *FString(JsonTextView));
+		return false;
+	}
+
+	ResponseType.Reset();
+	JsonObject->TryGetStringField(TEXT("type"), ResponseType);
+
+	return true;
+}
+
+/**
+ * Get the JSON section of a frame as a string. Only used for logging
+ *
+ * @param Frame [in] the frame
+ *
+ * @return the JSON text
+ */
+FString UWitSocketSubsystem::GetJsonText(const FWitSocketFrameView& Frame)
+{
+	const auto JsonText = StringCast<TCHAR>(Frame.JsonData.GetData(), Frame.JsonData.Len());
+
+	return FString(JsonText.Length(), JsonText.Get());
+}
+
+/**
+ * Read the section sizes from a frame header. The sizes are 64 bit little endian values
+ *
+ * @param Data [in] the start of the frame
+ * @param Size [in] the number of bytes of the frame available
+ * @param JsonDataSize [out] the size of the JSON section in bytes
+ * @param BinaryDataSize [out] the size of the binary section in bytes
+ *
+ * @return true if the whole header is available
+ */
+bool UWitSocketSubsystem::ReadFrameHeader(const uint8* Data, const int64 Size, uint64& JsonDataSize, uint64& BinaryDataSize)
+{
+	if (Data == nullptr || Size < FWitSocketFrameBuilder::HeaderSize)
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(&JsonDataSize, Data + 1, sizeof(JsonDataSize));
+	FMemory::Memcpy(&BinaryDataSize, Data + 9, sizeof(BinaryDataSize));
+
+	JsonDataSize = INTEL_ORDER64(JsonDataSize);
+	BinaryDataSize = INTEL_ORDER64(BinaryDataSize);
+
+	return true;
+}
+
+/**
+ * Decodes a frame received over the WebSocket connection in place. The binary section is clamped to the data available so the start of a
+ * message that is still being received can be decoded
+ *
+ * @param Data [in] data returned from WebSocket connection
+ * @param Size [in] the size of the data in bytes
+ * @param Frame [out] views of the sections of the frame
+ *
+ * @return true if the data contains a valid frame header and JSON section
+ */
+bool UWitSocketSubsystem::Decode(const uint8* Data, const int64 Size, FWitSocketFrameView& Frame)
+{
+	uint64 JsonDataSize = 0;
+	uint64 BinaryDataSize = 0;
+
+	if (!ReadFrameHeader(Data, Size, JsonDataSize, BinaryDataSize))
+	{
+		UE_LOG(LogWit, Warning, TEXT("WebSockets: Message not a valid size"));
+		return false;
+	}
+
+	const uint64 AvailableSize = static_cast<uint64>(Size - FWitSocketFrameBuilder::HeaderSize);
+
+	if (JsonDataSize == 0 || JsonDataSize > AvailableSize)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("WebSockets: Message does not contain a complete JSON section"));
+		return false;
+	}
 
-	// Read the JSON data section
-	Decoded.JsonData = std::string(
-		reinterpret_cast<const char*>(Message.data() + 17), JsonDataSize);
+	const uint8* JsonData = Data + FWitSocketFrameBuilder::HeaderSize;
+	const uint8* BinaryData = JsonData + JsonDataSize;
 
-	// Read the binary data section
-	Decoded.BinaryData = std::vector<uint8_t>(
-		Message.begin() + 17 + JsonDataSize,
-		Message.begin() + 17 + JsonDataSize + BinaryDataSize);
+	Frame.JsonData = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(JsonData), static_cast<int32>(JsonDataSize));
+	Frame.BinaryData = TArrayView<const uint8>(BinaryData, static_cast<int32>(FMath::Min(BinaryDataSize, AvailableSize - JsonDataSize)));
 
-	return Decoded;
+	return true;
 }
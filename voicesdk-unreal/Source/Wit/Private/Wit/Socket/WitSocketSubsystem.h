@@ -7,21 +7,64 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "IWebSocket.h"
+#include "Misc/EngineVersionComparison.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "UObject/ObjectKey.h"
 #include "Wit/Request/WitRequestConfiguration.h"
+#include "Wit/Socket/WitSocketFrameBuilder.h"
 #include "WitSocketSubsystem.generated.h"
 
 
+/**
+ * A view of a frame received over the WebSocket connection. The views point into the received message and are only valid while
+ * handling it
+ */
+struct FWitSocketFrameView
+{
+	/** The UTF-8 JSON section */
+	FUtf8StringView JsonData{};
 
-// Define a struct to represent the encoded data
-struct EncodedData
+	/** The binary section. If the message arrived in fragments this only covers the part of the section in the first fragment */
+	TArrayView<const uint8> BinaryData{};
+};
+
+/**
+ * Statistics about the WebSocket connection
+ */
+struct FWitSocketConnectionStats
 {
-	std::string JsonData;
-	std::vector<uint8_t> BinaryData;
+	/** The number of connection attempts */
+	int32 NumConnects{0};
+
+	/** The number of connection attempts that were authenticated */
+	int32 NumSuccessfulConnects{0};
+
+	/** The number of times the connection was re-established after dropping */
+	int32 NumReconnects{0};
+
+	/** The time from starting to connect to being authenticated for the most recent connection in seconds */
+	double LastConnectLatency{0.0};
+
+	/** The total time spent connecting for every authenticated connection in seconds */
+	double TotalConnectLatency{0.0};
+
+	/** The round trip time of the most recent keep-alive ping in seconds */
+	double LastPingRoundTripTime{0.0};
+
+	/** The number of keep-alive pings that were not answered in time */
+	int32 NumPingTimeouts{0};
+
+	/** The number of requests that were queued while not authenticated and sent later */
+	int32 NumQueuedRequestsSent{0};
+
+	/** Get the average time from starting to connect to being authenticated in seconds */
+	double GetAverageConnectLatency() const
+	{
+		return NumSuccessfulConnects > 0 ? TotalConnectLatency / NumSuccessfulConnects : 0.0;
+	}
 };
 
 /**
@@ -50,9 +93,13 @@ enum class ESocketState : uint8
 DECLARE_MULTICAST_DELEGATE(FSocketStatusDelegate);
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitSocketErrorDelegate, const FString&, const FString&);
-DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitSocketProgressDelegate, const TArray<uint8>&, const TSharedPtr<FJsonObject>);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitSocketProgressDelegate, TArrayView<const uint8>, const TSharedPtr<FJsonObject>);
 DECLARE_MULTICAST_DELEGATE(FOnWitSocketCompleteDelegate);
 
+DECLARE_DELEGATE_TwoParams(FOnWitSocketRequestProgressDelegate, TArrayView<const uint8>, const TSharedPtr<FJsonObject>);
+DECLARE_DELEGATE(FOnWitSocketRequestCompleteDelegate);
+DECLARE_DELEGATE_TwoParams(FOnWitSocketRequestErrorDelegate, const FString&, const FString&);
+
 /**
  * A class to handle WebSocket connections for in progress Wit.ai requests.
  */
@@ -73,17 +120,39 @@ public:
 	virtual void Deinitialize() override;
 
 	/**
-	 * Create a WebSocket connection
+	 * Create a WebSocket connection. The connection is kept alive and re-established after it drops until CloseSocket is called
 	 *
 	 * @param AuthToken [in] Authentication token used to establish a WebSocket connection
 	 */
 	void CreateSocket(const FString AuthToken);
 
 	/**
-	 * Close a WebSocket connection
+	 * Close a WebSocket connection. Any requests still in progress are failed
 	 */
 	void CloseSocket();
 
+	/**
+	 * Register a user of the shared connection and make sure it is connecting. The connection stays open while it has any users
+	 *
+	 * @param User [in] the object using the connection
+	 * @param AuthToken [in] Authentication token used to establish a WebSocket connection
+	 */
+	void AddSocketUser(const UObject* User, const FString& AuthToken);
+
+	/**
+	 * Unregister a user of the shared connection. The connection is closed once its last user is removed
+	 *
+	 * @param User [in] the object that was using the connection
+	 */
+	void RemoveSocketUser(const UObject* User);
+
+	/**
+	 * Get the connection statistics
+	 *
+	 * @return the statistics
+	 */
+	const FWitSocketConnectionStats& GetConnectionStats() const;
+
 	/**
 	 * Checks if there is an active synthesize request in progress
 	 *
@@ -98,6 +167,24 @@ public:
 	 */
 	bool IsConverseInProgress();
 
+	/**
+	 * Checks if a specific request is in progress
+	 *
+	 * @param RequestId [in] the id of the request returned by SendJsonData
+	 *
+	 * @return Is the request currently in progress
+	 */
+	bool IsRequestInProgress(const FString& RequestId) const;
+
+	/**
+	 * Checks if a specific converse request has been initialized by Wit.ai and is ready for audio
+	 *
+	 * @param RequestId [in] the id of the request returned by SendJsonData
+	 *
+	 * @return Is the converse ready for audio
+	 */
+	bool IsConverseInProgress(const FString& RequestId) const;
+
 	/**
 	 * Checks the current status of the WebSocket connection
 	 *
@@ -108,30 +195,50 @@ public:
 	/**
 	 * Send binary data across an active WebSocket connection
 	 *
+	 * @param RequestId [in] the id of the request the data belongs to
 	 * @param Data [in] binary data to send over connection
 	 */
-	void SendBinaryData(const TArray<uint8>& Data);
+	void SendBinaryData(const FString& RequestId, const TArray<uint8>& Data);
 
 	/**
-	 * Send JSON data across an active WebSocket connection
+	 * Send JSON data across an active WebSocket connection to start a new request. Responses are routed to the request by their
+	 * client_request_id so several requests can share the connection. If the connection is not authenticated yet the request is
+	 * queued and sent once it is
 	 *
 	 * @param Type [in] Type of request to send over connection
 	 * @param Data [in] JSON data to send over connection
+	 * @param OnProgress [in] optional callback for this request's progress
+	 * @param OnComplete [in] optional callback for when this request completes
+	 * @param OnError [in] optional callback for when this request fails. If not bound a failed request calls OnComplete instead
+	 * @param MinimumSynthesizeDataSize [in] synthesize audio is gathered until there is at least this many bytes before it is forwarded
+	 *
+	 * @return the id of the request
+	 */
+	FString SendJsonData(const ERequestType Type, const TSharedRef<FJsonObject> Data, FOnWitSocketRequestProgressDelegate OnProgress = {},
+		FOnWitSocketRequestCompleteDelegate OnComplete = {}, FOnWitSocketRequestErrorDelegate OnError = {}, const int32 MinimumSynthesizeDataSize = 0);
+
+	/**
+	 * Stop routing responses to a request. Any further responses for it are ignored
+	 *
+	 * @param RequestId [in] the id of the request returned by SendJsonData
 	 */
-	void SendJsonData(const ERequestType Type, const TSharedRef<FJsonObject> Data);
+	void CancelRequest(const FString& RequestId);
 
 	/** Callback to use when the WebSocket status changes */
 	FSocketStatusDelegate OnSocketStateChange;
 
-	/** Optional callback to use when the request errors */
+	/** Optional callback to use when any request errors */
 	FOnWitSocketErrorDelegate OnSocketStreamError{};
 
-	/** Optional callback to use when the request is in progress */
+	/** Optional callback to use when any request is in progress */
 	FOnWitSocketProgressDelegate OnSocketStreamProgress{};
 
-	/** Optional callback to use when the request is complete */
+	/** Optional callback to use when any request is complete */
 	FOnWitSocketCompleteDelegate OnSocketStreamComplete{};
 
+	/** Should synthesize audio in fragmented messages be forwarded as each fragment arrives rather than once the whole message is received? */
+	bool bShouldStreamSynthesizeData{true};
+
 private:
 	/** URL of the Wit.ai server to connect to */
 	const FString ServerURL = TEXT("wss://api.wit.ai/composer");
@@ -145,33 +252,325 @@ private:
 	/** Is the WebSocket connection authenticated */
 	bool bWebSocketAuthenticated;
 
-	/** Is there an active Synthesize request in progress */
-	bool bSynthesizeInProgress;
+	/** How often we tick to drive reconnection and keep-alive in seconds */
+	static constexpr float TickInterval{0.25f};
+
+	/** The delay before the first reconnection attempt in seconds. This doubles with each failed attempt */
+	static constexpr float InitialReconnectDelay{0.5f};
+
+	/** The maximum delay between reconnection attempts in seconds */
+	static constexpr float MaximumReconnectDelay{30.0f};
+
+	/** How long the connection must be idle before we ping it in seconds */
+	static constexpr double KeepAliveInterval{30.0};
+
+	/** How long we wait for a ping to be answered before treating the connection as dead in seconds */
+	static constexpr double KeepAliveTimeout{10.0};
+
+	/** The handle of our ticker */
+#if UE_VERSION_OLDER_THAN(5,0,0)
+	FDelegateHandle TickerHandle{};
+#else
+	FTSTicker::FDelegateHandle TickerHandle{};
+#endif
+
+	/** The token used to authenticate the connection */
+	FString CachedAuthToken{};
+
+	/** Should the connection be kept open? Cleared when the socket is closed deliberately */
+	bool bShouldBeConnected{false};
+
+	/** The objects sharing the connection. It is closed when the last of them is removed */
+	TSet<FObjectKey> SocketUsers{};
+
+	/** Is a reconnection scheduled? */
+	bool bIsReconnectScheduled{false};
+
+	/** When the scheduled reconnection should happen */
+	double ReconnectTime{0.0};
+
+	/** The number of reconnection attempts since the connection was last authenticated */
+	int32 NumReconnectAttempts{0};
+
+	/** When we started connecting */
+	double ConnectStartTime{0.0};
+
+	/** When we last sent or received anything */
+	double LastActivityTime{0.0};
+
+	/** Is a keep-alive ping waiting to be answered? Anything received from the server answers it */
+	bool bIsPingInFlight{false};
+
+	/** Has a keep-alive ping been answered on this connection? Until one has an unanswered ping is not treated as a dead connection */
+	bool bIsPingAnswered{false};
+
+	/** When the keep-alive ping was sent */
+	double PingSendTime{0.0};
+
+	/** Statistics about the connection */
+	FWitSocketConnectionStats ConnectionStats{};
+
+	/** A request in progress on the WebSocket connection */
+	struct FRequest
+	{
+		/** The type of the request */
+		ERequestType Type{ERequestType::Synthesize};
+
+		/** Increases with each request so we can tell which is oldest */
+		uint32 SequenceNumber{0};
+
+		/** Has Wit.ai initialized the converse so it is ready for audio? */
+		bool bIsConverseInitialized{false};
 
-	/** Is there an active Converse request in progress */
-	bool bConverseInProgress;
+		/** Is the request waiting to be sent until the connection is authenticated? */
+		bool bIsQueued{false};
 
-	/** Current id of request in progress */
-	FString RequestId;
+		/** The message to send for a queued request */
+		FString QueuedMessage{};
+
+		/** Synthesize audio received but not forwarded yet. Holds back any odd byte so audio is always forwarded in whole samples */
+		TArray<uint8> PendingSynthesizeData{};
+
+		/** Synthesize audio is gathered until there is at least this many bytes before it is forwarded */
+		int32 MinimumSynthesizeDataSize{0};
+
+		/** Callback for this request's progress */
+		FOnWitSocketRequestProgressDelegate OnProgress{};
+
+		/** Callback for when this request completes */
+		FOnWitSocketRequestCompleteDelegate OnComplete{};
+
+		/** Callback for when this request fails */
+		FOnWitSocketRequestErrorDelegate OnError{};
+	};
+
+	/** The requests in progress keyed by client request id */
+	TMap<FString, FRequest> Requests{};
+
+	/** The sequence number to give the next request */
+	uint32 NextRequestSequenceNumber{0};
+
+	/** The request that most recently received synthesize data. Unframed audio and streamed fragments belong to it */
+	FString SynthesizingRequestId{};
 
 	/** Current status of the WebSocket connection */
 	ESocketState SocketStatus;
 
+	/** Builds the frames we send over the WebSocket connection into a reused buffer */
+	FWitSocketFrameBuilder FrameBuilder;
+
+	/** How the fragments of the message being received are handled */
+	enum class EFragmentState : uint8
+	{
+		/** We are not part way through receiving a message */
+		None,
+
+		/** The message is buffered until its header and JSON section are complete so we can tell whether to stream it */
+		WaitingForJson,
+
+		/** The whole message is buffered and handled once it is complete */
+		Buffering,
+
+		/** The message is synthesize data that is forwarded as each fragment arrives */
+		Streaming,
+	};
+
+	/** How the fragments of the message being received are handled */
+	EFragmentState FragmentState{EFragmentState::None};
+
+	/** Reassembles fragmented messages. Reused across messages so it only grows to fit the largest message buffered */
+	TArray<uint8> ReassemblyBuffer{};
+
+	/** The JSON section of the message being received if it has already been parsed */
+	TSharedPtr<FJsonObject> PendingJsonObject{};
+
+	/** The response type of the message being received if its JSON section has already been parsed */
+	FString PendingResponseType{};
+
 	/**
-	 * Encodes data to send over the WebSocket connection
+	 * Start connecting the WebSocket using the cached authentication token
+	 */
+	void Connect();
+
+	/**
+	 * Unbind from and close the current WebSocket if there is one
+	 */
+	void DestroySocket();
+
+	/**
+	 * Send the authentication message
+	 */
+	void SendAuthentication();
+
+	/**
+	 * Send a keep-alive ping
+	 */
+	void SendPing();
+
+	/**
+	 * Called when anything is received while a keep-alive ping is waiting to be answered
+	 */
+	void OnPong();
+
+	/**
+	 * Called when the connection fails or closes
+	 */
+	void OnDisconnected();
+
+	/**
+	 * Remove the requests that are in progress
 	 *
-	 * @param JsonData [in] JSON data to send over the WebSocket connection
-	 * @param BinaryData [in] binary data to send over the WebSocket connection
+	 * @param bShouldIncludeQueued [in] should requests that are still waiting to be sent be removed too?
+	 *
+	 * @return the removed requests
+	 */
+	TArray<FRequest> RemoveRequests(const bool bShouldIncludeQueued);
+
+	/**
+	 * Report the failure of requests that have already been removed. Each request's error callback is called or its complete callback
+	 * if it has none
+	 *
+	 * @param FailedRequests [in] the requests that failed
+	 * @param ErrorMessage [in] the error message
+	 * @param HumanReadableErrorMessage [in] a human readable version of the error message
+	 */
+	void FailRequests(const TArray<FRequest>& FailedRequests, const FString& ErrorMessage, const FString& HumanReadableErrorMessage);
+
+	/**
+	 * Schedule a reconnection after a jittered exponential backoff
 	 */
-	std::string Encode(
-		const std::string& JsonData,
-		const std::vector<unsigned char>& BinaryData = {});
+	void ScheduleReconnect();
 
 	/**
-	 * Decodes data received over the WebSocket connection
+	 * Called when Wit.ai confirms the authentication
+	 */
+	void OnAuthenticated();
+
+	/**
+	 * Send the requests that were made while we were not authenticated
+	 */
+	void SendQueuedRequests();
+
+	/**
+	 * Drive reconnection and keep-alive
+	 *
+	 * @param DeltaTime [in] the time since the last tick
+	 *
+	 * @return true to keep ticking
+	 */
+	bool Tick(float DeltaTime);
+
+	/**
+	 * Handle a message or message fragment received over the WebSocket connection
+	 *
+	 * @param Data [in] the received data
+	 * @param Size [in] the size of the received data in bytes
+	 * @param BytesRemaining [in] the number of bytes of the message still to be received
+	 */
+	void OnRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining);
+
+	/**
+	 * Check whether enough of a fragmented message has been received to start streaming it
+	 */
+	void TryBeginStreaming();
+
+	/**
+	 * Handle a complete message received over the WebSocket connection
+	 *
+	 * @param Message [in] the message
+	 */
+	void HandleMessage(TArrayView<const uint8> Message);
+
+	/**
+	 * Handle a decoded frame
+	 *
+	 * @param Frame [in] the frame
+	 * @param JsonObject [in] the parsed JSON section
+	 * @param ResponseType [in] the type of the response
+	 */
+	void HandleFrame(const FWitSocketFrameView& Frame, const TSharedRef<FJsonObject>& JsonObject, const FString& ResponseType);
+
+	/**
+	 * Find the request a response belongs to
+	 *
+	 * @param JsonObject [in] the parsed JSON section of the response
+	 * @param ResponseType [in] the type of the response
+	 *
+	 * @return the id of the request or empty if there is none
+	 */
+	FString FindRequestId(const TSharedRef<FJsonObject>& JsonObject, const FString& ResponseType) const;
+
+	/**
+	 * Remove a request that has completed and notify its listeners
+	 *
+	 * @param RequestId [in] the id of the request
+	 */
+	void CompleteRequest(const FString& RequestId);
+
+	/**
+	 * Forward progress to the listeners of a request and to the listeners of every request
+	 *
+	 * @param Request [in] the request or null if it is not known
+	 * @param BinaryData [in] the binary data
+	 * @param JsonObject [in] the JSON data if any
+	 */
+	void BroadcastProgress(const FRequest* Request, TArrayView<const uint8> BinaryData, const TSharedPtr<FJsonObject>& JsonObject);
+
+	/**
+	 * Gather synthesize audio and forward it to the listeners in whole samples once there is enough
+	 *
+	 * @param RequestId [in] the id of the request the audio belongs to
+	 * @param Data [in] the audio data
+	 */
+	void StreamSynthesizeData(const FString& RequestId, TArrayView<const uint8> Data);
+
+	/**
+	 * Forward any whole samples of synthesize audio still gathered for a request and discard the rest
+	 *
+	 * @param RequestId [in] the id of the request
+	 */
+	void FlushSynthesizeData(const FString& RequestId);
+
+	/**
+	 * Parse the JSON section of a frame
+	 *
+	 * @param Frame [in] the frame
+	 * @param JsonObject [out] the parsed JSON
+	 * @param ResponseType [out] the type of the response or empty if it has none
+	 *
+	 * @return true if the JSON section was parsed
+	 */
+	static bool ParseFrameJson(const FWitSocketFrameView& Frame, TSharedPtr<FJsonObject>& JsonObject, FString& ResponseType);
+
+	/**
+	 * Get the JSON section of a frame as a string
+	 *
+	 * @param Frame [in] the frame
+	 *
+	 * @return the JSON text
+	 */
+	static FString GetJsonText(const FWitSocketFrameView& Frame);
+
+	/**
+	 * Read the section sizes from a frame header
+	 *
+	 * @param Data [in] the start of the frame
+	 * @param Size [in] the number of bytes of the frame available
+	 * @param JsonDataSize [out] the size of the JSON section in bytes
+	 * @param BinaryDataSize [out] the size of the binary section in bytes
+	 *
+	 * @return true if the whole header is available
+	 */
+	static bool ReadFrameHeader(const uint8* Data, const int64 Size, uint64& JsonDataSize, uint64& BinaryDataSize);
+
+	/**
+	 * Decodes a frame received over the WebSocket connection in place
+	 *
+	 * @param Data [in] data returned from WebSocket connection
+	 * @param Size [in] the size of the data in bytes
+	 * @param Frame [out] views of the sections of the frame
 	 *
-	 * @param Message [in] data returned from WebSocket connection
-	 * @return Data from WebSocket parsed into an EncodedData struct
+	 * @return true if the data contains a valid frame header and JSON section
 	 */
-	EncodedData static Decode(const std::string Message);
+	static bool Decode(const uint8* Data, const int64 Size, FWitSocketFrameView& Frame);
 };
@@ -78,13 +78,16 @@ void UWitTtsService::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (Configuration != nullptr)
+	{
+		GEngine->GetEngineSubsystem<UWitRequestSubsystem>()->ApplyConfiguration(Configuration->Application.Advanced);
+	}
+
 	if (bUseWebSocket)
 	{
 		UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
 		SocketSubsystem->OnSocketStateChange.AddUObject(this, &UWitTtsService::OnSocketStateChange);
-		SocketSubsystem->CreateSocket(Configuration->Application.ClientAccessToken);
-		SocketSubsystem->OnSocketStreamProgress.AddUObject(this, &UWitTtsService::OnSynthesizeRequestProgress);
-		SocketSubsystem->OnSocketStreamComplete.AddUObject(this, &UWitTtsService::OnSocketStreamComplete);
+		SocketSubsystem->AddSocketUser(this, Configuration->Application.ClientAccessToken);
 		UE_LOG(LogWit, Display, TEXT("BeginPlay: Connection Started"));
 	}
 }
@@ -97,19 +100,27 @@ void UWitTtsService::BeginDestroy()
 	Super::BeginDestroy();
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
-	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress();
 
-	if (bIsRequestInProgress)
+	if (RequestSubsystem != nullptr)
 	{
-		RequestSubsystem->CancelRequest();
+		RequestSubsystem->CancelRequest(SynthesizeRequestHandle);
+		RequestSubsystem->CancelRequest(VoicesRequestHandle);
 	}
+
+	SynthesizeRequestHandle.Reset();
+	VoicesRequestHandle.Reset();
+
+	CancelPipelinedClips();
+
 	if (bUseWebSocket)
 	{
 		UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
-		SocketSubsystem->OnSocketStateChange.Clear();
-		SocketSubsystem->OnSocketStreamProgress.Clear();
-		SocketSubsystem->OnSocketStreamComplete.Clear();
-		SocketSubsystem->CloseSocket();
+		// The connection is shared with other services so we only remove what is ours. It closes once nothing is using it
+
+		SocketSubsystem->OnSocketStateChange.RemoveAll(this);
+		SocketSubsystem->CancelRequest(SocketRequestId);
+		SocketSubsystem->RemoveSocketUser(this);
+		SocketRequestId.Reset();
 		UE_LOG(LogWit, Display, TEXT("BeginDestroy: WebSocket Cleanup"));
 	}
 }
@@ -125,15 +136,16 @@ bool UWitTtsService::IsRequestInProgress() const
 	if (bUseWebSocket)
 	{
 		UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
-		bIsRequestInProgress = SocketSubsystem != nullptr && SocketSubsystem->IsSynthesizeInProgress();
+		bIsRequestInProgress = SocketSubsystem != nullptr && SocketSubsystem->IsRequestInProgress(SocketRequestId);
 	}
 	else
 	{
 		const UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
-		bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress();
+		bIsRequestInProgress = RequestSubsystem != nullptr && (RequestSubsystem->IsRequestInProgress(SynthesizeRequestHandle) || RequestSubsystem->IsRequestInProgress(VoicesRequestHandle));
+		bIsRequestInProgress |= !PipelinedClips.IsEmpty();
 	}
 
-	return bIsRequestInProgress;
+	return bIsRequestInProgress || bIsStorageCacheRequestInProgress;
 }
 
 /**
@@ -144,7 +156,26 @@ bool UWitTtsService::IsRequestInProgress() const
  */
 void UWitTtsService::ConvertTextToSpeechWithSettings(const FTtsConfiguration& ClipSettings, const bool bQueueAudio)
 {
+	const bool bShouldPipelineRequests = ShouldPipelineRequests();
+
+	if (bShouldPipelineRequests && !bQueueAudio)
+	{
+		CancelPipelinedClips();
+	}
+
+	if (!IsRequestInProgress())
+	{
+		StartSynthesisTiming();
+	}
+
 	SplitSpeech(ClipSettings, bQueueAudio);
+
+	if (bShouldPipelineRequests)
+	{
+		ConvertTextToSpeechPipelined();
+		return;
+	}
+
 	ConvertTextToSpeechWithSettingsInternal(true, bQueueAudio);
 }
 
@@ -163,6 +194,12 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 		return;
 	}
 
+	if (bIsStorageCacheRequestInProgress)
+	{
+		UE_LOG(LogWit, Verbose, TEXT("ConvertTextToSpeechWithSettingsInternal: waiting for the storage cache, the queue will continue when it responds"));
+		return;
+	}
+
 	UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
 
 	if (bUseWebSocket)
@@ -173,17 +210,14 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 				*UEnum::GetValueAsString(AudioType));
 			AudioType = EWitRequestAudioFormat::Pcm;
 		}
+		// The socket subsystem queues the request until the connection is authenticated so we only need to make sure it is connecting
+
 		ESocketState SocketStatus = SocketSubsystem->GetSocketState();
 		if (SocketStatus == ESocketState::Disconnected)
 		{
 			UE_LOG(LogWit, Display, TEXT("ConvertTextToSpeechWithSettingsInternal: Socket disconnected, restarting"));
 			SocketSubsystem->CreateSocket(Configuration->Application.ClientAccessToken);
 		}
-		else if (SocketStatus != ESocketState::Authenticated)
-		{
-			UE_LOG(LogWit, Warning, TEXT("ConvertTextToSpeechWithSettingsInternal: Socket not yet connected, retrying"));
-			return;
-		}
 	}
 	FTtsConfiguration& RequestClipSettings = QueuedSettings[0];
 
@@ -205,15 +239,16 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 
 	const FString ClipId = FWitHelperUtilities::GetVoiceClipId(RequestClipSettings);
 
-	// Check if we already have this in the memory cache
+	// Check if we already have this in the memory cache. Streamed requests never use the cached clip so only fetch it, which counts
+	// as a cache hit, when we are actually going to play it
 
 	if (MemoryCacheHandler != nullptr)
 	{
-		USoundWave* CachedClip = MemoryCacheHandler->GetClip(ClipId);
-
-		const bool bIsClipCached = CachedClip != nullptr;
+		const bool bIsClipCached = MemoryCacheHandler->ContainsClip(ClipId);
 		if (bIsClipCached && !bUseStreaming)
 		{
+			USoundWave* CachedClip = MemoryCacheHandler->GetClip(ClipId);
+
 			UE_LOG(LogWit, Verbose, TEXT("ConvertTextToSpeechWithSettingsInternal: clip found in memory cache (%s)"), *ClipId);
 			SoundWaveProcedural = nullptr;
 
@@ -221,34 +256,51 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 			{
 				QueuedSettings.RemoveAt(0);
 				EventHandler->OnSynthesizeResponse.Broadcast(true, CachedClip);
+				MarkSynthesisClipDelivered();
 				if (!QueuedSettings.IsEmpty())
 				{
 					ConvertTextToSpeechWithSettingsInternal(false, true);
 				}
+				else
+				{
+					FinishSynthesisTiming(TEXT("serial"));
+				}
 			}
 
 			return;
 		}
 	}
 
-	// Check if we already have this in the storage cache
+	// Check if we already have this in the storage cache. The storage cache is read in the background so we continue once it responds
 
 	const bool bShouldUseStorageCache = StorageCacheHandler != nullptr && StorageCacheHandler->ShouldCache(RequestClipSettings.StorageCacheLocation);
 
 	if (bShouldUseStorageCache)
 	{
-		TArray<uint8> CachedClipData;
+		bIsStorageCacheRequestInProgress = true;
 
-		const bool bIsClipCached = StorageCacheHandler->RequestClip(ClipId, RequestClipSettings.StorageCacheLocation, CachedClipData);
-		if (bIsClipCached)
-		{
-			UE_LOG(LogWit, Verbose, TEXT("ConvertTextToSpeechWithSettingsInternal: clip found in storage cache (%s)"), *ClipId);
+		StorageCacheHandler->RequestClipAsync(ClipId, RequestClipSettings.StorageCacheLocation,
+			FOnTtsStorageCacheRequestClipCompleteDelegate::CreateUObject(this, &UWitTtsService::OnStorageCacheRequestClipComplete, ClipId, bQueueAudio));
+		return;
+	}
 
-			OnStorageCacheRequestComplete(CachedClipData, RequestClipSettings);
-			return;
-		}
+	SendSynthesizeRequest(bQueueAudio);
+}
+
+/**
+ * Sends the clip at the front of the queue to Wit to be converted into speech
+ *
+ * @param QueueAudio [in] should audio be placed in a queue
+ */
+void UWitTtsService::SendSynthesizeRequest(const bool bQueueAudio)
+{
+	if (QueuedSettings.IsEmpty())
+	{
+		return;
 	}
 
+	FTtsConfiguration& RequestClipSettings = QueuedSettings[0];
+
 	// If not cached then we send off a request to Wit.ai
 
 	const bool bHasConfiguration = Configuration != nullptr && !Configuration->Application.ClientAccessToken.IsEmpty();
@@ -276,6 +328,8 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 
 #ifdef CPP_PLUGIN
 #if PLATFORM_ANDROID
+	const FString ClipId = FWitHelperUtilities::GetVoiceClipId(RequestClipSettings);
+
     folly::InlineExecutor InlineExecutor;
     folly::Executor::KeepAlive<> ExecutorToken;
     ExecutorToken = getKeepAliveToken(InlineExecutor);
@@ -317,6 +371,7 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 #endif
 #else
 
+	UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
 	if (RequestSubsystem == nullptr)
@@ -325,7 +380,7 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 		return;
 	}
 
-	if (RequestSubsystem->IsRequestInProgress())
+	if (RequestSubsystem->IsRequestInProgress(SynthesizeRequestHandle))
 	{
 		UE_LOG(LogWit, Warning, TEXT("ConvertTextToSpeechWithSettingsInternal: cannot convert text because a request is already in progress"));
 		if (!bQueueAudio)
@@ -347,14 +402,7 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 
 	FWitRequestConfiguration RequestConfiguration{};
 
-	FWitRequestBuilder::SetRequestConfigurationWithDefaults(RequestConfiguration, EWitRequestEndpoint::Synthesize, Configuration->Application.ClientAccessToken,
-		Configuration->Application.Advanced.ApiVersion, Configuration->Application.Advanced.URL);
-	FWitRequestBuilder::AddFormatContentType(RequestConfiguration, EWitRequestFormat::Json);
-	FWitRequestBuilder::AddFormatAccept(RequestConfiguration, AudioType);
-
-	RequestConfiguration.bShouldUseCustomHttpTimeout = Configuration->Application.Advanced.bIsCustomHttpTimeout;
-	RequestConfiguration.HttpTimeout = Configuration->Application.Advanced.HttpTimeout;
-	RequestConfiguration.bShouldUseChunkedTransfer = bUseStreaming;
+	SetupSynthesizeRequestConfiguration(RequestConfiguration);
 
 	RequestConfiguration.OnRequestError.AddUObject(this, &UWitTtsService::OnSynthesizeRequestError);
 	RequestConfiguration.OnRequestComplete.AddUObject(this, &UWitTtsService::OnSynthesizeRequestComplete);
@@ -368,38 +416,20 @@ void UWitTtsService::ConvertTextToSpeechWithSettingsInternal(const bool bNewRequ
 		RequestConfiguration.OnRequestProgress.AddUObject(this, &UWitTtsService::OnSynthesizeRequestProgress);
 	}
 
-	// Construct the body parameters. The only required one is "q" which is the text we want to convert. We could use UStructToJsonObject
-	// but since most of the arguments are optional it's easier to just set them
-
-	const TSharedPtr<FJsonObject> RequestBody = MakeShared<FJsonObject>();
-	const bool bIsTextTooLong = RequestClipSettings.Text.Len() > MaximumTextLengthInRequest;
-
-	if (bIsTextTooLong)
-	{
-		UE_LOG(LogWit, Warning, TEXT("ConvertTextToSpeechWithSettingsInternal: text is too long, the limit is %d characters"), MaximumTextLengthInRequest);
-	}
-
-	RequestBody->SetStringField("q", RequestClipSettings.Text);
-
-	RequestBody->SetNumberField("speed", RequestClipSettings.Speed);
-	RequestBody->SetNumberField("pitch", RequestClipSettings.Pitch);
-	RequestBody->SetNumberField("gain", RequestClipSettings.Gain);
-	RequestBody->SetStringField("voice", RequestClipSettings.Voice);
-
-	if (!RequestClipSettings.Style.IsEmpty())
-	{
-		RequestBody->SetStringField("style", RequestClipSettings.Style);
-	}
+	const TSharedRef<FJsonObject> RequestBody = CreateSynthesizeRequestBody(RequestClipSettings);
 
 	if (bUseWebSocket)
 	{
-		SocketSubsystem->SendJsonData(ERequestType::Synthesize, RequestBody.ToSharedRef());
+		SocketRequestId = SocketSubsystem->SendJsonData(ERequestType::Synthesize, RequestBody,
+			FOnWitSocketRequestProgressDelegate::CreateUObject(this, &UWitTtsService::OnSynthesizeStreamProgress),
+			FOnWitSocketRequestCompleteDelegate::CreateUObject(this, &UWitTtsService::OnSocketStreamComplete),
+			FOnWitSocketRequestErrorDelegate::CreateUObject(this, &UWitTtsService::OnSocketStreamError), GetMinimumStreamBufferLength());
 	}
 	else
 	{
-		RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-		RequestSubsystem->WriteJsonData(RequestBody.ToSharedRef());
-		RequestSubsystem->EndStreamRequest();
+		SynthesizeRequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+		RequestSubsystem->WriteJsonData(SynthesizeRequestHandle, RequestBody);
+		RequestSubsystem->EndStreamRequest(SynthesizeRequestHandle);
 	}
 
 	QueuedSettings.RemoveAt(0);
@@ -461,6 +491,448 @@ void UWitTtsService::SplitSpeech(const FTtsConfiguration& ClipSettings, const bo
 	}
 }
 
+/**
+ * Setup the configuration shared by all synthesize requests. We use the /synthesize endpoint in Wit.ai. See the Wit.ai documentation
+ * for more specifics of the parameters to this endpoint
+ *
+ * @param RequestConfiguration [out] the configuration to setup
+ */
+void UWitTtsService::SetupSynthesizeRequestConfiguration(FWitRequestConfiguration& RequestConfiguration) const
+{
+	FWitRequestBuilder::SetRequestConfigurationWithDefaults(RequestConfiguration, EWitRequestEndpoint::Synthesize, Configuration->Application.ClientAccessToken,
+		Configuration->Application.Advanced.ApiVersion, Configuration->Application.Advanced.URL);
+	FWitRequestBuilder::AddFormatContentType(RequestConfiguration, EWitRequestFormat::Json);
+	FWitRequestBuilder::AddFormatAccept(RequestConfiguration, AudioType);
+
+	RequestConfiguration.bShouldUseCustomHttpTimeout = Configuration->Application.Advanced.bIsCustomHttpTimeout;
+	RequestConfiguration.HttpTimeout = Configuration->Application.Advanced.HttpTimeout;
+	RequestConfiguration.bShouldUseChunkedTransfer = bUseStreaming;
+}
+
+/**
+ * Create the body of a synthesize request. The only required parameter is "q" which is the text we want to convert. We could use
+ * UStructToJsonObject but since most of the arguments are optional it's easier to just set them
+ *
+ * @param ClipSettings [in] the settings of the clip to synthesize
+ * @return the request body
+ */
+TSharedRef<FJsonObject> UWitTtsService::CreateSynthesizeRequestBody(const FTtsConfiguration& ClipSettings) const
+{
+	const TSharedRef<FJsonObject> RequestBody = MakeShared<FJsonObject>();
+	const bool bIsTextTooLong = ClipSettings.Text.Len() > MaximumTextLengthInRequest;
+
+	if (bIsTextTooLong)
+	{
+		UE_LOG(LogWit, Warning, TEXT("CreateSynthesizeRequestBody: text is too long, the limit is %d characters"), MaximumTextLengthInRequest);
+	}
+
+	RequestBody->SetStringField("q", ClipSettings.Text);
+
+	RequestBody->SetNumberField("speed", ClipSettings.Speed);
+	RequestBody->SetNumberField("pitch", ClipSettings.Pitch);
+	RequestBody->SetNumberField("gain", ClipSettings.Gain);
+	RequestBody->SetStringField("voice", ClipSettings.Voice);
+
+	if (!ClipSettings.Style.IsEmpty())
+	{
+		RequestBody->SetStringField("style", ClipSettings.Style);
+	}
+
+	return RequestBody;
+}
+
+/**
+ * Should split requests be pipelined rather than sent one at a time? Streaming and WebSocket requests feed a single procedural sound
+ * wave so they always go one at a time
+ *
+ * @return true if requests should be pipelined
+ */
+bool UWitTtsService::ShouldPipelineRequests() const
+{
+#ifdef CPP_PLUGIN
+	return false;
+#else
+	return MaxPipelinedRequests > 1 && !bUseStreaming && !bUseWebSocket;
+#endif
+}
+
+/**
+ * Send as many queued clips as there are free pipeline slots for. Clips found in the memory cache complete straight away and clips
+ * in the storage cache complete once they are loaded but both still wait their turn to be delivered
+ */
+void UWitTtsService::ConvertTextToSpeechPipelined()
+{
+	const bool bHasConfiguration = Configuration != nullptr && !Configuration->Application.ClientAccessToken.IsEmpty();
+
+	if (!bHasConfiguration)
+	{
+		UE_LOG(LogWit, Warning, TEXT("ConvertTextToSpeechPipelined: cannot convert text because no configuration found. Please assign a configuration and access token"));
+		return;
+	}
+
+	while (!QueuedSettings.IsEmpty() && GetNumPipelinedClipsInFlight() < MaxPipelinedRequests)
+	{
+		FWitTtsPipelinedClip& Clip = PipelinedClips.AddDefaulted_GetRef();
+
+		Clip.SequenceNumber = NextPipelinedSequenceNumber++;
+		Clip.ClipSettings = QueuedSettings[0];
+
+		QueuedSettings.RemoveAt(0);
+
+		if (Clip.ClipSettings.Voice.IsEmpty())
+		{
+			UE_LOG(LogWit, Warning, TEXT("ConvertTextToSpeechPipelined: cannot convert text because no voice is specified and it is required"));
+
+			Clip.ErrorMessage = TEXT("No voice specified");
+			Clip.HumanReadableErrorMessage = TEXT("A voice is required to convert text to speech");
+			Clip.bIsComplete = true;
+
+			continue;
+		}
+
+		const FString ClipId = FWitHelperUtilities::GetVoiceClipId(Clip.ClipSettings);
+
+		// Keep hold of the cached clip since it could be evicted while it waits for earlier clips to be delivered
+
+		USoundWave* CachedClip = MemoryCacheHandler != nullptr ? MemoryCacheHandler->GetClip(ClipId) : nullptr;
+
+		if (CachedClip != nullptr)
+		{
+			UE_LOG(LogWit, Verbose, TEXT("ConvertTextToSpeechPipelined: clip found in memory cache (%s)"), *ClipId);
+
+			Clip.MemoryCachedClip.Reset(CachedClip);
+			Clip.bIsMemoryCached = true;
+			Clip.bIsSuccessful = true;
+			Clip.bIsComplete = true;
+
+			continue;
+		}
+
+		// The storage cache may respond before RequestClipAsync returns and that can add further clips so we must not touch the clip
+		// after the request
+
+		const bool bShouldUseStorageCache = StorageCacheHandler != nullptr && StorageCacheHandler->ShouldCache(Clip.ClipSettings.StorageCacheLocation);
+
+		if (bShouldUseStorageCache)
+		{
+			StorageCacheHandler->RequestClipAsync(ClipId, Clip.ClipSettings.StorageCacheLocation,
+				FOnTtsStorageCacheRequestClipCompleteDelegate::CreateUObject(this, &UWitTtsService::OnPipelinedStorageCacheRequestComplete, Clip.SequenceNumber));
+
+			continue;
+		}
+
+		SendPipelinedSynthesizeRequest(Clip.SequenceNumber);
+	}
+
+	DeliverPipelinedClips();
+}
+
+/**
+ * Get the number of pipelined clips that are still waiting on the storage cache or Wit.ai
+ *
+ * @return the number of clips in flight
+ */
+int32 UWitTtsService::GetNumPipelinedClipsInFlight() const
+{
+	int32 NumClipsInFlight = 0;
+
+	for (const FWitTtsPipelinedClip& Clip : PipelinedClips)
+	{
+		if (!Clip.bIsComplete)
+		{
+			++NumClipsInFlight;
+		}
+	}
+
+	return NumClipsInFlight;
+}
+
+/**
+ * Send a pipelined clip to Wit.ai for conversion
+ *
+ * @param SequenceNumber [in] the sequence number of the clip
+ */
+void UWitTtsService::SendPipelinedSynthesizeRequest(const int32 SequenceNumber)
+{
+	FWitTtsPipelinedClip* Clip = FindPipelinedClip(SequenceNumber);
+
+	if (Clip == nullptr)
+	{
+		return;
+	}
+
+	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
+
+	if (RequestSubsystem == nullptr)
+	{
+		UE_LOG(LogWit, Warning, TEXT("SendPipelinedSynthesizeRequest: cannot convert text because request subsystem does not exist"));
+
+		Clip->ErrorMessage = TEXT("No request subsystem");
+		Clip->HumanReadableErrorMessage = TEXT("The request subsystem does not exist");
+		Clip->bIsComplete = true;
+
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("SendPipelinedSynthesizeRequest: converting clip (%d) text (%s) with voice (%s)"), SequenceNumber, *Clip->ClipSettings.Text,
+		*Clip->ClipSettings.Voice);
+
+	FWitRequestConfiguration RequestConfiguration{};
+
+	SetupSynthesizeRequestConfiguration(RequestConfiguration);
+
+	RequestConfiguration.OnRequestError.AddUObject(this, &UWitTtsService::OnPipelinedSynthesizeRequestError, SequenceNumber);
+	RequestConfiguration.OnRequestComplete.AddUObject(this, &UWitTtsService::OnPipelinedSynthesizeRequestComplete, SequenceNumber);
+
+	const TSharedRef<FJsonObject> RequestBody = CreateSynthesizeRequestBody(Clip->ClipSettings);
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+
+	// The clip must not be accessed after the request ends since a completion callback may add further clips
+
+	Clip->RequestHandle = RequestHandle;
+
+	RequestSubsystem->WriteJsonData(RequestHandle, RequestBody);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
+}
+
+/**
+ * Called when the storage cache responds to a request for a pipelined clip. If the clip was not found we request it from Wit.ai
+ *
+ * @param bIsSuccessful [in] was the clip found in the storage cache?
+ * @param ClipData [in] the binary data of the clip
+ * @param SequenceNumber [in] the sequence number of the clip
+ */
+void UWitTtsService::OnPipelinedStorageCacheRequestComplete(const bool bIsSuccessful, const TArray<uint8>& ClipData, const int32 SequenceNumber)
+{
+	FWitTtsPipelinedClip* Clip = FindPipelinedClip(SequenceNumber);
+
+	if (Clip == nullptr)
+	{
+		return;
+	}
+
+	if (!bIsSuccessful)
+	{
+		SendPipelinedSynthesizeRequest(SequenceNumber);
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("OnPipelinedStorageCacheRequestComplete: clip (%d) found in storage cache"), SequenceNumber);
+
+	Clip->BinaryResponse = ClipData;
+	Clip->bIsStorageCached = true;
+	Clip->bIsSuccessful = true;
+	Clip->bIsComplete = true;
+
+	ConvertTextToSpeechPipelined();
+}
+
+/**
+ * Deliver completed pipelined clips in the order they were requested. A clip that completes early is held until every clip before it
+ * has been delivered so playback order always matches the text. Delivery calls out to user code and the caches which can complete
+ * further clips synchronously. Any such nested call is ignored since the outer loop picks those clips up
+ */
+void UWitTtsService::DeliverPipelinedClips()
+{
+	if (bIsDeliveringPipelinedClips)
+	{
+		return;
+	}
+
+	TGuardValue<bool> DeliveringGuard(bIsDeliveringPipelinedClips, true);
+
+	bool bHasDeliveredClip = false;
+
+	while (!PipelinedClips.IsEmpty() && PipelinedClips[0].bIsComplete)
+	{
+		const FWitTtsPipelinedClip Clip = MoveTemp(PipelinedClips[0]);
+
+		PipelinedClips.RemoveAt(0);
+		bHasDeliveredClip = true;
+
+		if (!Clip.bIsSuccessful)
+		{
+			OnSynthesizeRequestError(Clip.ErrorMessage, Clip.HumanReadableErrorMessage);
+			continue;
+		}
+
+		const FString ClipId = FWitHelperUtilities::GetVoiceClipId(Clip.ClipSettings);
+		USoundWave* SoundWave = nullptr;
+
+		if (Clip.bIsMemoryCached)
+		{
+			SoundWave = Clip.MemoryCachedClip.Get();
+		}
+		else
+		{
+			SoundWave = CreateSoundWaveAndAddToMemoryCache(ClipId, Clip.BinaryResponse, Clip.ClipSettings);
+		}
+
+		if (SoundWave == nullptr)
+		{
+			OnSynthesizeRequestError(TEXT("Sound wave creation failed"), TEXT("Creating a sound wave from the response failed"));
+			continue;
+		}
+
+		const bool bShouldUseStorageCache = !Clip.bIsMemoryCached && !Clip.bIsStorageCached && StorageCacheHandler != nullptr &&
+			StorageCacheHandler->ShouldCache(Clip.ClipSettings.StorageCacheLocation);
+
+		if (bShouldUseStorageCache)
+		{
+			StorageCacheHandler->AddClipAsync(ClipId, Clip.BinaryResponse, Clip.ClipSettings, FOnTtsStorageCacheAddClipCompleteDelegate());
+		}
+
+		if (EventHandler != nullptr)
+		{
+			if (!Clip.bIsMemoryCached)
+			{
+				EventHandler->OnSynthesizeRawResponseMulticast.Broadcast(Clip.BinaryResponse);
+				EventHandler->OnSynthesizeRawResponse.Broadcast(ClipId, Clip.BinaryResponse, Clip.ClipSettings);
+			}
+
+			EventHandler->OnSynthesizeResponse.Broadcast(true, SoundWave);
+		}
+
+		MarkSynthesisClipDelivered();
+	}
+
+	const bool bIsSynthesisComplete = bHasDeliveredClip && PipelinedClips.IsEmpty() && QueuedSettings.IsEmpty();
+
+	if (bIsSynthesisComplete)
+	{
+		FinishSynthesisTiming(TEXT("pipelined"));
+	}
+}
+
+/**
+ * Cancel all pipelined clips that have not been delivered yet
+ */
+void UWitTtsService::CancelPipelinedClips()
+{
+	UWitRequestSubsystem* RequestSubsystem = GEngine != nullptr ? GEngine->GetEngineSubsystem<UWitRequestSubsystem>() : nullptr;
+
+	if (RequestSubsystem != nullptr)
+	{
+		for (const FWitTtsPipelinedClip& Clip : PipelinedClips)
+		{
+			RequestSubsystem->CancelRequest(Clip.RequestHandle);
+		}
+	}
+
+	PipelinedClips.Empty();
+}
+
+/**
+ * Find a pipelined clip by its sequence number
+ *
+ * @param SequenceNumber [in] the sequence number of the clip
+ * @return the clip or null if it has been cancelled
+ */
+FWitTtsPipelinedClip* UWitTtsService::FindPipelinedClip(const int32 SequenceNumber)
+{
+	return PipelinedClips.FindByPredicate([SequenceNumber](const FWitTtsPipelinedClip& Clip)
+	{
+		return Clip.SequenceNumber == SequenceNumber;
+	});
+}
+
+/**
+ * Called when a pipelined Wit synthesize request is successfully completed. The clip is held until it can be delivered in order and
+ * the freed slot is used to send the next queued clip
+ *
+ * @param BinaryResponse [in] the final binary response
+ * @param JsonResponse [in] the final Json response
+ * @param SequenceNumber [in] the sequence number of the clip
+ */
+void UWitTtsService::OnPipelinedSynthesizeRequestComplete(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse, const int32 SequenceNumber)
+{
+	FWitTtsPipelinedClip* Clip = FindPipelinedClip(SequenceNumber);
+
+	if (Clip == nullptr)
+	{
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("OnPipelinedSynthesizeRequestComplete - Clip (%d) response size: %d"), SequenceNumber, BinaryResponse.Num());
+
+	Clip->RequestHandle.Reset();
+	Clip->BinaryResponse = BinaryResponse;
+	Clip->bIsSuccessful = true;
+	Clip->bIsComplete = true;
+
+	ConvertTextToSpeechPipelined();
+}
+
+/**
+ * Called when a pipelined Wit synthesize request errors. The error is reported when the clip's turn to be delivered comes
+ *
+ * @param ErrorMessage [in] the error message
+ * @param HumanReadableErrorMessage [in] longer human readable error message
+ * @param SequenceNumber [in] the sequence number of the clip
+ */
+void UWitTtsService::OnPipelinedSynthesizeRequestError(const FString& ErrorMessage, const FString& HumanReadableErrorMessage, const int32 SequenceNumber)
+{
+	FWitTtsPipelinedClip* Clip = FindPipelinedClip(SequenceNumber);
+
+	if (Clip == nullptr)
+	{
+		return;
+	}
+
+	Clip->RequestHandle.Reset();
+	Clip->ErrorMessage = ErrorMessage;
+	Clip->HumanReadableErrorMessage = HumanReadableErrorMessage;
+	Clip->bIsComplete = true;
+
+	ConvertTextToSpeechPipelined();
+}
+
+/**
+ * Start timing a new synthesis
+ */
+void UWitTtsService::StartSynthesisTiming()
+{
+	SynthesisStartTime = FPlatformTime::Seconds();
+	SynthesisFirstAudioTime = 0.0;
+	SynthesisNumClips = 0;
+}
+
+/**
+ * Record that the first audio of the current synthesis is available
+ */
+void UWitTtsService::MarkSynthesisFirstAudio()
+{
+	if (SynthesisFirstAudioTime == 0.0)
+	{
+		SynthesisFirstAudioTime = FPlatformTime::Seconds();
+	}
+}
+
+/**
+ * Record that a clip of the current synthesis has been delivered
+ */
+void UWitTtsService::MarkSynthesisClipDelivered()
+{
+	MarkSynthesisFirstAudio();
+	++SynthesisNumClips;
+}
+
+/**
+ * Log the timing of the current synthesis once every clip has been delivered. Comparing the output with different values of
+ * MaxPipelinedRequests shows the effect of pipelining on both time to first audio and total synthesis time
+ *
+ * @param Mode [in] description of how the clips were requested
+ */
+void UWitTtsService::FinishSynthesisTiming(const TCHAR* Mode) const
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double TimeToFirstAudio = (SynthesisFirstAudioTime > 0.0 ? SynthesisFirstAudioTime : CurrentTime) - SynthesisStartTime;
+	const double TotalSynthesisTime = CurrentTime - SynthesisStartTime;
+
+	UE_LOG(LogWit, Verbose, TEXT("FinishSynthesisTiming: (%s) synthesized (%d) clips - time to first audio (%.3f) seconds, total synthesis time (%.3f) seconds"),
+		Mode, SynthesisNumClips, TimeToFirstAudio, TotalSynthesisTime);
+}
+
 /**
  * Fetch a list of available voices from Wit
  */
@@ -482,7 +954,7 @@ void UWitTtsService::FetchAvailableVoices()
 		return;
 	}
 
-	if (RequestSubsystem->IsRequestInProgress())
+	if (RequestSubsystem->IsRequestInProgress(VoicesRequestHandle))
 	{
 		UE_LOG(LogWit, Warning, TEXT("FetchAvailableVoices: cannot fetch available voicest because a request is already in progress"));
 		return;
@@ -505,8 +977,8 @@ void UWitTtsService::FetchAvailableVoices()
 	RequestConfiguration.OnRequestError.AddUObject(this, &UWitTtsService::OnVoicesRequestError);
 	RequestConfiguration.OnRequestComplete.AddUObject(this, &UWitTtsService::OnVoicesRequestComplete);
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	VoicesRequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(VoicesRequestHandle);
 }
 
 
@@ -522,7 +994,7 @@ void UWitTtsService::OnSocketStateChange()
 
 	if (SocketStatus == ESocketState::Authenticated)
 	{
-		if (bUseWebSocket && !SocketSubsystem->IsSynthesizeInProgress() && !QueuedSettings.IsEmpty())
+		if (bUseWebSocket && !SocketSubsystem->IsRequestInProgress(SocketRequestId) && !QueuedSettings.IsEmpty())
 		{
 			const bool bNewRequest = true;
 			const bool bQueueAudio = true;
@@ -540,6 +1012,8 @@ void UWitTtsService::OnSocketStateChange()
  */
 void UWitTtsService::OnSocketStreamComplete()
 {
+	SocketRequestId.Reset();
+
 	if (bUseWebSocket && !QueuedSettings.IsEmpty())
 	{
 		const bool bNewRequest = true;
@@ -548,6 +1022,71 @@ void UWitTtsService::OnSocketStreamComplete()
 	}
 }
 
+/**
+ * Called when a WebSocket stream fails. The rest of the queue is resumed when the connection is authenticated again
+ *
+ * @param ErrorMessage [in] the error message
+ * @param HumanReadableErrorMessage [in] a human readable version of the error message
+ */
+void UWitTtsService::OnSocketStreamError(const FString& ErrorMessage, const FString& HumanReadableErrorMessage)
+{
+	SocketRequestId.Reset();
+
+	OnSynthesizeRequestError(ErrorMessage, HumanReadableErrorMessage);
+}
+
+/**
+ * Called when the storage cache responds to a request for the clip at the front of the queue. If the clip was found it is delivered
+ * and the queue moves on, otherwise we request it from Wit.ai
+ *
+ * @param bIsSuccessful [in] was the clip found in the storage cache?
+ * @param ClipData [in] the binary data of the clip
+ * @param ClipId [in] the id of the clip that was requested
+ * @param bQueueAudio [in] should audio be placed in a queue
+ */
+void UWitTtsService::OnStorageCacheRequestClipComplete(const bool bIsSuccessful, const TArray<uint8>& ClipData, const FString ClipId, const bool bQueueAudio)
+{
+	bIsStorageCacheRequestInProgress = false;
+
+	// The queue may have been replaced while we were waiting in which case we start on whatever is now at the front
+
+	const bool bIsStale = QueuedSettings.IsEmpty() || FWitHelperUtilities::GetVoiceClipId(QueuedSettings[0]) != ClipId;
+
+	if (bIsStale)
+	{
+		if (!QueuedSettings.IsEmpty())
+		{
+			ConvertTextToSpeechWithSettingsInternal(false, true);
+		}
+
+		return;
+	}
+
+	if (!bIsSuccessful)
+	{
+		SendSynthesizeRequest(bQueueAudio);
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("OnStorageCacheRequestClipComplete: clip found in storage cache (%s)"), *ClipId);
+
+	const FTtsConfiguration ClipSettings = QueuedSettings[0];
+
+	QueuedSettings.RemoveAt(0);
+
+	OnStorageCacheRequestComplete(ClipData, ClipSettings);
+	MarkSynthesisClipDelivered();
+
+	if (!QueuedSettings.IsEmpty())
+	{
+		ConvertTextToSpeechWithSettingsInternal(false, true);
+	}
+	else
+	{
+		FinishSynthesisTiming(TEXT("serial"));
+	}
+}
+
 /**
  * Called when a storage cache request is successfully completed. The binary data will contain the audio wav for the converted text
  *
@@ -604,7 +1143,7 @@ void UWitTtsService::OnSynthesizeRequestComplete(const TArray<uint8>& BinaryResp
 
 	if (bShouldUseStorageCache)
 	{
-		StorageCacheHandler->AddClip(ClipId, BinaryResponse, LastRequestedClipSettings);
+		StorageCacheHandler->AddClipAsync(ClipId, BinaryResponse, LastRequestedClipSettings, FOnTtsStorageCacheAddClipCompleteDelegate());
 	}
 
 #if WITH_EDITORONLY_DATA
@@ -637,6 +1176,8 @@ void UWitTtsService::OnSynthesizeRequestComplete(const TArray<uint8>& BinaryResp
 			const bool bShouldCheckSize = true;
 			AddProceduralData(RawData, RawDataSize, bShouldCheckSize);
 		}
+
+		MarkSynthesisClipDelivered();
 	}
 
 	bStopInProgressRequest = false;
@@ -645,6 +1186,10 @@ void UWitTtsService::OnSynthesizeRequestComplete(const TArray<uint8>& BinaryResp
 	{
 		ConvertTextToSpeechWithSettingsInternal(false, true);
 	}
+	else
+	{
+		FinishSynthesisTiming(bUseStreaming ? TEXT("streaming") : TEXT("serial"));
+	}
 }
 
 /** Called when a Wit synthesize request is in progress to process the incremental payload
@@ -653,6 +1198,18 @@ void UWitTtsService::OnSynthesizeRequestComplete(const TArray<uint8>& BinaryResp
 * @param ClipSettings [in] the clip settings for the clip
 */
 void UWitTtsService::OnSynthesizeRequestProgress(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse)
+{
+	OnSynthesizeStreamProgress(BinaryResponse, JsonResponse);
+}
+
+/**
+ * Called when a WebSocket synthesize stream is in progress to process the incremental payload. The payload is a view of the received
+ * message and is only valid for the duration of the call
+ *
+ * @param BinaryResponse [in] the incremental binary response
+ * @param JsonResponse [in] the incremental Json response
+ */
+void UWitTtsService::OnSynthesizeStreamProgress(TArrayView<const uint8> BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse)
 {
 	if (bStopInProgressRequest)
 	{
@@ -661,10 +1218,24 @@ void UWitTtsService::OnSynthesizeRequestProgress(const TArray<uint8>& BinaryResp
 	}
 	const uint8* RawData = BinaryResponse.GetData();
 	const int32 RawDataSize = BinaryResponse.Num() % 2 == 0 ? BinaryResponse.Num() : BinaryResponse.Num() - 1;
-	const bool bShouldCheckSize = false;
+
+	// WebSocket audio arrives as increments that the socket subsystem has already gathered up to the minimum buffer length, apart from
+	// the final increment, so it is always queued. HTTP audio is the whole response so far and is only queued once it is long enough
+
+	const bool bShouldCheckSize = bUseWebSocket;
 	AddProceduralData(RawData, RawDataSize, bShouldCheckSize);
 }
 
+/**
+ * Get the amount of streamed audio to gather before playback starts
+ *
+ * @return the length in bytes
+ */
+int32 UWitTtsService::GetMinimumStreamBufferLength() const
+{
+	return BytesPerDataSample * DefaultSampleRate * InitialStreamBufferSize;
+}
+
 /**
  * Called when a synthesize request errors
  *
@@ -752,7 +1323,7 @@ USoundWave* UWitTtsService::CreateSoundWaveAndAddToMemoryCache(const FString& Cl
 */
 void UWitTtsService::AddProceduralData(const uint8* RawData, const int32 RawDataSize, bool bShouldCheckSize)
 {
-	const int32 MinBufferLength = BytesPerDataSample * DefaultSampleRate * InitialStreamBufferSize;
+	const int32 MinBufferLength = GetMinimumStreamBufferLength();
 
 	if (!SoundWaveProcedural)
 	{
@@ -767,6 +1338,7 @@ void UWitTtsService::AddProceduralData(const uint8* RawData, const int32 RawData
 		if (EventHandler)
 		{
 			EventHandler->OnSynthesizeResponse.Broadcast(true, SoundWaveProcedural);
+			MarkSynthesisFirstAudio();
 		}
 	}
 	SoundWaveProcedural->Duration = float(RawDataSize) / BytesPerDataSample / DefaultSampleRate;
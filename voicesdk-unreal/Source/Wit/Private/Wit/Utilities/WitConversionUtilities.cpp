@@ -8,6 +8,25 @@
 #include "Wit/Utilities/WitConversionUtilities.h"
 #include <limits>
 
+// The vector kernels load 16-bit samples straight from the byte stream so they rely on the samples and the CPU being little endian.
+// Any samples left over after the last full vector are handled by the scalar code that follows each kernel
+
+#if PLATFORM_LITTLE_ENDIAN && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define WIT_CONVERSION_USE_NEON 1
+#include <arm_neon.h>
+#elif PLATFORM_LITTLE_ENDIAN && PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#define WIT_CONVERSION_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+#ifndef WIT_CONVERSION_USE_NEON
+#define WIT_CONVERSION_USE_NEON 0
+#endif
+
+#ifndef WIT_CONVERSION_USE_SSE
+#define WIT_CONVERSION_USE_SSE 0
+#endif
+
 /**
  * Convert a sequence of stereo samples into mono samples
  *
@@ -17,7 +36,38 @@
  */
 void FWitConversionUtilities::ConvertSamplesStereoToMono(const float* InSamples, const int32 NumSamples, float* OutSamples)
 {
-	for (int32 i = 0; i < NumSamples / 2; ++i)
+	const int32 NumOutSamples = NumSamples / 2;
+	int32 i = 0;
+
+#if WIT_CONVERSION_USE_NEON
+
+	const float32x4_t Half = vdupq_n_f32(0.5f);
+
+	for (; i + 4 <= NumOutSamples; i += 4)
+	{
+		const float32x4x2_t StereoSamples = vld2q_f32(InSamples + i * 2);
+
+		vst1q_f32(OutSamples + i, vmulq_f32(vaddq_f32(StereoSamples.val[0], StereoSamples.val[1]), Half));
+	}
+
+#elif WIT_CONVERSION_USE_SSE
+
+	const __m128 Half = _mm_set1_ps(0.5f);
+
+	for (; i + 4 <= NumOutSamples; i += 4)
+	{
+		const __m128 FirstPair = _mm_loadu_ps(InSamples + i * 2);
+		const __m128 SecondPair = _mm_loadu_ps(InSamples + i * 2 + 4);
+
+		const __m128 LeftSamples = _mm_shuffle_ps(FirstPair, SecondPair, _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 RightSamples = _mm_shuffle_ps(FirstPair, SecondPair, _MM_SHUFFLE(3, 1, 3, 1));
+
+		_mm_storeu_ps(OutSamples + i, _mm_mul_ps(_mm_add_ps(LeftSamples, RightSamples), Half));
+	}
+
+#endif
+
+	for (; i < NumOutSamples; ++i)
 	{
 		const float LeftSample = InSamples[i * 2];
 		const float RightSample = InSamples[i * 2 + 1];
@@ -46,7 +96,7 @@ void FWitConversionUtilities::ConvertSamplesFloatTo8Bit(const float* InSamples,
 }
 
 /**
- * Convert a sequence of floating point samples into 16-bit unsigned samples
+ * Convert a sequence of floating point samples into 16-bit unsigned samples. Samples outside the range -1 -> 1 are clamped
  *
  * @param InSamples [in] the input sequence of floating point samples. The InSamples array must contain NumSamples entries
  * @param NumSamples [in] the input count of samples
@@ -54,14 +104,49 @@ void FWitConversionUtilities::ConvertSamplesFloatTo8Bit(const float* InSamples,
  */
 void FWitConversionUtilities::ConvertSamplesFloatTo16Bit(const float* InSamples, const int32 NumSamples, uint8* OutSamples)
 {
-	constexpr int32 ScaleFactor = std::numeric_limits<int16>::max();
+	constexpr float ScaleFactor = std::numeric_limits<int16>::max();
 
-	for (int32 i = 0; i < NumSamples; ++i)
+	// Samples are clamped to the range -1 -> 1 before scaling so out of range input saturates rather than wrapping
+
+	int32 i = 0;
+
+#if WIT_CONVERSION_USE_NEON
+
+	const float32x4_t Scale = vdupq_n_f32(ScaleFactor);
+	const float32x4_t Minimum = vdupq_n_f32(-1.0f);
+	const float32x4_t Maximum = vdupq_n_f32(1.0f);
+
+	for (; i + 8 <= NumSamples; i += 8)
 	{
-		// There's an assumption here that InSamples are already in the range -1 -> 1. If this assumption is not valid then
-		// clamping should be introduced
-		
-		const int16 ScaledSample = static_cast<int16>(InSamples[i] * ScaleFactor);
+		const float32x4_t LowSamples = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(InSamples + i), Minimum), Maximum), Scale);
+		const float32x4_t HighSamples = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(InSamples + i + 4), Minimum), Maximum), Scale);
+
+		const int16x8_t ScaledSamples = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(LowSamples)), vqmovn_s32(vcvtq_s32_f32(HighSamples)));
+
+		vst1q_s16(reinterpret_cast<int16*>(OutSamples + i * 2), ScaledSamples);
+	}
+
+#elif WIT_CONVERSION_USE_SSE
+
+	const __m128 Scale = _mm_set1_ps(ScaleFactor);
+	const __m128 Minimum = _mm_set1_ps(-1.0f);
+	const __m128 Maximum = _mm_set1_ps(1.0f);
+
+	for (; i + 8 <= NumSamples; i += 8)
+	{
+		const __m128 LowSamples = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(InSamples + i), Minimum), Maximum), Scale);
+		const __m128 HighSamples = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(InSamples + i + 4), Minimum), Maximum), Scale);
+
+		const __m128i ScaledSamples = _mm_packs_epi32(_mm_cvttps_epi32(LowSamples), _mm_cvttps_epi32(HighSamples));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(OutSamples + i * 2), ScaledSamples);
+	}
+
+#endif
+
+	for (; i < NumSamples; ++i)
+	{
+		const int16 ScaledSample = static_cast<int16>(FMath::Clamp(InSamples[i], -1.0f, 1.0f) * ScaleFactor);
 
 		OutSamples[i * 2] = static_cast<int8>(ScaledSample & 0xff);
 		OutSamples[i * 2 + 1] = static_cast<int8>((ScaledSample >> 8) & 0xff);
@@ -96,12 +181,52 @@ void FWitConversionUtilities::ConvertSamples8BitToFloat(const uint8* InSamples,
  */
 void FWitConversionUtilities::ConvertSamples16BitToFloat(const uint8* InSamples, const int32 NumSamples, float* OutSamples)
 {
-	constexpr float ScaleFactor = std::numeric_limits<int16>::max();
+	// Every path multiplies by the reciprocal so the vector and scalar results are identical
 
-	for (int32 i = 0; i < NumSamples; ++i)
+	constexpr float ScaleFactor = 1.0f / std::numeric_limits<int16>::max();
+
+	int32 i = 0;
+
+#if WIT_CONVERSION_USE_NEON
+
+	const float32x4_t Scale = vdupq_n_f32(ScaleFactor);
+	const float32x4_t Minimum = vdupq_n_f32(-1.0f);
+
+	for (; i + 8 <= NumSamples; i += 8)
+	{
+		const int16x8_t InSampleValues = vld1q_s16(reinterpret_cast<const int16*>(InSamples + i * 2));
+
+		const float32x4_t LowSamples = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(InSampleValues))), Scale);
+		const float32x4_t HighSamples = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(InSampleValues))), Scale);
+
+		vst1q_f32(OutSamples + i, vmaxq_f32(LowSamples, Minimum));
+		vst1q_f32(OutSamples + i + 4, vmaxq_f32(HighSamples, Minimum));
+	}
+
+#elif WIT_CONVERSION_USE_SSE
+
+	const __m128 Scale = _mm_set1_ps(ScaleFactor);
+	const __m128 Minimum = _mm_set1_ps(-1.0f);
+
+	for (; i + 8 <= NumSamples; i += 8)
+	{
+		const __m128i InSampleValues = _mm_loadu_si128(reinterpret_cast<const __m128i*>(InSamples + i * 2));
+
+		// Interleaving a sample with itself and shifting back down sign extends it to 32 bits
+
+		const __m128i LowSampleValues = _mm_srai_epi32(_mm_unpacklo_epi16(InSampleValues, InSampleValues), 16);
+		const __m128i HighSampleValues = _mm_srai_epi32(_mm_unpackhi_epi16(InSampleValues, InSampleValues), 16);
+
+		_mm_storeu_ps(OutSamples + i, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(LowSampleValues), Scale), Minimum));
+		_mm_storeu_ps(OutSamples + i + 4, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(HighSampleValues), Scale), Minimum));
+	}
+
+#endif
+
+	for (; i < NumSamples; ++i)
 	{
 		const int16 InSampleValue = InSamples[i * 2] | (InSamples[i * 2 + 1] << 8);
-		const float ScaledSample = static_cast<float>(InSampleValue) / ScaleFactor;
+		const float ScaledSample = static_cast<float>(InSampleValue) * ScaleFactor;
 
 		OutSamples[i] = ScaledSample < -1.0f ? -1.0f : ScaledSample;
 	}
@@ -117,8 +242,61 @@ void FWitConversionUtilities::ConvertSamples16BitToFloat(const uint8* InSamples,
 float FWitConversionUtilities::CalculateMaximumAmplitude16Bit(const uint8* InSamples, const int32 NumSamples)
 {
 	int32 MaximumAmplitude = 0;
-	
-	for (int32 i = 0; i < NumSamples; ++i)
+	int32 i = 0;
+
+	// The vector kernels track the largest and smallest sample rather than the absolute value because the absolute value of the
+	// smallest 16-bit sample does not fit in 16 bits
+
+#if WIT_CONVERSION_USE_NEON || WIT_CONVERSION_USE_SSE
+
+	if (NumSamples >= 8)
+	{
+		int16 LargestSamples[8];
+		int16 SmallestSamples[8];
+
+#if WIT_CONVERSION_USE_NEON
+
+		int16x8_t LargestSampleValues = vdupq_n_s16(0);
+		int16x8_t SmallestSampleValues = vdupq_n_s16(0);
+
+		for (; i + 8 <= NumSamples; i += 8)
+		{
+			const int16x8_t InSampleValues = vld1q_s16(reinterpret_cast<const int16*>(InSamples + i * 2));
+
+			LargestSampleValues = vmaxq_s16(LargestSampleValues, InSampleValues);
+			SmallestSampleValues = vminq_s16(SmallestSampleValues, InSampleValues);
+		}
+
+		vst1q_s16(LargestSamples, LargestSampleValues);
+		vst1q_s16(SmallestSamples, SmallestSampleValues);
+
+#else
+
+		__m128i LargestSampleValues = _mm_setzero_si128();
+		__m128i SmallestSampleValues = _mm_setzero_si128();
+
+		for (; i + 8 <= NumSamples; i += 8)
+		{
+			const __m128i InSampleValues = _mm_loadu_si128(reinterpret_cast<const __m128i*>(InSamples + i * 2));
+
+			LargestSampleValues = _mm_max_epi16(LargestSampleValues, InSampleValues);
+			SmallestSampleValues = _mm_min_epi16(SmallestSampleValues, InSampleValues);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(LargestSamples), LargestSampleValues);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(SmallestSamples), SmallestSampleValues);
+
+#endif
+
+		for (int32 Lane = 0; Lane < 8; ++Lane)
+		{
+			MaximumAmplitude = FMath::Max(MaximumAmplitude, FMath::Max(static_cast<int32>(LargestSamples[Lane]), -static_cast<int32>(SmallestSamples[Lane])));
+		}
+	}
+
+#endif
+
+	for (; i < NumSamples; ++i)
 	{
 		const int16 InSampleValue = InSamples[i * 2] | (InSamples[i * 2 + 1] << 8);
 		const int32 Amplitude = std::abs(InSampleValue);
@@ -35,7 +35,7 @@ public:
 	static void ConvertSamplesFloatTo8Bit(const float* InSamples, int32 NumSamples, uint8* OutSamples);
 
 	/**
-     * Convert a sequence of floating point samples into 16-bit unsigned samples
+     * Convert a sequence of floating point samples into 16-bit unsigned samples. Samples outside the range -1 -> 1 are clamped
      *
      * @param InSamples [in] the input sequence of floating point samples. The InSamples array must contain NumSamples entries
      * @param NumSamples [in] the input count of samples
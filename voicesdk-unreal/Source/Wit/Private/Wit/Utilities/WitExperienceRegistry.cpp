@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Wit/Utilities/WitExperienceRegistry.h"
+#include "GameFramework/Actor.h"
+#include "Wit/Utilities/WitLog.h"
+
+/**
+ * De-initializes the subsystem. USubsystem override
+ */
+void UWitExperienceRegistry::Deinitialize()
+{
+	Experiences.Empty();
+	TaggedExperiences.Empty();
+
+	Super::Deinitialize();
+}
+
+/**
+ * Add an experience to the registry. Registering an experience that is already registered does nothing
+ *
+ * @param Experience [in] the experience to add
+ */
+void UWitExperienceRegistry::RegisterExperience(AActor* Experience)
+{
+	if (Experience == nullptr || Experiences.Contains(Experience))
+	{
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("RegisterExperience: registering experience (%s) with (%d) tags"), *Experience->GetName(), Experience->Tags.Num());
+
+	Experiences.Add(Experience);
+
+	for (const FName& Tag : Experience->Tags)
+	{
+		AddTaggedExperience(Experience, Tag);
+	}
+}
+
+/**
+ * Remove an experience from the registry
+ *
+ * @param Experience [in] the experience to remove
+ */
+void UWitExperienceRegistry::UnregisterExperience(AActor* Experience)
+{
+	if (Experience == nullptr)
+	{
+		return;
+	}
+
+	UE_LOG(LogWit, Verbose, TEXT("UnregisterExperience: unregistering experience (%s)"), *Experience->GetName());
+
+	const TWeakObjectPtr<AActor> ExperienceToRemove(Experience);
+
+	Experiences.Remove(ExperienceToRemove);
+
+	// Tags can change while the experience is registered so we can't rely on its current tags to find every entry
+
+	for (auto It = TaggedExperiences.CreateIterator(); It; ++It)
+	{
+		It.Value().Remove(ExperienceToRemove);
+
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+/**
+ * Find a registered experience of the given class. If more than one matches then the first registered is returned
+ *
+ * @param ExperienceClass [in] the class the experience must be
+ * @param Tag [in] the tag the experience must have. If none then any experience of the class matches
+ *
+ * @return the experience if found otherwise null
+ */
+AActor* UWitExperienceRegistry::FindExperience(const UClass* ExperienceClass, const FName& Tag)
+{
+	const bool bIsValidTag = !Tag.IsNone() && Tag.IsValid();
+
+	if (!bIsValidTag)
+	{
+		for (const TWeakObjectPtr<AActor>& Experience : Experiences)
+		{
+			if (Experience.IsValid() && Experience->IsA(ExperienceClass))
+			{
+				return Experience.Get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	// The tag was current when the experience registered but may have been removed since so check it is still there
+
+	const TArray<TWeakObjectPtr<AActor>>* ExperiencesWithTag = TaggedExperiences.Find(Tag);
+
+	if (ExperiencesWithTag != nullptr)
+	{
+		for (const TWeakObjectPtr<AActor>& Experience : *ExperiencesWithTag)
+		{
+			if (Experience.IsValid() && Experience->IsA(ExperienceClass) && Experience->ActorHasTag(Tag))
+			{
+				return Experience.Get();
+			}
+		}
+	}
+
+	// The tag may have been added after the experience registered. There are only ever a handful of experiences so this is still cheap
+
+	for (const TWeakObjectPtr<AActor>& Experience : Experiences)
+	{
+		if (Experience.IsValid() && Experience->IsA(ExperienceClass) && Experience->ActorHasTag(Tag))
+		{
+			AActor* FoundExperience = Experience.Get();
+
+			AddTaggedExperience(FoundExperience, Tag);
+
+			return FoundExperience;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * Add an experience to the lookup for a single tag
+ *
+ * @param Experience [in] the experience to add
+ * @param Tag [in] the tag to add it under
+ */
+void UWitExperienceRegistry::AddTaggedExperience(AActor* Experience, const FName& Tag)
+{
+	if (Tag.IsNone())
+	{
+		return;
+	}
+
+	TaggedExperiences.FindOrAdd(Tag).AddUnique(Experience);
+}
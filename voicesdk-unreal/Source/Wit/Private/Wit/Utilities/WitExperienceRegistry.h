@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WitExperienceRegistry.generated.h"
+
+class AActor;
+
+/**
+ * Keeps track of the experience actors in a world so they can be found by tag without iterating every actor in the world. Experiences
+ * register themselves when play begins and unregister when it ends
+ */
+UCLASS()
+class UWitExperienceRegistry final : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * De-initializes the subsystem. USubsystem override
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Add an experience to the registry. Registering an experience that is already registered does nothing
+	 *
+	 * @param Experience [in] the experience to add
+	 */
+	void RegisterExperience(AActor* Experience);
+
+	/**
+	 * Remove an experience from the registry
+	 *
+	 * @param Experience [in] the experience to remove
+	 */
+	void UnregisterExperience(AActor* Experience);
+
+	/**
+	 * Find a registered experience of the given class. If more than one matches then the first registered is returned
+	 *
+	 * @param ExperienceClass [in] the class the experience must be
+	 * @param Tag [in] the tag the experience must have. If none then any experience of the class matches
+	 *
+	 * @return the experience if found otherwise null
+	 */
+	AActor* FindExperience(const UClass* ExperienceClass, const FName& Tag);
+
+	/** Get the number of experiences currently registered */
+	int32 GetNumExperiences() const
+	{
+		return Experiences.Num();
+	}
+
+private:
+
+	/** Add an experience to the lookup for a single tag */
+	void AddTaggedExperience(AActor* Experience, const FName& Tag);
+
+	/** All registered experiences in the order they were registered */
+	TArray<TWeakObjectPtr<AActor>> Experiences{};
+
+	/** Registered experiences keyed by each of their tags */
+	TMap<FName, TArray<TWeakObjectPtr<AActor>>> TaggedExperiences{};
+};
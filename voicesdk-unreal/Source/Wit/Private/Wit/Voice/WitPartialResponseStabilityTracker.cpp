@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "Wit/Voice/WitPartialResponseStabilityTracker.h"
+
+/**
+ * Set the settings to use. This also resets the tracker
+ *
+ * @param InSettings [in] the settings to use
+ */
+void FWitPartialResponseStabilityTracker::Configure(const FWitPartialResponseStabilitySettings& InSettings)
+{
+	Settings = InSettings;
+	Settings.MinimumCount = FMath::Max(Settings.MinimumCount, 1);
+
+	Reset();
+}
+
+/**
+ * Reset the tracker ready for a new request
+ */
+void FWitPartialResponseStabilityTracker::Reset()
+{
+	StableIntentName.Reset();
+	StableEntityValues.Reset();
+	NumStablePartialResponses = 0;
+	StableStartTime = 0.0;
+}
+
+/**
+ * Track the next partial response. Any partial response that is not a candidate or that disagrees with the previous ones starts the
+ * count again
+ *
+ * @param Response [in] the partial response
+ * @param CurrentTime [in] the current time in seconds
+ *
+ * @return true if the partial response is stable enough to accept
+ */
+bool FWitPartialResponseStabilityTracker::Update(const FWitResponse& Response, const double CurrentTime)
+{
+	if (!IsCandidate(Response))
+	{
+		Reset();
+		return false;
+	}
+
+	const bool bIsSameAsStable = NumStablePartialResponses > 0 && IsSameAsStable(Response);
+
+	if (bIsSameAsStable)
+	{
+		++NumStablePartialResponses;
+	}
+	else
+	{
+		SetStable(Response, CurrentTime);
+	}
+
+	const bool bIsCountReached = NumStablePartialResponses >= Settings.MinimumCount;
+	const bool bIsTimeReached = NumStablePartialResponses > 1 && GetStableTime(CurrentTime) >= Settings.MinimumTime;
+
+	return bIsCountReached || bIsTimeReached;
+}
+
+/**
+ * Get how long the partial responses have agreed for
+ *
+ * @param CurrentTime [in] the current time in seconds
+ *
+ * @return the time in seconds
+ */
+double FWitPartialResponseStabilityTracker::GetStableTime(const double CurrentTime) const
+{
+	if (NumStablePartialResponses == 0)
+	{
+		return 0.0;
+	}
+
+	return CurrentTime - StableStartTime;
+}
+
+/**
+ * Could the response be accepted if it stays the same? The top intent must be confident enough and every required entity present
+ *
+ * @param Response [in] the partial response
+ *
+ * @return true if the response is a candidate
+ */
+bool FWitPartialResponseStabilityTracker::IsCandidate(const FWitResponse& Response) const
+{
+	const bool bHasIntent = Response.Intents.Num() > 0;
+	if (!bHasIntent)
+	{
+		return false;
+	}
+
+	const bool bIsConfident = Response.Intents[0].Confidence > Settings.ConfidenceThreshold;
+	if (!bIsConfident)
+	{
+		return false;
+	}
+
+	for (const FString& EntityName : Settings.RequiredEntityNames)
+	{
+		if (!Response.Entities.Contains(EntityName))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Does the response agree with the stable response? Only the required entities are compared so a change to an optional entity does not
+ * delay acceptance
+ *
+ * @param Response [in] the partial response
+ *
+ * @return true if the top intent and required entity values are unchanged
+ */
+bool FWitPartialResponseStabilityTracker::IsSameAsStable(const FWitResponse& Response) const
+{
+	if (!Response.Intents[0].Name.Equals(StableIntentName))
+	{
+		return false;
+	}
+
+	for (const TPair<FString, FString>& StableEntityValue : StableEntityValues)
+	{
+		const FWitEntity* Entity = Response.Entities.Find(StableEntityValue.Key);
+
+		if (Entity == nullptr || !Entity->Value.Equals(StableEntityValue.Value))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Start tracking a new stable response
+ *
+ * @param Response [in] the partial response
+ * @param CurrentTime [in] the current time in seconds
+ */
+void FWitPartialResponseStabilityTracker::SetStable(const FWitResponse& Response, const double CurrentTime)
+{
+	StableIntentName = Response.Intents[0].Name;
+	StableEntityValues.Reset();
+
+	// A candidate always has every required entity
+
+	for (const FString& EntityName : Settings.RequiredEntityNames)
+	{
+		const FWitEntity* Entity = Response.Entities.Find(EntityName);
+
+		if (Entity != nullptr)
+		{
+			StableEntityValues.Emplace(EntityName, Entity->Value);
+		}
+	}
+
+	NumStablePartialResponses = 1;
+	StableStartTime = CurrentTime;
+}
@@ -7,6 +7,7 @@
 
 #include "Wit/Voice/WitVoiceService.h"
 #include "Engine/Engine.h"
+#include "HAL/PlatformTime.h"
 #include "JsonObjectConverter.h"
 #include "Voice/Capture/VoiceCaptureSubsystem.h"
 #include "Wit/Request/WitRequestBuilder.h"
@@ -86,12 +87,16 @@ void UWitVoiceService::BeginPlay()
 
 	SetComponentTickEnabled(false);
 
+	if (Configuration != nullptr)
+	{
+		GEngine->GetEngineSubsystem<UWitRequestSubsystem>()->ApplyConfiguration(Configuration->Application.Advanced);
+	}
+
 	if (bUseWebSocket)
 	{
 		UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
 		SocketSubsystem->OnSocketStateChange.AddUObject(this, &UWitVoiceService::OnSocketStateChange);
-		SocketSubsystem->CreateSocket(Configuration->Application.ClientAccessToken);
-		SocketSubsystem->OnSocketStreamProgress.AddUObject(this, &UWitVoiceService::OnSpeechRequestProgress);
+		SocketSubsystem->AddSocketUser(this, Configuration->Application.ClientAccessToken);
 	}
 
 	UE_LOG(LogWit, Display, TEXT("BeginPlay: Connection Started"));
@@ -112,19 +117,23 @@ void UWitVoiceService::BeginDestroy()
 	}
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
-	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress();
+	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress(RequestHandle);
 
 	if (bUseWebSocket)
 	{
 		UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
-		SocketSubsystem->OnSocketStateChange.Clear();
-		SocketSubsystem->OnSocketStreamProgress.Clear();
-		SocketSubsystem->CloseSocket();
+		// The connection is shared with other services so we only remove what is ours. It closes once nothing is using it
+
+		SocketSubsystem->OnSocketStateChange.RemoveAll(this);
+		SocketSubsystem->CancelRequest(SocketRequestId);
+		SocketSubsystem->RemoveSocketUser(this);
+		SocketRequestId.Reset();
 	}
 	
 	if (bIsRequestInProgress)
 	{
-		RequestSubsystem->CancelRequest();
+		RequestSubsystem->CancelRequest(RequestHandle);
+		RequestHandle.Reset();
 	}
 
 	bIsVoiceInputActive = false;
@@ -166,29 +175,50 @@ void UWitVoiceService::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 	const bool bIsVoiceDataAvailable = VoiceCaptureSubsystem->Read();
 	const float CurrentVoiceAmplitude =  VoiceCaptureSubsystem->GetCurrentAmplitude();
 
+	// When voice activity detection is enabled the volume alone is not enough to decide whether the user is speaking because
+	// background noise can be loud and quiet speakers can be quieter than it
+
+	const bool bIsVoiceActivityDetectionEnabled = VoiceCaptureSubsystem->IsVoiceActivityDetectionEnabled();
+	const bool bIsVoiceActive = VoiceCaptureSubsystem->IsVoiceActive();
+
 	LastActivateTime += DeltaTime;
 
 	// If we are not already streaming the voice data to Wit.ai then check to see if we've breached the threshold and should start streaming
 	
 	if (!bIsVoiceStreamingActive)
 	{
-		const bool bIsWakeThresholdReached = bIsVoiceDataAvailable && CurrentVoiceAmplitude > Configuration->Voice.WakeMinimumVolume;
+		const bool bIsWakeVolumeReached = CurrentVoiceAmplitude > Configuration->Voice.WakeMinimumVolume;
+		const bool bIsWakeThresholdReached = bIsVoiceDataAvailable && bIsWakeVolumeReached && (!bIsVoiceActivityDetectionEnabled || bIsVoiceActive);
 		const bool bIsWakeTimeReached = LastActivateTime >= Configuration->Voice.WakeMinimumTime;
 			
 		if (!bIsWakeThresholdReached || !bIsWakeTimeReached)
 		{
 			return;
 		}
+
+		// The endpointer has been listening since capture started. Noise or speech before the wake threshold must not end the
+		// utterance we are about to stream so it starts again from here
+
+		VoiceCaptureSubsystem->ResetEndOfUtterance();
 	
 		BeginStreamRequest();
 	}
 	
 	LastWakeTime += DeltaTime;
 
+	// Once the request can accept voice data we send the pre-roll in place of the latest voice data. It ends with the latest data and
+	// includes what was captured before the wake threshold was reached so the start of the utterance is not lost
+
+	UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
+
+	const bool bIsRequestReady = RequestSubsystem->IsRequestInProgress(RequestHandle) || SocketSubsystem->IsConverseInProgress(SocketRequestId);
+	const bool bIsPreRollFlushed = bIsRequestReady && VoiceCaptureSubsystem->FlushPreRoll();
+	const bool bIsVoiceDataToSend = bIsVoiceDataAvailable || bIsPreRollFlushed;
+
 	// Check for and read any new voice data that is available. Voice data may or may not be available depending on
 	// whether the user breaks a pre-defined volume threshold
 	
-	if (bIsVoiceDataAvailable && RequestSubsystem->IsRequestInProgress())
+	if (bIsVoiceDataToSend && RequestSubsystem->IsRequestInProgress(RequestHandle))
 	{
 #if WITH_EDITORONLY_DATA
 		
@@ -211,22 +241,22 @@ void UWitVoiceService::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 		StreamInputProvider->writeBytes(folly::IOBuf::copyBuffer(&VoiceCaptureSubsystem->GetVoiceBuffer(), VoiceCaptureSubsystem->GetVoiceBuffer().Num()));
 #endif
 #else
-		RequestSubsystem->WriteBinaryData(VoiceCaptureSubsystem->GetVoiceBuffer());
+		RequestSubsystem->WriteBinaryData(RequestHandle, VoiceCaptureSubsystem->GetVoiceBuffer());
 #endif
 	}
 
-	UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
-	if (bIsVoiceDataAvailable && SocketSubsystem->IsConverseInProgress())
+	if (bIsVoiceDataToSend && SocketSubsystem->IsConverseInProgress(SocketRequestId))
 	{
-		SocketSubsystem->SendBinaryData(VoiceCaptureSubsystem->GetVoiceBuffer());
+		SocketSubsystem->SendBinaryData(SocketRequestId, VoiceCaptureSubsystem->GetVoiceBuffer());
 	}
 
 	// Keep track of whether we are actually receiving suitable voice input. This is used in deciding when to auto deactivate
 	// due to no voice input
 
 	const bool bIsAmplitudeAboveMinimumVolume = CurrentVoiceAmplitude > Configuration->Voice.KeepAliveMinimumVolume;
+	const bool bIsVoiceInputDetected = bIsVoiceActivityDetectionEnabled ? bIsVoiceActive : bIsAmplitudeAboveMinimumVolume;
 	
-	if (bIsVoiceDataAvailable && bIsAmplitudeAboveMinimumVolume)
+	if (bIsVoiceDataAvailable && bIsVoiceInputDetected)
 	{
 		LastVoiceTime = 0.0f;
 	}
@@ -235,17 +265,20 @@ void UWitVoiceService::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 		LastVoiceTime += DeltaTime;
 	}
 
-	// Check for auto deactivation. This can happen in two cases
+	// Check for auto deactivation. This can happen in three cases
 	// 1. If we exceed the hard maximum duration that Wit.ai allows for a single speech request
 	// 2. If we exceed a user definable duration since we last received valid voice data
+	// 3. If the user has finished speaking. This is usually much sooner than the keep alive time so the request is sent sooner
 
 	const bool bIsTooLongSinceVoiceDataReceived = (LastVoiceTime >= Configuration->Voice.KeepAliveTime);
 	const bool bIsTooLongSinceActivated = (LastWakeTime >= Configuration->Voice.MaximumRecordingTime);
-	const bool bShouldDeactivate = (bIsTooLongSinceVoiceDataReceived || bIsTooLongSinceActivated);
+	const bool bIsEndOfUtterance = VoiceCaptureSubsystem->IsEndOfUtterance();
+	const bool bShouldDeactivate = (bIsTooLongSinceVoiceDataReceived || bIsTooLongSinceActivated || bIsEndOfUtterance);
 	
 	if (bShouldDeactivate)
 	{
-		UE_LOG(LogWit, Display, TEXT("TickComponent: deactivating voice input - too long since activation (%d) - too long since voice input (%d)"), bIsTooLongSinceActivated, bIsTooLongSinceVoiceDataReceived);
+		UE_LOG(LogWit, Display, TEXT("TickComponent: deactivating voice input - too long since activation (%d) - too long since voice input (%d) - end of utterance (%d)"),
+			bIsTooLongSinceActivated, bIsTooLongSinceVoiceDataReceived, bIsEndOfUtterance);
 
 		const bool bDidDeactivate = DoDeactivateVoiceInput();
 		const bool bShouldCallStopEvent = bDidDeactivate && Events != nullptr;
@@ -256,7 +289,7 @@ void UWitVoiceService::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 			{
 				Events->OnStopVoiceInputDueToTimeout.Broadcast();
 			}
-			else if (bIsTooLongSinceVoiceDataReceived)
+			else if (bIsTooLongSinceVoiceDataReceived || bIsEndOfUtterance)
 			{
 				Events->OnStopVoiceInputDueToInactivity.Broadcast();
 			}
@@ -336,13 +369,13 @@ bool UWitVoiceService::ActivateVoiceInput()
 		return false;
 	}
 
-	if (RequestSubsystem->IsRequestInProgress())
+	if (RequestSubsystem->IsRequestInProgress(RequestHandle))
 	{
 		UE_LOG(LogWit, Warning, TEXT("ActivateVoiceInput: cannot activate voice input because a request is already in progress"));
 		return false;
 	}
 	
-	bIsVoiceInputActive = VoiceCaptureSubsystem->Start();
+	bIsVoiceInputActive = VoiceCaptureSubsystem->Start(Configuration->Voice);
 	
 	if (!bIsVoiceInputActive)
 	{
@@ -375,6 +408,18 @@ bool UWitVoiceService::ActivateVoiceInput()
 	LastVoiceTime = 0.0f;
 	LastActivateTime = 0.0f;
 	LastWakeTime = 0.0f;
+
+	ActivationTime = FPlatformTime::Seconds();
+	DeactivationTime = 0.0;
+
+	FWitPartialResponseStabilitySettings StabilitySettings{};
+
+	StabilitySettings.MinimumCount = Configuration->Voice.StablePartialResponseMinimumCount;
+	StabilitySettings.MinimumTime = Configuration->Voice.StablePartialResponseMinimumTime;
+	StabilitySettings.ConfidenceThreshold = Configuration->Voice.StablePartialResponseConfidenceThreshold;
+	StabilitySettings.RequiredEntityNames = Configuration->Voice.StablePartialResponseRequiredEntities;
+
+	StabilityTracker.Configure(StabilitySettings);
 	
 	// Notify that we've started accepting voice input
 
@@ -444,7 +489,10 @@ void UWitVoiceService::BeginStreamRequest()
 
 		const TSharedPtr<FJsonObject> RequestBody = MakeShared<FJsonObject>();
 		RequestBody->SetStringField("content_type", "audio/raw;bits=16;rate=16k;encoding=signed-integer;endian=little");
-		SocketSubsystem->SendJsonData(ERequestType::Converse, RequestBody.ToSharedRef());
+		SocketRequestId = SocketSubsystem->SendJsonData(ERequestType::Converse, RequestBody.ToSharedRef(),
+			FOnWitSocketRequestProgressDelegate::CreateUObject(this, &UWitVoiceService::OnSpeechStreamProgress),
+			FOnWitSocketRequestCompleteDelegate::CreateUObject(this, &UWitVoiceService::OnSpeechStreamComplete),
+			FOnWitSocketRequestErrorDelegate::CreateUObject(this, &UWitVoiceService::OnWitRequestError));
 	}
 	else
 	{
@@ -494,10 +542,11 @@ void UWitVoiceService::BeginStreamRequest()
 
 		RequestConfiguration.bShouldUseCustomHttpTimeout = Configuration->Application.Advanced.bIsCustomHttpTimeout;
 		RequestConfiguration.HttpTimeout = Configuration->Application.Advanced.HttpTimeout;
+		RequestConfiguration.bShouldRecycleResponses = Configuration->Application.Advanced.bIsResponseRecyclingEnabled;
 
 		RequestConfiguration.OnRequestError.AddUObject(this, &UWitVoiceService::OnWitRequestError);
-		RequestConfiguration.OnRequestProgress.AddUObject(this, &UWitVoiceService::OnSpeechRequestProgress);
-		RequestConfiguration.OnRequestComplete.AddUObject(this, &UWitVoiceService::OnSpeechRequestComplete);
+		RequestConfiguration.OnResponseProgress.AddUObject(this, &UWitVoiceService::OnSpeechResponseProgress);
+		RequestConfiguration.OnResponseComplete.AddUObject(this, &UWitVoiceService::OnSpeechResponseComplete);
 
 		if (Events != nullptr)
 		{
@@ -506,7 +555,7 @@ void UWitVoiceService::BeginStreamRequest()
 		// Begin a streamed request to Wit.ai. For a streamed request we open an HTTP request to the server and continually write data as it
 		// becomes available. This greatly reduces latency over waiting for the whole voice data and then sending it
 
-		RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+		RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
 #endif
 	}
 
@@ -573,6 +622,39 @@ bool UWitVoiceService::DoDeactivateVoiceInput()
 	if (bIsVoiceCapturing)
 	{
 		VoiceCaptureSubsystem->Stop();
+
+		// Stopping hands back whatever was captured since the last read. Send it before the request ends so the end of the utterance
+		// is not lost
+
+		const TArray<uint8>& RemainingVoiceData = VoiceCaptureSubsystem->GetVoiceBuffer();
+
+		if (bIsVoiceStreamingActive && RemainingVoiceData.Num() > 0)
+		{
+#if WITH_EDITORONLY_DATA
+
+			if (Configuration->Voice.bIsWavFileRecordingEnabled)
+			{
+				RecordedVoiceInputBuffer.Append(RemainingVoiceData);
+			}
+
+#endif
+
+#ifndef CPP_PLUGIN
+			UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
+
+			if (RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress(RequestHandle))
+			{
+				RequestSubsystem->WriteBinaryData(RequestHandle, RemainingVoiceData);
+			}
+#endif
+
+			UWitSocketSubsystem* SocketSubsystem = GEngine->GetEngineSubsystem<UWitSocketSubsystem>();
+
+			if (SocketSubsystem != nullptr && SocketSubsystem->IsConverseInProgress(SocketRequestId))
+			{
+				SocketSubsystem->SendBinaryData(SocketRequestId, RemainingVoiceData);
+			}
+		}
 	}
 	else
 	{
@@ -582,7 +664,7 @@ bool UWitVoiceService::DoDeactivateVoiceInput()
 	// End the streamed request. This will tell the HTTP client to send any remaining data and the close the request
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
-	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress();
+	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress(RequestHandle);
 	
 	if (bIsRequestInProgress)
 	{
@@ -596,7 +678,7 @@ bool UWitVoiceService::DoDeactivateVoiceInput()
 		StreamInputProvider->writeEndOfStream();
 #endif
 #else
-		RequestSubsystem->EndStreamRequest();
+		RequestSubsystem->EndStreamRequest(RequestHandle);
 #endif
 	}
 	else
@@ -612,6 +694,8 @@ bool UWitVoiceService::DoDeactivateVoiceInput()
 
 	bIsVoiceInputActive = false;
 	bIsVoiceStreamingActive = false;
+
+	DeactivationTime = FPlatformTime::Seconds();
 	
 	// Notify that we've stopped accepting voice input
 
@@ -684,7 +768,7 @@ bool UWitVoiceService::IsVoiceStreamingActive() const
 bool UWitVoiceService::IsRequestInProgress() const
 {
 	const UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
-	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress();
+	const bool bIsRequestInProgress = RequestSubsystem != nullptr && RequestSubsystem->IsRequestInProgress(RequestHandle);
 
 	return bIsRequestInProgress;
 }
@@ -704,6 +788,10 @@ void UWitVoiceService::SendTranscription(const FString& Text)
 		return;
 	}
 
+	// Text requests do not come from voice input so there is no voice latency to report
+
+	ActivationTime = 0.0;
+
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
 	if (RequestSubsystem == nullptr)
@@ -712,7 +800,7 @@ void UWitVoiceService::SendTranscription(const FString& Text)
 		return;
 	}
 
-	if (RequestSubsystem->IsRequestInProgress())
+	if (RequestSubsystem->IsRequestInProgress(RequestHandle))
 	{
 		UE_LOG(LogWit, Warning, TEXT("SendTranscription: cannot send transcription because a request is already in progress"));
 		return;
@@ -766,8 +854,8 @@ void UWitVoiceService::SendTranscription(const FString& Text)
 		Events->OnRequestCustomize.ExecuteIfBound(RequestConfiguration);
 	}
 	
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 #endif
 }
 
@@ -810,7 +898,8 @@ void UWitVoiceService::AcceptPartialResponseAndCancelRequest(const FWitResponse&
 		return;
 	}
 
-	RequestSubsystem->CancelRequest();
+	RequestSubsystem->CancelRequest(RequestHandle);
+	RequestHandle.Reset();
 #endif
 
 	DeactivateVoiceInput();
@@ -822,12 +911,42 @@ void UWitVoiceService::AcceptPartialResponseAndCancelRequest(const FWitResponse&
 }
 
 /**
- * Called when a Wit speech request is in progress with any partial transcriptions
+ * Called when a Wit speech request is in progress with any partial transcriptions. The response has already been decoded by the request
+ * subsystem so no JSON conversion is needed here
  *
- * @param PartialBinaryResponse [in] the partial response as binary
- * @param PartialJsonResponse [in] the partial response as Json
+ * @param PartialResponse [in] the decoded partial response
+ * @param bIsWitResponse [in] does the partial response contain intents or only a partial transcription
  */
-void UWitVoiceService::OnSpeechRequestProgress(const TArray<uint8>& PartialBinaryResponse, const TSharedPtr<FJsonObject> PartialJsonResponse) const
+void UWitVoiceService::OnSpeechResponseProgress(const FWitResponse& PartialResponse, const bool bIsWitResponse)
+{
+	if (Events == nullptr)
+	{
+		return;
+	}
+
+	// The partial response lives in the request's recycled storage. Copying it into the events would reallocate every string and
+	// container for each partial so it is broadcast as is and only copied if it is accepted
+
+	if (bIsWitResponse)
+	{
+		Events->OnWitPartialResponse.Broadcast(true, PartialResponse);
+
+		AcceptPartialResponseIfStable(PartialResponse);
+	}
+	else
+	{
+		Events->OnPartialTranscription.Broadcast(PartialResponse.Text);
+	}
+}
+
+/**
+ * Called when a WebSocket speech stream is in progress to retrieve any changes to the response payload. The binary payload is a view of
+ * the received message and is only valid for the duration of the call
+ *
+ * @param PartialBinaryResponse [in] the partial binary response
+ * @param PartialJsonResponse [in] the partial Json response
+ */
+void UWitVoiceService::OnSpeechStreamProgress(TArrayView<const uint8> PartialBinaryResponse, const TSharedPtr<FJsonObject> PartialJsonResponse) const
 {
 	UE_LOG(LogWit, Verbose, TEXT("OnSpeechRequestProgress: %d"), PartialBinaryResponse.Num());
 	// The text field of the final response chunk represents the most recent transcription that Wit.ai was able to discern. We pass this to the user
@@ -858,7 +977,7 @@ void UWitVoiceService::OnSpeechRequestProgress(const TArray<uint8>& PartialBinar
  * @param PartialBinaryResponse [in] the partial binary response
  * @param PartialJsonResponse [in] the partial Json response
  */
-void UWitVoiceService::OnPartialResponse(const TArray<uint8>& PartialBinaryResponse, const TSharedPtr<FJsonObject> PartialJsonResponse) const
+void UWitVoiceService::OnPartialResponse(TArrayView<const uint8> PartialBinaryResponse, const TSharedPtr<FJsonObject> PartialJsonResponse) const
 {
 	if (Events == nullptr)
 	{
@@ -893,15 +1012,65 @@ void UWitVoiceService::OnMessageRequestComplete(const TArray<uint8>& BinaryRespo
 }
 
 /**
- * Called when a Wit speech request is successfully completed to process the final response payload
+ * Called when a Wit speech request is successfully completed with the decoded final response
  *
- * @param BinaryResponse [in] the final binary response
- * @param JsonResponse [in] the final Json response
+ * @param Response [in] the decoded final response
+ * @param bIsWitResponse [in] does the final response contain intents
  */
-void UWitVoiceService::OnSpeechRequestComplete(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse)
+void UWitVoiceService::OnSpeechResponseComplete(const FWitResponse& Response, const bool bIsWitResponse)
 {
-	
-	OnRequestComplete(BinaryResponse, JsonResponse, true);
+	// Keep track of how long voice requests take to run to completion so we can estimate what accepting early saves
+
+	if (ActivationTime > 0.0)
+	{
+		TotalFinalResponseLatency += FPlatformTime::Seconds() - ActivationTime;
+		++NumFinalResponses;
+	}
+
+	OnRequestComplete(Response);
+}
+
+/**
+ * Accept a partial response as the final response if its top intent and entities have stopped changing. The rest of the request is
+ * cancelled and the response is delivered as final straight away
+ *
+ * @param PartialResponse [in] the latest partial response
+ */
+void UWitVoiceService::AcceptPartialResponseIfStable(const FWitResponse& PartialResponse)
+{
+	const bool bIsEarlyAcceptEnabled = Configuration != nullptr && Configuration->Voice.bIsStablePartialResponseAccepted;
+
+	// A matcher may already have accepted the response from inside the partial response broadcast
+
+	if (!bIsEarlyAcceptEnabled || !RequestHandle.IsValid())
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	const bool bIsStable = StabilityTracker.Update(PartialResponse, CurrentTime);
+	if (!bIsStable)
+	{
+		return;
+	}
+
+	const double AcceptLatency = ActivationTime > 0.0 ? CurrentTime - ActivationTime : 0.0;
+
+	UE_LOG(LogWit, Display, TEXT("AcceptPartialResponseIfStable: accepting after (%d) stable partial responses over (%.3f) seconds, activation to accept (%.3f) seconds"),
+		StabilityTracker.GetNumStablePartialResponses(), StabilityTracker.GetStableTime(CurrentTime), AcceptLatency);
+
+	if (NumFinalResponses > 0 && ActivationTime > 0.0)
+	{
+		const double AverageFinalResponseLatency = TotalFinalResponseLatency / NumFinalResponses;
+
+		UE_LOG(LogWit, Display, TEXT("AcceptPartialResponseIfStable: estimated saving (%.3f) seconds against the average (%.3f) seconds of (%d) completed requests"),
+			AverageFinalResponseLatency - AcceptLatency, AverageFinalResponseLatency, NumFinalResponses);
+	}
+
+	StabilityTracker.Reset();
+
+	AcceptPartialResponseAndCancelRequest(PartialResponse);
 }
 
 /**
@@ -951,10 +1120,39 @@ void UWitVoiceService::OnRequestComplete(const FWitResponse& Response) const
 	UE_LOG(LogWit, Display, TEXT("Full transcription received (%s)"), *Events->WitResponse.Text);
 	UE_LOG(LogWit, Verbose, TEXT("UStruct - Text: %s"), *Events->WitResponse.Text);
 
+	ReportRequestLatency();
+
 	Events->OnFullTranscription.Broadcast(Events->WitResponse.Text);
 	Events->OnWitResponse.Broadcast(true, Events->WitResponse);
 }
 
+/**
+ * Called when a WebSocket speech stream is complete. The final response has already been delivered as a partial response
+ */
+void UWitVoiceService::OnSpeechStreamComplete() const
+{
+	ReportRequestLatency();
+}
+
+/**
+ * Log how long the current voice request took to receive its final response. The time since deactivation is the dead air the user
+ * experiences so it is the figure end of utterance detection reduces
+ */
+void UWitVoiceService::ReportRequestLatency() const
+{
+	const bool bIsVoiceRequest = ActivationTime > 0.0 && DeactivationTime >= ActivationTime;
+
+	if (!bIsVoiceRequest)
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogWit, Display, TEXT("ReportRequestLatency: activation to final response (%.3f) seconds, deactivation to final response (%.3f) seconds"),
+		CurrentTime - ActivationTime, CurrentTime - DeactivationTime);
+}
+
 /**
  * Called when the state of a WebSocket connection changes
  */
@@ -58,6 +58,15 @@ public:
 	 */	
 	virtual USoundWave* GetClip(const FString& ClipId) const = 0;
 
+	/**
+	 * Is a clip in the cache? Unlike GetClip this does not count as a use of the clip
+	 *
+	 * @param ClipId [in] the clip id
+	 *
+	 * @return true if the clip is in the cache
+	 */
+	virtual bool ContainsClip(const FString& ClipId) const = 0;
+
 	/**
 	 * Get all the currently cached clips
 	 * 
@@ -18,7 +18,41 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnClipAddedDelegate, const FString,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnClipRemovedDelegate, const FString, ClipId);
 
 /**
- * Implements a simple memory cache that has capacity controls and LRU ejection policy
+ * Usage statistics of a memory cache
+ */
+USTRUCT(BlueprintType)
+struct WIT_API FTtsMemoryCacheStatistics
+{
+	GENERATED_BODY()
+
+	/** The number of lookups that found a cached clip */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="TTS")
+	int32 NumHits{0};
+
+	/** The number of lookups that did not find a cached clip */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="TTS")
+	int32 NumMisses{0};
+
+	/** The number of clips ejected to keep the cache within its capacity */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="TTS")
+	int32 NumEvictions{0};
+};
+
+/**
+ * Links a cached clip into the recency list. Indices refer to the clip arrays of the memory cache
+ */
+struct FTtsMemoryCacheLink
+{
+	/** The next older clip */
+	int32 Previous{INDEX_NONE};
+
+	/** The next newer clip */
+	int32 Next{INDEX_NONE};
+};
+
+/**
+ * Implements a simple memory cache that has capacity controls and LRU ejection policy. Clips are indexed by a hash of their id and kept
+ * in an intrusive recency list so lookup, refreshing a clip on access and ejecting the oldest clip are all constant time
  */
 UCLASS(ClassGroup=(Meta), meta=(BlueprintSpawnableComponent))
 class WIT_API UTtsMemoryCache final : public UTtsMemoryCacheHandler
@@ -63,6 +97,15 @@ public:
 	 */	
 	virtual USoundWave* GetClip(const FString& ClipId) const override;
 
+	/**
+	 * Is a clip in the cache? Unlike GetClip this does not count as a use of the clip
+	 *
+	 * @param ClipId [in] the clip id
+	 *
+	 * @return true if the clip is in the cache
+	 */
+	virtual bool ContainsClip(const FString& ClipId) const override;
+
 	/**
 	 * Get all the currently cached clips
 	 * 
@@ -117,6 +160,24 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="TTS")
 	int32 GetUsedCacheSizeInKilobytes() const;
+
+	/**
+	 * Gets the exact amount of memory in bytes currently being used by the cache
+	 */
+	UFUNCTION(BlueprintCallable, Category="TTS")
+	int64 GetUsedCacheSizeInBytes() const;
+
+	/**
+	 * Gets the hit, miss and eviction counts of the cache
+	 */
+	UFUNCTION(BlueprintCallable, Category="TTS")
+	FTtsMemoryCacheStatistics GetStatistics() const;
+
+	/**
+	 * Resets the hit, miss and eviction counts of the cache
+	 */
+	UFUNCTION(BlueprintCallable, Category="TTS")
+	void ResetStatistics();
 	
 private:
 
@@ -130,6 +191,36 @@ private:
 	 */
 	void RemoveClipAt(const int32 Index);
 
+	/**
+	 * Gets the memory used by a single clip
+	 */
+	static int64 GetClipSizeInBytes(USoundWave* SoundWave);
+
+	/**
+	 * Get the compact key used to index a clip
+	 */
+	static FTtsClipKey GetClipKey(const FString& ClipId);
+
+	/**
+	 * Find the array index of a clip. Returns INDEX_NONE if the clip is not cached
+	 */
+	int32 FindClipIndex(const FString& ClipId) const;
+
+	/**
+	 * Add a clip to the most recently used end of the recency list
+	 */
+	void LinkClipAsNewest(const int32 Index) const;
+
+	/**
+	 * Remove a clip from the recency list
+	 */
+	void UnlinkClip(const int32 Index) const;
+
+	/**
+	 * Mark a clip as the most recently used
+	 */
+	void TouchClip(const int32 Index) const;
+
 	/**
 	 * All the clip ids currently stored
 	 */
@@ -147,4 +238,44 @@ private:
 	 */
 	UPROPERTY(VisibleAnywhere, Transient, Category = "Contents")
 	TArray<FTtsConfiguration> ClipSettingsArray{};
+
+	/**
+	 * The key of each stored clip
+	 */
+	TArray<FTtsClipKey> ClipKeys{};
+
+	/**
+	 * The size in bytes of each stored clip as measured when it was added
+	 */
+	TArray<int64> ClipSizesInBytes{};
+
+	/**
+	 * The total size in bytes of all stored clips
+	 */
+	int64 UsedCacheSizeInBytes{0};
+
+	/**
+	 * Usage statistics. Updated by lookups which is why it is mutable
+	 */
+	mutable FTtsMemoryCacheStatistics Statistics{};
+
+	/**
+	 * Maps a clip key to the index of the clip in the arrays above
+	 */
+	TMap<FTtsClipKey, int32> ClipIndices{};
+
+	/**
+	 * The recency list link of each stored clip. Updated by lookups which is why it is mutable
+	 */
+	mutable TArray<FTtsMemoryCacheLink> ClipLinks{};
+
+	/**
+	 * The index of the least recently used clip
+	 */
+	mutable int32 OldestClipIndex{INDEX_NONE};
+
+	/**
+	 * The index of the most recently used clip
+	 */
+	mutable int32 NewestClipIndex{INDEX_NONE};
 };
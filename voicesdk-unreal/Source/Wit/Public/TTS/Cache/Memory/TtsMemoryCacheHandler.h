@@ -32,6 +32,7 @@ public:
 	virtual bool RemoveClip(const FString& ClipId) override { return false; }
 	virtual void RemoveAllClips() override {};
 	virtual USoundWave* GetClip(const FString& ClipId) const override { return nullptr; }
+	virtual bool ContainsClip(const FString& ClipId) const override { return false; }
 	virtual TArray<USoundWave*> GetClips() const override { return TArray<USoundWave*>(); }
 	
 };
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include "CoreMinimal.h"
 #include "TTS/Configuration/TtsConfiguration.h"
 
+DECLARE_DELEGATE_TwoParams(FOnTtsStorageCacheRequestClipCompleteDelegate, const bool /* bIsSuccessful */, const TArray<uint8>& /* ClipData */);
+DECLARE_DELEGATE_OneParam(FOnTtsStorageCacheAddClipCompleteDelegate, const bool /* bIsSuccessful */);
+
 /**
  * Interface for implementing a storage cache. Can be overriden to implement custom functionality
  */
@@ -63,6 +66,25 @@ public:
 	 */
 	virtual bool RequestClip(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, TArray<uint8>& ClipData) const = 0;
 
+	/**
+	 * Add a clip to the cache without blocking the calling thread
+	 *
+	 * @param ClipId [in] the clip id
+	 * @param ClipData [in] the binary data that represents the clip
+	 * @param ClipSettings [in] the settings that were originally used to create the clip
+	 * @param OnComplete [in] called on the game thread once the clip has been written
+	 */
+	virtual void AddClipAsync(const FString& ClipId, const TArray<uint8>& ClipData, const FTtsConfiguration& ClipSettings, const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete) = 0;
+
+	/**
+	 * Request a clip from the cache without blocking the calling thread
+	 *
+	 * @param ClipId [in] the clip id
+	 * @param CacheLocation [in] the cache location where the clip will be
+	 * @param OnComplete [in] called on the game thread with the clip data once the request is complete
+	 */
+	virtual void RequestClipAsync(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete) const = 0;
+
 	/**
 	 * Remove a clip from the cache
 	 *
@@ -10,8 +10,20 @@
 #include "TTS/Cache/Storage/TtsStorageCacheHandler.h"
 #include "TtsStorageCache.generated.h"
 
+class FTtsStorageCacheManifest;
+class FTtsStorageCachePack;
+class FTtsStorageCacheWorker;
+
+UENUM()
+enum class ETtsStorageCacheFormat : uint8
+{
+	Files,		// Store each clip in its own file
+	Pack		// Store all clips in a single pack file with a sorted index. Better on file systems where opening files is expensive
+};
+
 /**
- * Implements a simple storage cache backed on to disk
+ * Implements a simple storage cache backed on to disk. File I/O for the asynchronous functions is done on a background worker
+ * which also evicts the least recently used clips when a cache location goes over its budget
  */
 UCLASS(ClassGroup=(Meta), meta=(BlueprintSpawnableComponent))
 class WIT_API UTtsStorageCache final : public UTtsStorageCacheHandler
@@ -22,6 +34,16 @@ public:
 	
 	UTtsStorageCache();
 
+	/**
+	 * Called when the component is started. Brings any existing cache within budget
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * Called when the component is stopped. Saves any outstanding changes to the cache manifests
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * Get the path to the given clip in the cache
 	 *
@@ -64,6 +86,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TTS")
 	virtual bool RequestClip(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, TArray<uint8>& ClipData) const override;
 
+	/**
+	 * Add a clip to the cache without blocking the calling thread
+	 *
+	 * @param ClipId [in] the clip id
+	 * @param ClipData [in] the binary data that represents the clip
+	 * @param ClipSettings [in] the settings that were originally used to create the clip
+	 * @param OnComplete [in] called on the game thread once the clip has been written
+	 */
+	virtual void AddClipAsync(const FString& ClipId, const TArray<uint8>& ClipData, const FTtsConfiguration& ClipSettings, const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete) override;
+
+	/**
+	 * Request a clip from the cache without blocking the calling thread
+	 *
+	 * @param ClipId [in] the clip id
+	 * @param CacheLocation [in] the cache location where the clip will be
+	 * @param OnComplete [in] called on the game thread with the clip data once the request is complete
+	 */
+	virtual void RequestClipAsync(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete) const override;
+
 	/**
 	 * Remove a clip from the cache
 	 *
@@ -95,9 +136,75 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Location")
 	ETtsStorageCacheLocation DefaultCacheLocation{ETtsStorageCacheLocation::None};
 
+	/**
+	 * How to store clips in the persistent location
+	 */	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Location")
+	ETtsStorageCacheFormat PersistentCacheFormat{ETtsStorageCacheFormat::Files};
+
+	/**
+	 * How to store clips in the temporary location
+	 */	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Location")
+	ETtsStorageCacheFormat TemporaryCacheFormat{ETtsStorageCacheFormat::Files};
+
+	/**
+	 * Should we limit the number of clips in each cache location?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capacity")
+	bool bIsClipCapacityEnabled{false};
+
+	/**
+	 * The maximum number of clips in each cache location. The least recently used clips are evicted to stay within this
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(EditCondition="bIsClipCapacityEnabled", ClampMin = 1), Category = "Capacity")
+	int32 ClipCapacity{1000};
+
+	/**
+	 * Should we limit the size of each cache location?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capacity")
+	bool bIsStorageCapacityEnabled{false};
+
+	/**
+	 * The maximum size of each cache location. The least recently used clips are evicted to stay within this
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(EditCondition="bIsStorageCapacityEnabled", ClampMin = 1), Category = "Capacity")
+	int32 StorageCapacityInMegabytes{256};
+
 private:
 
 	/* Get the final location to cache a clip taking into account overrides */
 	ETtsStorageCacheLocation GetFinalCacheLocation(const ETtsStorageCacheLocation CacheLocation) const;
 
+	/* Get the path of the cache directory without touching the file system */
+	bool GetCacheDirectory(const ETtsStorageCacheLocation CacheLocation, FString& CachePath) const;
+
+	/* Get the pack to use for a cache location or null if the location stores clips as individual files */
+	TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe> GetPack(const ETtsStorageCacheLocation CacheLocation) const;
+
+	/* Queue compaction of a pack on the background worker if enough of it is unused */
+	void QueueCompactionIfNeeded(const TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe>& Pack) const;
+
+	/* Is either capacity limit in use? The manifests are only kept when there is a budget to enforce */
+	bool IsCapacityEnabled() const;
+
+	/* Get the manifest that tracks the clips in a cache location or null if the location is not tracked */
+	TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe> GetManifest(const ETtsStorageCacheLocation CacheLocation) const;
+
+	/* Queue an update of a cache location's manifest on the background worker followed by any eviction needed to stay within budget */
+	void QueueManifestUpdate(const ETtsStorageCacheLocation CacheLocation, TUniqueFunction<void(FTtsStorageCacheManifest&)>&& Update) const;
+
+	/* Get the hash of the settings used to create a clip ignoring the text */
+	static uint32 GetSettingsHash(const FTtsConfiguration& ClipSettings);
+
+	/* Packs that have been opened keyed by cache directory */
+	mutable TMap<FString, TSharedPtr<FTtsStorageCachePack, ESPMode::ThreadSafe>> Packs{};
+
+	/* Manifests that have been created keyed by cache directory. The manifests themselves are only used on the background worker */
+	mutable TMap<FString, TSharedPtr<FTtsStorageCacheManifest, ESPMode::ThreadSafe>> Manifests{};
+
+	/* Performs file I/O for the asynchronous functions and remembers which directories exist */
+	TSharedPtr<FTtsStorageCacheWorker, ESPMode::ThreadSafe> Worker{};
+
 };
@@ -34,5 +34,21 @@ public:
 	virtual bool RequestClip(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, TArray<uint8>& ClipData) const override { return false; };
 	virtual bool RemoveClip(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation) override { return false; };
 	virtual void RemoveAllClips(const ETtsStorageCacheLocation CacheLocation) override {};
+
+	/**
+	 * Default asynchronous implementation that falls back to the synchronous versions. The delegate is called before returning
+	 */
+	virtual void AddClipAsync(const FString& ClipId, const TArray<uint8>& ClipData, const FTtsConfiguration& ClipSettings, const FOnTtsStorageCacheAddClipCompleteDelegate& OnComplete) override
+	{
+		const bool bIsSuccessful = AddClip(ClipId, ClipData, ClipSettings);
+		OnComplete.ExecuteIfBound(bIsSuccessful);
+	}
+
+	virtual void RequestClipAsync(const FString& ClipId, const ETtsStorageCacheLocation CacheLocation, const FOnTtsStorageCacheRequestClipCompleteDelegate& OnComplete) const override
+	{
+		TArray<uint8> ClipData;
+		const bool bIsSuccessful = RequestClip(ClipId, CacheLocation, ClipData);
+		OnComplete.ExecuteIfBound(bIsSuccessful, ClipData);
+	}
 	
 };
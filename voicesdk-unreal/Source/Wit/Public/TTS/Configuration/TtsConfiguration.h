@@ -20,7 +20,36 @@ enum class ETtsStorageCacheLocation : uint8
 };
 
 /**
- * Voice configuration for /synthesize endpoint of Wit.ai.
+ * A compact 128 bit key that identifies a clip. It is cheap to compare and hash so it can be used directly as a cache key. Keys are
+ * only meaningful within a single run and must not be persisted
+ */
+struct FTtsClipKey
+{
+	/** The low 64 bits of the key */
+	uint64 Low{0};
+
+	/** The high 64 bits of the key */
+	uint64 High{0};
+
+	bool operator==(const FTtsClipKey& Other) const
+	{
+		return Low == Other.Low && High == Other.High;
+	}
+
+	bool operator!=(const FTtsClipKey& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FTtsClipKey& Key)
+	{
+		return static_cast<uint32>(Key.Low);
+	}
+};
+
+/**
+ * Voice configuration for /synthesize endpoint of Wit.ai. Any field added here that changes the synthesized audio must also be added
+ * to FWitHelperUtilities::GetVoiceClipKey
  */
 USTRUCT(BlueprintType)
 struct WIT_API FTtsConfiguration
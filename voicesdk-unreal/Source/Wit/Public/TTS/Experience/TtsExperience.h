@@ -113,6 +113,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTS", meta = (EditCondition = "false", EditConditionHides))
 	bool bUseWebSocket{false};
 
+	/**
+	 * How many synthesis requests can be in flight at once when long text is split into several clips. Clips are still
+	 * played back in order. A value of 1 sends the clips one after the other. Not used when streaming
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TTS", meta = (ClampMin = 1, ClampMax = 8, EditCondition = "!bUseStreaming"))
+	int32 MaxPipelinedRequests{1};
+
 	/**
 	 * The events used by the voice service
 	 */
@@ -141,6 +148,8 @@ protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 
 	void InitializeService();
@@ -58,6 +58,14 @@ public:
 		MemoryCacheHandler = MemoryCacheHandlerToUse;
 		StorageCacheHandler = StorageCacheHandlerToUse;
 	}
+
+	/**
+	 * Set how many synthesis requests can be in flight at once when a long text is split into several clips
+	 */
+	void SetMaxPipelinedRequests(const int32 MaxPipelinedRequestsToUse)
+	{
+		MaxPipelinedRequests = FMath::Max(1, MaxPipelinedRequestsToUse);
+	}
 	
 	/**
 	 * ITtsService overrides
@@ -105,6 +113,12 @@ protected:
 	UPROPERTY(Transient)
 	bool bUseWebSocket{false};
 
+	/**
+	 * The maximum number of synthesis requests that can be in flight at once. A value of 1 sends clips one at a time
+	 */
+	UPROPERTY(Transient)
+	int32 MaxPipelinedRequests{1};
+
 	/**
 	 * The events that this service should use in callbacks
 	 */
@@ -49,6 +49,13 @@ struct WIT_API FVoiceConfiguration
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Activation", meta=(ClampMin = 0, ClampMax = 10))
 	float WakeMinimumTime{0.5f};
 
+	/**
+	 * The amount of voice data (in seconds) from before the wake threshold is reached that is sent at the start of the request so the
+	 * first syllables are not clipped
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Activation", meta=(ClampMin = 0, ClampMax = 2))
+	float PreRollTime{0.5f};
+
 	/**
 	 * The minimum voice volume for keeping the voice input active
 	 */
@@ -69,6 +76,93 @@ struct WIT_API FVoiceConfiguration
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Keep Alive", meta=(ClampMin = 0, ClampMax = 300))
 	float MaximumRecordingTime{20.0f};
 
+	/**
+	 * If set to true the voice data is classified as speech or background noise. Streaming only starts once speech is detected and
+	 * voice input is kept alive by detected speech rather than by the keep alive volume
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voice Activity Detection")
+	bool bIsVoiceActivityDetectionEnabled{false};
+
+	/**
+	 * How many times louder than the background noise the voice data must be to be classified as speech
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voice Activity Detection", meta=(ClampMin = 1, ClampMax = 20))
+	float VoiceActivitySpeechToNoiseRatio{2.0f};
+
+	/**
+	 * The minimum RMS volume the voice data must have to be classified as speech however quiet the background noise is
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voice Activity Detection", meta=(ClampMin = 0, ClampMax = 1))
+	float VoiceActivityMinimumVolume{0.005f};
+
+	/**
+	 * The maximum fraction of samples that may cross zero for the voice data to be classified as speech. Hiss and other broadband
+	 * noise cross zero much more often than speech
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voice Activity Detection", meta=(ClampMin = 0, ClampMax = 1))
+	float VoiceActivityMaximumZeroCrossingRate{0.35f};
+
+	/**
+	 * How long (in seconds) speech is still considered to be happening after it was last detected so pauses between words are bridged
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voice Activity Detection", meta=(ClampMin = 0, ClampMax = 2))
+	float VoiceActivityHangoverTime{0.3f};
+
+	/**
+	 * If set to true voice input is deactivated as soon as the user stops speaking rather than waiting for the keep alive time
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "End Of Utterance")
+	bool bIsEndOfUtteranceDetectionEnabled{false};
+
+	/**
+	 * The RMS volume below which the voice data is considered silence when detecting the end of an utterance
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "End Of Utterance", meta=(ClampMin = 0, ClampMax = 1))
+	float EndOfUtteranceSilenceVolume{0.01f};
+
+	/**
+	 * How much speech (in seconds) must be heard before silence can end the utterance. This stops short noises ending it early
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "End Of Utterance", meta=(ClampMin = 0, ClampMax = 5))
+	float EndOfUtteranceMinimumSpeechTime{0.3f};
+
+	/**
+	 * How long (in seconds) the silence after speech must last to end the utterance. Too short and pauses between words will end it
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "End Of Utterance", meta=(ClampMin = 0.1, ClampMax = 5))
+	float EndOfUtteranceSilenceTime{0.5f};
+
+	/**
+	 * Should a partial response be accepted as the final response once its top intent and entities stop changing? This cancels the rest
+	 * of the request so the response is acted on without waiting for the user to stop speaking
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Early Accept")
+	bool bIsStablePartialResponseAccepted{false};
+
+	/**
+	 * The number of consecutive partial responses that must have the same top intent and entity values before one is accepted
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Early Accept", meta=(ClampMin = 1, ClampMax = 20))
+	int32 StablePartialResponseMinimumCount{3};
+
+	/**
+	 * How long (in seconds) the partial responses must have agreed for before one is accepted, even if the count is not reached
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Early Accept", meta=(ClampMin = 0, ClampMax = 5))
+	float StablePartialResponseMinimumTime{0.3f};
+
+	/**
+	 * The confidence the top intent of a partial response must exceed for it to be accepted
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Early Accept", meta=(ClampMin = 0, ClampMax = 1))
+	float StablePartialResponseConfidenceThreshold{0.8f};
+
+	/**
+	 * The entities a partial response must contain for it to be accepted
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Early Accept")
+	TArray<FString> StablePartialResponseRequiredEntities{};
+
 	/**
 	 * If set to true this will record the voice input and write it to a named wav file for debugging. The output file will be written to
 	 * the project folder's Saved/BouncedWavFiles folder as Wit/RecordedVoiceInput.wav
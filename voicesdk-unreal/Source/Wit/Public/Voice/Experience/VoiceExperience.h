@@ -13,6 +13,8 @@
 #include "Voice/Events//VoiceEvents.h"
 #include "VoiceExperience.generated.h"
 
+class UVoiceResponseDispatcher;
+
 
 /**
  * The base class of VoiceExperience
@@ -53,6 +55,13 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Voice")
 	UVoiceEvents* VoiceEvents{};
 
+	/**
+	 * Get the dispatcher that delivers the responses of this experience to its matchers. It is created on first use
+	 *
+	 * @return the dispatcher
+	 */
+	UVoiceResponseDispatcher* GetResponseDispatcher();
+
 	/**
 	 * IVoiceService overrides
 	 */
@@ -98,5 +107,13 @@ public:
 protected:
 
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	/** Delivers the responses of this experience to its matchers */
+	UPROPERTY(Transient)
+	UVoiceResponseDispatcher* ResponseDispatcher{};
 	
 };
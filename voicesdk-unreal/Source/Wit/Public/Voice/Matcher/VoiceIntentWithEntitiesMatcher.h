@@ -94,4 +94,14 @@ public:
 	 */
 	virtual void OnWitResponse(const bool bIsSuccessful, const FWitResponse& Response) override;
 
+	/**
+	 * Get the intent a response must have as its top intent for this matcher to act on it
+	 *
+	 * @param OutIntentName [out] the name of the required intent
+	 * @param OutConfidenceThreshold [out] the confidence the intent must exceed
+	 *
+	 * @return true if an intent is required, false if the matcher acts on every response
+	 */
+	virtual bool GetRequiredIntent(FString& OutIntentName, float& OutConfidenceThreshold) const override;
+
 };
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Wit/Request/WitResponse.h"
+#include "VoiceResponseDispatcher.generated.h"
+
+class UVoiceEvents;
+class UVoiceResponseMatcher;
+
+/**
+ * A registered matcher as seen by the dispatch table
+ */
+struct FVoiceResponseDispatchEntry
+{
+	/** The matcher to dispatch to */
+	TWeakObjectPtr<UVoiceResponseMatcher> Matcher{};
+
+	/** The name the top intent of a response must have for the matcher to act on it */
+	FString IntentName{};
+
+	/** The confidence the top intent of a response must exceed for the matcher to act on it */
+	float IntentConfidenceThreshold{0.0f};
+};
+
+/**
+ * Matchers compiled into a form that can be looked up by the top intent of a response
+ */
+struct FVoiceResponseDispatchTable
+{
+	/** Matchers that require a top intent keyed by the intent name. Each list is sorted by increasing confidence threshold */
+	TMap<FString, TArray<FVoiceResponseDispatchEntry>> IntentEntries{};
+
+	/** Matchers that act on every response regardless of its intents */
+	TArray<FVoiceResponseDispatchEntry> UnconditionalEntries{};
+
+	/** Remove every entry */
+	void Reset();
+
+	/** Add the candidate matchers for a response. These are the only matchers that can act on it */
+	void GetCandidates(const FWitResponse& Response, TArray<UVoiceResponseMatcher*, TInlineAllocator<16>>& OutCandidates) const;
+};
+
+/**
+ * Dispatches the responses of a voice experience to its matchers. Rather than every matcher listening for every response and scanning
+ * it, the matchers are compiled into a table indexed by intent name so each response costs one lookup plus a call to each matcher that
+ * can act on it
+ */
+UCLASS()
+class WIT_API UVoiceResponseDispatcher final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Start listening for the responses of a voice experience
+	 *
+	 * @param VoiceEvents [in] the events of the voice experience
+	 */
+	void Initialize(UVoiceEvents* VoiceEvents);
+
+	/**
+	 * Register a matcher to receive responses
+	 *
+	 * @param Matcher [in] the matcher to register
+	 */
+	void RegisterMatcher(UVoiceResponseMatcher* Matcher);
+
+	/**
+	 * Stop a matcher receiving responses
+	 *
+	 * @param Matcher [in] the matcher to unregister
+	 */
+	void UnregisterMatcher(UVoiceResponseMatcher* Matcher);
+
+	/**
+	 * Recompile the dispatch table before the next response. Call this if the match criteria of a registered matcher change
+	 */
+	void MarkDirty();
+
+	/**
+	 * Get the number of registered matchers
+	 */
+	int32 GetNumMatchers() const
+	{
+		return Matchers.Num();
+	}
+
+	/**
+	 * Callback that is called when a full Wit.ai response is received
+	 *
+	 * @param bIsSuccessful [in] true if the response was successful
+	 * @param Response [in] the full response as a UStruct
+	 */
+	UFUNCTION()
+	void OnWitResponse(const bool bIsSuccessful, const FWitResponse& Response);
+
+	/**
+	 * Callback that is called when a partial Wit.ai response is received
+	 *
+	 * @param bIsSuccessful [in] true if the response was successful
+	 * @param Response [in] the partial response as a UStruct
+	 */
+	UFUNCTION()
+	void OnWitPartialResponse(const bool bIsSuccessful, const FWitResponse& Response);
+
+private:
+
+	/** Compile the registered matchers into the dispatch tables */
+	void Compile();
+
+	/** Dispatch a response to the matchers that can act on it */
+	void Dispatch(const FVoiceResponseDispatchTable& Table, const bool bIsSuccessful, const FWitResponse& Response);
+
+	/** The registered matchers */
+	TArray<TWeakObjectPtr<UVoiceResponseMatcher>> Matchers{};
+
+	/** The table used for full responses */
+	FVoiceResponseDispatchTable ResponseTable{};
+
+	/** The table used for partial responses. Only contains matchers that also want partial responses */
+	FVoiceResponseDispatchTable PartialResponseTable{};
+
+	/** Do the tables need to be compiled before the next response? */
+	bool bIsDirty{true};
+};
@@ -13,6 +13,8 @@
 #include "Wit/Request/WitResponse.h"
 #include "VoiceResponseMatcher.generated.h"
 
+class UVoiceResponseDispatcher;
+
 /**
  * Base class for all response matchers. Implements shared functionality
  */
@@ -68,12 +70,38 @@ public:
 	UFUNCTION()
 	virtual void OnWitResponse(const bool bIsSuccessful, const FWitResponse& Response) {};
 
+	/**
+	 * Get the intent a response must have as its top intent for this matcher to act on it. This is used to only dispatch responses to
+	 * the matchers that can act on them
+	 *
+	 * @param OutIntentName [out] the name of the required intent
+	 * @param OutConfidenceThreshold [out] the confidence the intent must exceed
+	 *
+	 * @return true if an intent is required, false if the matcher acts on every response
+	 */
+	virtual bool GetRequiredIntent(FString& OutIntentName, float& OutConfidenceThreshold) const;
+
+	/**
+	 * Call this after changing the intent, confidence threshold or partial response settings of the matcher while playing so that
+	 * responses are dispatched using the new settings
+	 */
+	UFUNCTION(BlueprintCallable, Category="Experience")
+	void RefreshMatchCriteria();
+
 protected:
 	
 	/** Called when play is started */
 	virtual void BeginPlay() override;
 
+	/** Called when play ends */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Called to check and response to partial responses */
 	void AcceptPartialResponse(const FWitResponse& Response);
 
+private:
+
+	/** The dispatcher this matcher is registered with */
+	TWeakObjectPtr<UVoiceResponseDispatcher> ResponseDispatcher{};
+
 };
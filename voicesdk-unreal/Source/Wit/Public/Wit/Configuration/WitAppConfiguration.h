@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include "Wit/Request/WitRequestTypes.h"
 #include "Wit/Request/WitResponse.h"
 
 #include "WitAppConfiguration.generated.h"
@@ -25,6 +26,21 @@ struct WIT_API FWitAppAdvancedConfiguration
 	/** Specifies the base URL to use when making requests to Wit.ai. If left empty this will use the default base URL */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Request")
 	FString URL{};
+
+	/**
+	 * Should partial responses within a request reuse the storage of the previous partial response? This avoids allocating a new
+	 * response for every partial response
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Request")
+	bool bIsResponseRecyclingEnabled{false};
+
+	/** The maximum number of requests that can be in flight at once across all endpoints. Further requests are queued until a slot is free */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Request", meta=(ClampMin = 1))
+	int32 MaxConcurrentRequests{4};
+
+	/** Optional per endpoint limits on the number of requests that can be in flight at once. Endpoints not listed are only limited by MaxConcurrentRequests */
+	UPROPERTY(EditAnywhere, Category = "Request", meta=(ClampMin = 1))
+	TMap<EWitRequestEndpoint, int32> MaxConcurrentRequestsPerEndpoint{};
 	
 	/** The optional API version to use when making requests to Wit.ai */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Request Overrides")
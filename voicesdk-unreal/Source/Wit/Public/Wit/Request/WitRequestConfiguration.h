@@ -11,10 +11,12 @@
 #include "WitRequestConfiguration.generated.h"
 
 class FJsonObject;
+struct FWitResponse;
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitRequestErrorDelegate, const FString&, const FString&);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitRequestProgressDelegate, const TArray<uint8>&, const TSharedPtr<FJsonObject>);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitRequestCompleteDelegate, const TArray<uint8>&, const TSharedPtr<FJsonObject>);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWitRequestResponseDelegate, const FWitResponse&, const bool);
 
 /**
  * A compact configuration for setting up a Wit.ai request. Use the methods in FWitRequestBuilder to construct this
@@ -62,6 +64,24 @@ struct WIT_API FWitRequestConfiguration
 	/** Optional callback to use when the request is complete */
 	FOnWitRequestCompleteDelegate OnRequestComplete{};
 
+	/**
+	 * Optional callback to use when the request is in progress. The response is decoded straight from the JSON text without building an
+	 * FJsonObject. The flag is true when the response contains intents rather than only a partial transcription
+	 */
+	FOnWitRequestResponseDelegate OnResponseProgress{};
+
+	/**
+	 * Optional callback to use when the request is complete. The response is decoded straight from the JSON text without building an
+	 * FJsonObject. The flag is true when the response contains intents
+	 */
+	FOnWitRequestResponseDelegate OnResponseComplete{};
+
+	/**
+	 * Should responses passed to OnResponseProgress reuse the storage of the previous response? The response passed to the callback is
+	 * then only valid for the duration of the call
+	 */
+	bool bShouldRecycleResponses{false};
+
 	/** Tracks whether we should use the HTTP 1 chunked transfer protocol in the request */
 	bool bShouldUseChunkedTransfer{false};
 
@@ -70,4 +90,7 @@ struct WIT_API FWitRequestConfiguration
 
 	/** Custom timeout duration. This is only used if bShouldUseCustomHttpTimeout is true */
 	float HttpTimeout{180.0f};
+
+	/** The priority of the request when it has to wait for a free request slot. Higher priority requests are sent first */
+	int32 Priority{0};
 };
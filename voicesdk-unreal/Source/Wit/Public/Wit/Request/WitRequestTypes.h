@@ -95,3 +95,36 @@ enum class EWitRequestEndian : uint8
 	Little,
 	Big
 };
+
+/**
+ * Identifies a single request made through the request subsystem. A default constructed handle is invalid
+ */
+struct FWitRequestHandle
+{
+	/**
+	 * Default constructor
+	 */
+	FWitRequestHandle() = default;
+
+	/**
+	 * Construct with a specific id. Only the request subsystem should create valid handles
+	 */
+	explicit FWitRequestHandle(const uint32 InId)
+		: Id(InId)
+	{
+	}
+
+	/** Does this handle refer to a request? */
+	bool IsValid() const { return Id != 0; }
+
+	/** Clear the handle so it no longer refers to a request */
+	void Reset() { Id = 0; }
+
+	bool operator==(const FWitRequestHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FWitRequestHandle& Other) const { return Id != Other.Id; }
+
+	friend uint32 GetTypeHash(const FWitRequestHandle& Handle) { return ::GetTypeHash(Handle.Id); }
+
+	/** The unique id of the request */
+	uint32 Id{0};
+};
@@ -12,10 +12,53 @@
 #include "Sound/SoundWaveProcedural.h"
 #include "TTS/Configuration/TtsConfiguration.h"
 #include "TTS/Service/TtsService.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Wit/Request/WitRequestTypes.h"
 #include "Wit/Request/WitResponse.h"
 #include "WitTtsService.generated.h"
 
 class FJsonObject;
+struct FWitRequestConfiguration;
+
+/**
+ * A single clip of a split synthesis request when requests are pipelined. Clips can complete in any order so they are held here until
+ * every earlier clip has been delivered
+ */
+struct FWitTtsPipelinedClip
+{
+	/** The order in which the clip was requested */
+	int32 SequenceNumber{0};
+
+	/** The settings used to synthesize the clip */
+	FTtsConfiguration ClipSettings{};
+
+	/** The request used to synthesize the clip. Only valid while the request is in flight */
+	FWitRequestHandle RequestHandle{};
+
+	/** The synthesized audio data */
+	TArray<uint8> BinaryResponse{};
+
+	/** The clip found in the memory cache. Held here so it cannot be evicted before it is delivered */
+	TStrongObjectPtr<USoundWave> MemoryCachedClip{};
+
+	/** The error message if the request failed */
+	FString ErrorMessage{};
+
+	/** The human readable error message if the request failed */
+	FString HumanReadableErrorMessage{};
+
+	/** Has the clip finished, either successfully or not? */
+	bool bIsComplete{false};
+
+	/** Did the clip complete successfully? */
+	bool bIsSuccessful{false};
+
+	/** Was the clip found in the memory cache rather than synthesized? */
+	bool bIsMemoryCached{false};
+
+	/** Was the clip loaded from the storage cache rather than synthesized? */
+	bool bIsStorageCached{false};
+};
 
 /**
  * Component that encapsulates the Wit Text to Speech API. Provides functionality for speech synthesis from text input
@@ -84,12 +127,42 @@ private:
 	/** Previous data index used to process raw data */
 	int32 PreviousDataIndex{0};
 
+	/** The synthesize request this component currently has in progress with the request subsystem */
+	FWitRequestHandle SynthesizeRequestHandle{};
+
+	/** The voices request this component currently has in progress with the request subsystem */
+	FWitRequestHandle VoicesRequestHandle{};
+
+	/** The synthesize request this component currently has in progress with the socket subsystem */
+	FString SocketRequestId{};
+
 	/** Stop the request that is currently in progress */
 	bool bStopInProgressRequest;
 
 	/** Clip settings enqueued */
 	TArray<FTtsConfiguration> QueuedSettings;
 
+	/** Are we waiting for the storage cache to respond about the clip at the front of the queue? */
+	bool bIsStorageCacheRequestInProgress{false};
+
+	/** Clips that are in flight or waiting for an earlier clip to complete when requests are pipelined. Ordered by sequence number */
+	TArray<FWitTtsPipelinedClip> PipelinedClips;
+
+	/** The sequence number to give the next pipelined clip */
+	int32 NextPipelinedSequenceNumber{0};
+
+	/** Are pipelined clips currently being delivered? Used to stop delivery being re-entered from the callbacks it makes */
+	bool bIsDeliveringPipelinedClips{false};
+
+	/** The time the current synthesis was started */
+	double SynthesisStartTime{0.0};
+
+	/** The time the first clip of the current synthesis was delivered. Zero if nothing has been delivered yet */
+	double SynthesisFirstAudioTime{0.0};
+
+	/** The number of clips delivered for the current synthesis */
+	int32 SynthesisNumClips{0};
+
 #if WITH_EDITORONLY_DATA
 	
 	/** Write the captured voice input to a wav file */
@@ -105,6 +178,13 @@ private:
 	 */
 	void ConvertTextToSpeechWithSettingsInternal(const bool bNewRequest, const bool bQueueAudio);
 
+	/**
+	 * Sends the clip at the front of the queue to Wit for conversion to speech
+	 *
+	 * @param QueueAudio [in] should audio be placed in a queue
+	 */
+	void SendSynthesizeRequest(const bool bQueueAudio);
+
 	/**
 	 * Splits a speech segment into smaller segments
 	 *
@@ -112,6 +192,54 @@ private:
 	 * @param QueueAudio [in] should audio be placed in a queue
 	 */
 	void SplitSpeech(const FTtsConfiguration& ClipSettings, const bool bQueueAudio);
+
+	/** Setup the configuration shared by all synthesize requests */
+	void SetupSynthesizeRequestConfiguration(FWitRequestConfiguration& RequestConfiguration) const;
+
+	/** Create the body of a synthesize request */
+	TSharedRef<FJsonObject> CreateSynthesizeRequestBody(const FTtsConfiguration& ClipSettings) const;
+
+	/** Should split requests be pipelined rather than sent one at a time? */
+	bool ShouldPipelineRequests() const;
+
+	/** Send as many queued clips as there are free pipeline slots for and deliver any clips that are ready */
+	void ConvertTextToSpeechPipelined();
+
+	/** Get the number of pipelined clips that are still waiting on the storage cache or Wit.ai */
+	int32 GetNumPipelinedClipsInFlight() const;
+
+	/** Send a pipelined clip to Wit.ai for conversion */
+	void SendPipelinedSynthesizeRequest(const int32 SequenceNumber);
+
+	/** Called when the storage cache responds to a request for a pipelined clip */
+	void OnPipelinedStorageCacheRequestComplete(const bool bIsSuccessful, const TArray<uint8>& ClipData, const int32 SequenceNumber);
+
+	/** Deliver completed pipelined clips in the order they were requested */
+	void DeliverPipelinedClips();
+
+	/** Cancel all pipelined clips that have not been delivered yet */
+	void CancelPipelinedClips();
+
+	/** Find a pipelined clip by its sequence number */
+	FWitTtsPipelinedClip* FindPipelinedClip(const int32 SequenceNumber);
+
+	/** Called when a pipelined Wit synthesize request is fully completed */
+	void OnPipelinedSynthesizeRequestComplete(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse, const int32 SequenceNumber);
+
+	/** Called when a pipelined Wit synthesize request errors */
+	void OnPipelinedSynthesizeRequestError(const FString& ErrorMessage, const FString& HumanReadableErrorMessage, const int32 SequenceNumber);
+
+	/** Start timing a new synthesis */
+	void StartSynthesisTiming();
+
+	/** Record that the first audio of the current synthesis is available */
+	void MarkSynthesisFirstAudio();
+
+	/** Record that a clip of the current synthesis has been delivered */
+	void MarkSynthesisClipDelivered();
+
+	/** Log the timing of the current synthesis once every clip has been delivered */
+	void FinishSynthesisTiming(const TCHAR* Mode) const;
 	
 	/**
 	 * Called when the state of a WebSocket connection changes
@@ -121,6 +249,12 @@ private:
 	/** Called when a WebSocket stream is complete */
 	void OnSocketStreamComplete();
 
+	/** Called when a WebSocket stream fails */
+	void OnSocketStreamError(const FString& ErrorMessage, const FString& HumanReadableErrorMessage);
+
+	/** Called when the storage cache responds to a request for the clip at the front of the queue */
+	void OnStorageCacheRequestClipComplete(const bool bIsSuccessful, const TArray<uint8>& ClipData, const FString ClipId, const bool bQueueAudio);
+
 	/** Called when a storage cache request is fully completed to process the loaded data */
 	void OnStorageCacheRequestComplete(const TArray<uint8>& BinaryData, const FTtsConfiguration& ClipSettings) const;
 
@@ -145,6 +279,12 @@ private:
 	/** Called when a Wit synthesize request is in progress to process the incremental payload */
 	void OnSynthesizeRequestProgress(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse);
 
+	/** Called when a WebSocket synthesize stream is in progress to process the incremental payload */
+	void OnSynthesizeStreamProgress(TArrayView<const uint8> BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse);
+
+	/** Get the amount of streamed audio to gather before playback starts in bytes */
+	int32 GetMinimumStreamBufferLength() const;
+
 	/** Adds incremental raw data to the Procedural Sound Wave buffer queue */
 	void AddProceduralData(const uint8* RawData, const int32 RawDataSize, bool bShouldCheckSize);
 };
@@ -68,8 +68,8 @@ void FWitConfigurationUtilities::RequestAppList()
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 }
 
 /**
@@ -153,7 +153,7 @@ void FWitConfigurationUtilities::RequestClientToken(const FString& AppId)
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
 
 	// Construct the body parameters. The only parameter currently is 'refresh'
 
@@ -161,8 +161,8 @@ void FWitConfigurationUtilities::RequestClientToken(const FString& AppId)
 
 	RequestBody->SetBoolField(TEXT("refresh"), false);
 
-	RequestSubsystem->WriteJsonData(RequestBody.ToSharedRef());
-	RequestSubsystem->EndStreamRequest();
+	RequestSubsystem->WriteJsonData(RequestHandle, RequestBody.ToSharedRef());
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 }
 
 /**
@@ -209,8 +209,8 @@ void FWitConfigurationUtilities::RequestIntentList()
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 }
 
 /**
@@ -267,8 +267,8 @@ void FWitConfigurationUtilities::RequestEntityList()
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 }
 
 /**
@@ -325,8 +325,8 @@ void FWitConfigurationUtilities::RequestTraitList()
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 }
 
 /**
@@ -383,8 +383,8 @@ void FWitConfigurationUtilities::RequestVoiceList()
 
 	UWitRequestSubsystem* RequestSubsystem = GEngine->GetEngineSubsystem<UWitRequestSubsystem>();
 
-	RequestSubsystem->BeginStreamRequest(RequestConfiguration);
-	RequestSubsystem->EndStreamRequest();
+	const FWitRequestHandle RequestHandle = RequestSubsystem->BeginStreamRequest(RequestConfiguration);
+	RequestSubsystem->EndStreamRequest(RequestHandle);
 }
 
 /**
@@ -461,12 +461,6 @@ bool FWitConfigurationUtilities::SetupListRequest(FWitRequestConfiguration& Requ
 		return false;
 	}
 
-	if (RequestSubsystem->IsRequestInProgress())
-	{
-		UE_LOG(LogWit, Warning, TEXT("SetupListRequest: cannot fetch because a request is already in progress"));
-		return false;
-	}
-
 	FWitRequestBuilder::SetRequestConfigurationWithDefaults(RequestConfiguration, Endpoint, AuthToken, Configuration->Application.Advanced.ApiVersion,
 	                                                        Configuration->Application.Advanced.URL);
 	FWitRequestBuilder::AddFormatContentType(RequestConfiguration, EWitRequestFormat::Json);
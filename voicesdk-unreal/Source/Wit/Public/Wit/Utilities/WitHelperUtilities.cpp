@@ -14,13 +14,23 @@
 #include "Serialization/BufferArchive.h"
 #include "Sound/SoundWaveProcedural.h"
 #include "TTS/Cache/Storage/Asset/TtsStorageCacheAsset.h"
+#include "Wit/Utilities/WitExperienceRegistry.h"
 #include "Wit/Utilities/WitLog.h"
 #include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "Hash/CityHash.h"
+#else
+#include "Hash/xxhash.h"
+#endif
 #include "HAL/PlatformFileManager.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "UObject/SavePackage.h"
 
 FString FWitHelperUtilities::AdditionalFrontUserData = "";
 FString FWitHelperUtilities::AdditionalEndUserData = "";
+TMap<FTtsClipKey, FString> FWitHelperUtilities::CachedVoiceClipIds;
+FCriticalSection FWitHelperUtilities::CachedVoiceClipIdsLock;
 
  /**
   * Adds a string to the user agent data to include in Wit web requests
@@ -42,153 +52,118 @@ void FWitHelperUtilities::AddRequestUserData(const FString& UserData, const bool
 }
 
 /**
- * Finds the VoiceExperience in the scene. This is slow so do not call every frame
+ * Finds the VoiceExperience in the scene. Registered experiences are found without iterating the actors in the world
  * 
  * @return pointer to the Voice Experience actor if found otherwise null
  */
 AVoiceExperience* FWitHelperUtilities::FindVoiceExperience(const UWorld* World, const FName& Tag)
 {
-	check(World != nullptr);
-
-	AVoiceExperience* VoiceExperience = nullptr;
-	const bool bIsValidTag = !Tag.IsNone() && Tag.IsValid();
-
-	if (bIsValidTag)
-	{
-		UE_LOG(LogWit, Verbose, TEXT("FindVoiceExperience: Trying to find Voice Experience with tag %s"), *Tag.ToString());
-		
-		TArray<AActor*> VoiceExperiences;
-		
-		UGameplayStatics::GetAllActorsOfClassWithTag(World, AVoiceExperience::StaticClass(), Tag, VoiceExperiences);
-
-		// If more than 1 match then just use the first
-
-		const bool bIsVoiceExperienceWithMatchingTag = VoiceExperiences.Num() > 0;
-		 
-		if (bIsVoiceExperienceWithMatchingTag)
-		{
-			UE_LOG(LogWit, Verbose, TEXT("FindVoiceExperience: Found Voice Experience with tag %s"), *Tag.ToString());
-			
-			VoiceExperience = static_cast<AVoiceExperience*>(VoiceExperiences[0]);
-		}
-	}
-
-	// If we don't find a voice experience with a matching tag then we try to find the first voice experience
-	
-	if (VoiceExperience == nullptr)
-	{
-		VoiceExperience = static_cast<AVoiceExperience*>(UGameplayStatics::GetActorOfClass(World, AVoiceExperience::StaticClass()));
-	}
-
-	// If we still find nothing then not much we can do
-	
-	if (VoiceExperience == nullptr)
-	{
-		UE_LOG(LogWit, Warning, TEXT("FindVoiceExperience: No Voice Experience actor found"));
-		return nullptr;
-	}
-
-	return VoiceExperience;
+	return static_cast<AVoiceExperience*>(FindExperience(World, AVoiceExperience::StaticClass(), Tag, TEXT("Voice")));
 }
 
 /**
- * Finds the TtsExperience in the scene. This is slow so do not call every frame
+ * Finds the TtsExperience in the scene. Registered experiences are found without iterating the actors in the world
  * 
  * @return pointer to the TTS Experience actor if found otherwise null
  */
 ATtsExperience* FWitHelperUtilities::FindTtsExperience(const UWorld* World, const FName& Tag)
 {
-	check(World != nullptr);
-
-	ATtsExperience* TtsExperience = nullptr;
-	const bool bIsValidTag = !Tag.IsNone() && Tag.IsValid();
-
-	if (bIsValidTag)
-	{
-		UE_LOG(LogWit, Verbose, TEXT("FindTtsExperience: Trying to find TTS Experience with tag %s"), *Tag.ToString());
-		
-		TArray<AActor*> TtsExperiences;
-		
-		UGameplayStatics::GetAllActorsOfClassWithTag(World, ATtsExperience::StaticClass(), Tag, TtsExperiences);
-
-		// If more than 1 match then just use the first
-
-		const bool bIsVoiceExperienceWithMatchingTag = TtsExperiences.Num() > 0;
-		 
-		if (bIsVoiceExperienceWithMatchingTag)
-		{
-			UE_LOG(LogWit, Verbose, TEXT("FindTtsExperience: Found TTS Experience with tag %s"), *Tag.ToString());
-			
-			TtsExperience = static_cast<ATtsExperience*>(TtsExperiences[0]);
-		}
-	}
-
-	// If we don't find a TTS experience with a matching tag then we try to find the first TTS experience
-	
-	if (TtsExperience == nullptr)
-	{
-		TtsExperience = static_cast<ATtsExperience*>(UGameplayStatics::GetActorOfClass(World, ATtsExperience::StaticClass()));
-	}
-
-	// If we still find nothing then not much we can do
-	
-	if (TtsExperience == nullptr)
-	{
-		UE_LOG(LogWit, Warning, TEXT("FindTtsExperience: No TTS Experience actor found"));
-		return nullptr;
-	}
-
-	return TtsExperience;
+	return static_cast<ATtsExperience*>(FindExperience(World, ATtsExperience::StaticClass(), Tag, TEXT("TTS")));
 }
 
 /**
- * Finds the DictationExperience in the scene. This is slow so do not call every frame
+ * Finds the DictationExperience in the scene. Registered experiences are found without iterating the actors in the world
  * 
  * @return pointer to the Dictation Experience actor if found otherwise null
  */
 ADictationExperience* FWitHelperUtilities::FindDictationExperience(const UWorld* World, const FName& Tag)
+{
+	return static_cast<ADictationExperience*>(FindExperience(World, ADictationExperience::StaticClass(), Tag, TEXT("Dictation")));
+}
+
+/**
+ * Finds an experience of the given class in the scene. The experience registry is checked first. Experiences only register when they
+ * begin play so until the world has begun play a registry miss falls back to iterating the actors in the world and registers whatever
+ * it finds there. After that every experience has registered itself so a registry miss means there is no such experience
+ *
+ * @param World [in] the world to search
+ * @param ExperienceClass [in] the class of experience to find
+ * @param Tag [in] the tag to look for. If no experience has the tag then the first experience of the class is used
+ * @param ExperienceName [in] the name of the experience type used when logging
+ *
+ * @return pointer to the experience actor if found otherwise null
+ */
+AActor* FWitHelperUtilities::FindExperience(const UWorld* World, UClass* ExperienceClass, const FName& Tag, const TCHAR* ExperienceName)
 {
 	check(World != nullptr);
 
-	ADictationExperience* DictationExperience = nullptr;
+	UWitExperienceRegistry* Registry = World->GetSubsystem<UWitExperienceRegistry>();
+
+	AActor* Experience = nullptr;
 	const bool bIsValidTag = !Tag.IsNone() && Tag.IsValid();
 
+	// Experiences register themselves when they begin play and every actor in the world has begun play once the world has so only
+	// iterate the actors while some of them may not have registered yet
+
+	const bool bShouldSearchWorld = Registry == nullptr || !World->HasBegunPlay();
+
 	if (bIsValidTag)
 	{
-		UE_LOG(LogWit, Verbose, TEXT("FindDictationExperience: Trying to find Dictation Experience with tag %s"), *Tag.ToString());
-		
-		TArray<AActor*> DictationExperiences;
-		
-		UGameplayStatics::GetAllActorsOfClassWithTag(World, ADictationExperience::StaticClass(), Tag, DictationExperiences);
+		UE_LOG(LogWit, Verbose, TEXT("FindExperience: Trying to find %s Experience with tag %s"), ExperienceName, *Tag.ToString());
 
-		// If more than 1 match then just use the first
+		if (Registry != nullptr)
+		{
+			Experience = Registry->FindExperience(ExperienceClass, Tag);
+		}
 
-		const bool bIsVoiceExperienceWithMatchingTag = DictationExperiences.Num() > 0;
-		 
-		if (bIsVoiceExperienceWithMatchingTag)
+		if (Experience == nullptr && bShouldSearchWorld)
 		{
-			UE_LOG(LogWit, Verbose, TEXT("FindDictationExperience: Found Dictation Experience with tag %s"), *Tag.ToString());
-			
-			DictationExperience = static_cast<ADictationExperience*>(DictationExperiences[0]);
+			TArray<AActor*> Experiences;
+
+			UGameplayStatics::GetAllActorsOfClassWithTag(World, ExperienceClass, Tag, Experiences);
+
+			// If more than 1 match then just use the first
+
+			if (Experiences.Num() > 0)
+			{
+				Experience = Experiences[0];
+			}
+		}
+
+		if (Experience != nullptr)
+		{
+			UE_LOG(LogWit, Verbose, TEXT("FindExperience: Found %s Experience with tag %s"), ExperienceName, *Tag.ToString());
 		}
 	}
 
-	// If we don't find a dictation experience with a matching tag then we try to find the first TTS experience
-	
-	if (DictationExperience == nullptr)
+	// If we don't find an experience with a matching tag then we try to find the first experience
+
+	if (Experience == nullptr && Registry != nullptr)
+	{
+		Experience = Registry->FindExperience(ExperienceClass, NAME_None);
+	}
+
+	if (Experience == nullptr && bShouldSearchWorld)
 	{
-		DictationExperience = static_cast<ADictationExperience*>(UGameplayStatics::GetActorOfClass(World, ADictationExperience::StaticClass()));
+		Experience = UGameplayStatics::GetActorOfClass(World, ExperienceClass);
 	}
 
 	// If we still find nothing then not much we can do
-	
-	if (DictationExperience == nullptr)
+
+	if (Experience == nullptr)
 	{
-		UE_LOG(LogWit, Warning, TEXT("FindDictationExperience: No Dictation Experience actor found"));
+		UE_LOG(LogWit, Warning, TEXT("FindExperience: No %s Experience actor found"), ExperienceName);
 		return nullptr;
 	}
 
-	return DictationExperience;
+	// Register anything found the slow way so the next lookup is fast. This happens when an experience is looked up before it begins play
+
+	if (Registry != nullptr)
+	{
+		Registry->RegisterExperience(Experience);
+	}
+
+	return Experience;
 }
 
 /**
@@ -300,6 +275,24 @@ const FWitIntent* FWitHelperUtilities::FindMatchingIntent(const FWitResponse& Re
  */
 FString FWitHelperUtilities::GetVoiceClipId(const FTtsConfiguration& ClipSettings)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(FWitHelperUtilities::GetVoiceClipId);
+
+	// The id has to stay the same across runs and versions since it names clips in the storage cache and content folder so we keep the
+	// original calculation. It is expensive though and the same settings are often looked up several times so we remember recent ids
+	// by their cheap key
+
+	const FTtsClipKey ClipKey = GetVoiceClipKey(ClipSettings);
+
+	{
+		FScopeLock ScopeLock(&CachedVoiceClipIdsLock);
+
+		const FString* CachedClipId = CachedVoiceClipIds.Find(ClipKey);
+		if (CachedClipId != nullptr)
+		{
+			return *CachedClipId;
+		}
+	}
+
 	// Serialize the text and configuration to a byte buffer and then generate a hash from that to use as the ID
 		
 	FBufferArchive Buffer;
@@ -314,7 +307,93 @@ FString FWitHelperUtilities::GetVoiceClipId(const FTtsConfiguration& ClipSetting
 	FSHAHash OutputHash;
 	FSHA1::HashBuffer(Buffer.GetData(), Buffer.Num(), OutputHash.Hash);
 
-	return OutputHash.ToString();
+	const FString ClipId = OutputHash.ToString();
+
+	{
+		FScopeLock ScopeLock(&CachedVoiceClipIdsLock);
+
+		if (CachedVoiceClipIds.Num() >= MaximumCachedVoiceClipIds)
+		{
+			CachedVoiceClipIds.Reset();
+		}
+
+		CachedVoiceClipIds.Add(ClipKey, ClipId);
+	}
+
+	return ClipId;
+}
+
+/**
+ * Calculates a compact key for a text and voice configuration. Each field that affects the synthesized audio is appended to a buffer
+ * in a fixed order with strings prefixed by their length so different settings can never produce the same bytes. The storage location
+ * is deliberately left out
+ *
+ * @param ClipSettings [in] the settings used for the conversion
+ * @return the key
+ */
+FTtsClipKey FWitHelperUtilities::GetVoiceClipKey(const FTtsConfiguration& ClipSettings)
+{
+	TArray<uint8, TInlineAllocator<1024>> Buffer;
+
+	auto AppendBytes = [&Buffer](const void* Data, const int32 Size)
+	{
+		Buffer.Append(static_cast<const uint8*>(Data), Size);
+	};
+
+	auto AppendString = [&AppendBytes](const FString& Value)
+	{
+		const int32 Length = Value.Len();
+
+		AppendBytes(&Length, sizeof(Length));
+		AppendBytes(*Value, Length * sizeof(TCHAR));
+	};
+
+	const uint8 Version = VoiceClipKeyVersion;
+
+	AppendBytes(&Version, sizeof(Version));
+	AppendString(ClipSettings.Text);
+	AppendString(ClipSettings.Voice);
+	AppendString(ClipSettings.Style);
+	AppendBytes(&ClipSettings.Speed, sizeof(ClipSettings.Speed));
+	AppendBytes(&ClipSettings.Pitch, sizeof(ClipSettings.Pitch));
+	AppendBytes(&ClipSettings.Gain, sizeof(ClipSettings.Gain));
+
+	return GetBufferKey(Buffer.GetData(), Buffer.Num());
+}
+
+/**
+ * Calculates a compact key for a clip id so caches can index clips without storing or comparing strings
+ *
+ * @param ClipId [in] the clip id
+ * @return the key
+ */
+FTtsClipKey FWitHelperUtilities::GetClipIdKey(const FString& ClipId)
+{
+	return GetBufferKey(*ClipId, ClipId.Len() * sizeof(TCHAR));
+}
+
+/**
+ * Calculates a 128 bit key from a buffer using a fast non-cryptographic hash
+ *
+ * @param Data [in] the buffer
+ * @param Size [in] the size of the buffer in bytes
+ * @return the key
+ */
+FTtsClipKey FWitHelperUtilities::GetBufferKey(const void* Data, const int32 Size)
+{
+	FTtsClipKey Key;
+
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	Key.Low = CityHash64(static_cast<const char*>(Data), Size);
+	Key.High = CityHash64WithSeed(static_cast<const char*>(Data), Size, Key.Low);
+#else
+	const FXxHash128 Hash = FXxHash128::HashBuffer(Data, Size);
+
+	Key.Low = Hash.Low;
+	Key.High = Hash.High;
+#endif
+
+	return Key;
 }
 
 /**
@@ -9,6 +9,7 @@
 
 #include "CoreMinimal.h"
 #include "Dictation/Experience/DictationExperience.h"
+#include "HAL/CriticalSection.h"
 #include "TTS/Configuration/TtsConfiguration.h"
 #include "TTS/Experience/TtsExperience.h"
 #include "Voice/Experience/VoiceExperience.h"
@@ -36,21 +37,21 @@ public:
 	static void AddRequestUserData(const FString& UserData, const bool AddToFront = false);
 
 	/**
-	 * Finds the VoiceExperience in the scene. This is slow so do not call every frame
+	 * Finds the VoiceExperience in the scene. Registered experiences are found without iterating the actors in the world
 	 * 
 	 * @return pointer to the Voice Experience actor if found otherwise null
 	 */
 	static AVoiceExperience* FindVoiceExperience(const UWorld* World, const FName& Tag);
 
 	/**
-	 * Finds the TtsExperience in the scene. This is slow so do not call every frame
+	 * Finds the TtsExperience in the scene. Registered experiences are found without iterating the actors in the world
 	 * 
 	 * @return pointer to the TTS Experience actor if found otherwise null
 	 */
 	static ATtsExperience* FindTtsExperience(const UWorld* World, const FName& Tag);
 
 	/**
-	 * Finds the DictationExperience in the scene. This is slow so do not call every frame
+	 * Finds the DictationExperience in the scene. Registered experiences are found without iterating the actors in the world
 	 * 
 	 * @return pointer to the Dictation Experience actor if found otherwise null
 	 */
@@ -95,6 +96,23 @@ public:
 	 */
 	static FString GetVoiceClipId(const FTtsConfiguration& ClipSettings);
 
+	/**
+	 * Calculates a compact key for a text and voice configuration. This is much cheaper than GetVoiceClipId but the key is only
+	 * meaningful within a single run
+	 *
+	 * @param ClipSettings [in] the settings used for the conversion
+	 * @return the key
+	 */
+	static FTtsClipKey GetVoiceClipKey(const FTtsConfiguration& ClipSettings);
+
+	/**
+	 * Calculates a compact key for a clip id so caches can index clips without storing or comparing strings
+	 *
+	 * @param ClipId [in] the clip id
+	 * @return the key
+	 */
+	static FTtsClipKey GetClipIdKey(const FString& ClipId);
+
 	/**
 	 * Creates a sound wave from raw data
 	 * 
@@ -165,6 +183,24 @@ private:
 	/** Additional user data to add to the end of user agent data in Wit requests */
 	static FString AdditionalEndUserData;
 
+	/** Finds an experience of the given class in the scene, preferring the experience registry over iterating the actors in the world */
+	static AActor* FindExperience(const UWorld* World, UClass* ExperienceClass, const FName& Tag, const TCHAR* ExperienceName);
+
+	/** Calculates a 128 bit key from a buffer using a fast non-cryptographic hash */
+	static FTtsClipKey GetBufferKey(const void* Data, const int32 Size);
+
+	/** The version of the field layout hashed by GetVoiceClipKey. Increase this if the layout changes */
+	static constexpr uint8 VoiceClipKeyVersion{1};
+
+	/** The maximum number of clip ids remembered by GetVoiceClipId */
+	static constexpr int32 MaximumCachedVoiceClipIds{256};
+
+	/** Clip ids that have already been calculated keyed by their voice clip key */
+	static TMap<FTtsClipKey, FString> CachedVoiceClipIds;
+
+	/** Guards access to the cached clip ids */
+	static FCriticalSection CachedVoiceClipIdsLock;
+
 	/** Struct that is used as a parameter to CreateSoundWaveFromParams */
 	struct FSoundWaveParams
 	{
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Wit/Request/WitResponse.h"
+
+/**
+ * Settings that control when a partial response is considered stable enough to accept
+ */
+struct FWitPartialResponseStabilitySettings
+{
+	/** The number of consecutive partial responses that must agree */
+	int32 MinimumCount{3};
+
+	/** Or how long (in seconds) the partial responses must have agreed for */
+	float MinimumTime{0.3f};
+
+	/** The confidence the top intent must exceed */
+	float ConfidenceThreshold{0.8f};
+
+	/** The entities that must be present */
+	TArray<FString> RequiredEntityNames{};
+};
+
+/**
+ * Tracks consecutive partial responses to decide when the meaning of a request has settled. Partial responses agree when they have the
+ * same top intent and the same values for the required entities. Other entities are ignored. Once enough of them agree, or they have agreed for long enough, the latest partial response
+ * can be accepted as the final response without waiting for the rest of the request
+ */
+class WIT_API FWitPartialResponseStabilityTracker final
+{
+public:
+
+	/**
+	 * Set the settings to use. This also resets the tracker
+	 *
+	 * @param InSettings [in] the settings to use
+	 */
+	void Configure(const FWitPartialResponseStabilitySettings& InSettings);
+
+	/**
+	 * Reset the tracker ready for a new request
+	 */
+	void Reset();
+
+	/**
+	 * Track the next partial response
+	 *
+	 * @param Response [in] the partial response
+	 * @param CurrentTime [in] the current time in seconds
+	 *
+	 * @return true if the partial response is stable enough to accept
+	 */
+	bool Update(const FWitResponse& Response, const double CurrentTime);
+
+	/**
+	 * Get the number of consecutive partial responses that agree
+	 */
+	int32 GetNumStablePartialResponses() const
+	{
+		return NumStablePartialResponses;
+	}
+
+	/**
+	 * Get how long the partial responses have agreed for
+	 *
+	 * @param CurrentTime [in] the current time in seconds
+	 *
+	 * @return the time in seconds
+	 */
+	double GetStableTime(const double CurrentTime) const;
+
+private:
+
+	/** Could the response be accepted if it stays the same? */
+	bool IsCandidate(const FWitResponse& Response) const;
+
+	/** Does the response agree with the stable response? */
+	bool IsSameAsStable(const FWitResponse& Response) const;
+
+	/** Start tracking a new stable response */
+	void SetStable(const FWitResponse& Response, const double CurrentTime);
+
+	/** The settings in use */
+	FWitPartialResponseStabilitySettings Settings{};
+
+	/** The top intent of the stable response */
+	FString StableIntentName{};
+
+	/** The required entity names and their values in the stable response */
+	TArray<TPair<FString, FString>> StableEntityValues{};
+
+	/** The number of consecutive partial responses that agree */
+	int32 NumStablePartialResponses{0};
+
+	/** The time the first agreeing partial response was received */
+	double StableStartTime{0.0};
+};
@@ -11,6 +11,7 @@
 #include "Voice/Service/VoiceService.h"
 #include "Wit/Request/WitRequestTypes.h"
 #include "Wit/TTS/WitTtsService.h"
+#include "Wit/Voice/WitPartialResponseStabilityTracker.h"
 #include "WitVoiceService.generated.h"
 
 #ifdef CPP_PLUGIN
@@ -82,17 +83,29 @@ private:
 	/** Do the actual bulk of the deactivation */
 	bool DoDeactivateVoiceInput();
 
-	/** Called when a Wit speech request is in progress to retrieve any changes to the response payload */
-	void OnSpeechRequestProgress(const TArray<uint8>& PartialBinaryResponse, const TSharedPtr<FJsonObject> PartialJsonResponse) const;
+	/** Called when a Wit speech request is in progress with the decoded partial response */
+	void OnSpeechResponseProgress(const FWitResponse& PartialResponse, const bool bIsWitResponse);
+
+	/** Called when a WebSocket speech stream is in progress to retrieve any changes to the response payload */
+	void OnSpeechStreamProgress(TArrayView<const uint8> PartialBinaryResponse, const TSharedPtr<FJsonObject> PartialJsonResponse) const;
+
+	/** Called when a WebSocket speech stream is complete */
+	void OnSpeechStreamComplete() const;
+
+	/** Log how long the current voice request took from activation and from deactivation to its final response */
+	void ReportRequestLatency() const;
 
 	/** Called when received a Wit partial response */
-	void OnPartialResponse(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse) const;
+	void OnPartialResponse(TArrayView<const uint8> BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse) const;
 	
 	/** Called when a Wit message(Transcription) request is fully completed to process the response payload */
 	void OnMessageRequestComplete(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse);
 	
-	/** Called when a Wit speech request is fully completed to process the response payload */
-	void OnSpeechRequestComplete(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse);
+	/** Called when a Wit speech request is fully completed with the decoded final response */
+	void OnSpeechResponseComplete(const FWitResponse& Response, const bool bIsWitResponse);
+
+	/** Accept a partial response as final if it has stopped changing */
+	void AcceptPartialResponseIfStable(const FWitResponse& PartialResponse);
 	
 	/** Called when a Wit voice request is fully completed to process the response payload */
 	void OnRequestComplete(const TArray<uint8>& BinaryResponse, const TSharedPtr<FJsonObject> JsonResponse, const bool bIsResponseRestNeeded);
@@ -118,6 +131,12 @@ private:
 	/** Used to track when voice streaming is active on this component */
 	bool bIsVoiceStreamingActive{false};
 
+	/** The request this component currently has in progress with the request subsystem */
+	FWitRequestHandle RequestHandle{};
+
+	/** The converse request this component currently has in progress with the socket subsystem */
+	FString SocketRequestId{};
+
 	/** Used to track how long since we received voice data when capturing */
 	float LastVoiceTime{0.0f};
 
@@ -127,6 +146,20 @@ private:
 	/** Used to track how long since we reached wake volume when capturing */
 	float LastWakeTime{0.0f};
 
+	/** The time voice input was last activated. Zero if the current request did not come from voice input */
+	double ActivationTime{0.0};
+
+	/** The time voice input was last deactivated */
+	double DeactivationTime{0.0};
+
+	/** Decides when partial responses have stopped changing so one can be accepted early */
+	FWitPartialResponseStabilityTracker StabilityTracker{};
+
+	/** The total time from activation to final response of voice requests that ran to completion */
+	double TotalFinalResponseLatency{0.0};
+
+	/** The number of voice requests that ran to completion */
+	int32 NumFinalResponses{0};
 
 #ifdef CPP_PLUGIN
 #if PLATFORM_ANDROID